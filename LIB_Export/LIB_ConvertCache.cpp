@@ -0,0 +1,468 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_ConvertCache.h"
+#include "LIB_MeshBuffer.h"
+#include "LIB_MeshProcessing.h"
+#include "EngineDefines.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "MeshDescription.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    // 변환 결과가 달라지도록 파이프라인을 고치면 올려서 이전 키를 무효화한다
+    constexpr uint32 CacheKeyVersion = 2;
+
+    constexpr uint32 CacheFileMagic = 0x44434D50; // 'PMCD'
+    constexpr uint32 CacheFileVersion = 2;
+
+    constexpr int32 DefaultCapacity = 64;
+
+    constexpr int64 DefaultDiskBudgetBytes = 512ll * 1024 * 1024;
+    // 예산과 별개로 디스크 항목 수 상한 (TLruCache 용량)
+    constexpr int32 MaxDiskEntries = 65536;
+
+    void DeleteCacheFiles(const TArray<FString>& FilePaths)
+    {
+        for (const FString& FilePath : FilePaths)
+        {
+            // 다른 워커가 읽는 중이면 실패할 수 있으며, 그 파일은 다음 실행의 스캔에서 다시 정리된다
+            IFileManager::Get().Delete(*FilePath, false, false, true);
+        }
+    }
+
+    template<typename T>
+    uint64 HashArray(TConstArrayView<T> Array)
+    {
+        return FXxHash64::HashBuffer(Array.GetData(), Array.Num() * sizeof(T)).Hash;
+    }
+
+    template<typename T>
+    TConstArrayView<uint8> AsBytes(TConstArrayView<T> Array)
+    {
+        return MakeArrayView(reinterpret_cast<const uint8*>(Array.GetData()), Array.Num() * sizeof(T));
+    }
+
+    // FProcMeshTangent 는 패딩이 있으므로 멤버별로 해시한다
+    uint64 HashTangents(TConstArrayView<FProcMeshTangent> Tangents)
+    {
+        FXxHash64Builder Builder;
+        for (const FProcMeshTangent& Tangent : Tangents)
+        {
+            const uint8 bFlip = Tangent.bFlipTangentY ? 1 : 0;
+            Builder.Update(&Tangent.TangentX, sizeof(FVector));
+            Builder.Update(&bFlip, sizeof(bFlip));
+        }
+        return Builder.Finalize().Hash;
+    }
+
+    // 결과 메시에 영향을 주는 옵션만 키에 넣는다 (캐시 사용 여부 같은 옵션은 제외)
+    void HashOptions(FXxHash64Builder& Builder, const FProcMeshConvertOptions& Options)
+    {
+        const uint8 bRepairMesh = Options.bRepairMesh ? 1 : 0;
+        const float WeldThreshold = Options.bRepairMesh ? Options.RepairWeldThreshold : 0.0f;
+        Builder.Update(&bRepairMesh, sizeof(bRepairMesh));
+        Builder.Update(&WeldThreshold, sizeof(WeldThreshold));
+
+        const uint8 bRecalculateNormal = Options.bRecalculateNormal ? 1 : 0;
+        Builder.Update(&bRecalculateNormal, sizeof(bRecalculateNormal));
+        if (Options.bRecalculateNormal)
+        {
+            const uint8 Weighting = static_cast<uint8>(Options.NormalWeighting);
+            const uint8 bUseCreaseAngle = Options.bUseCreaseAngle ? 1 : 0;
+            const float CreaseAngle = Options.bUseCreaseAngle ? Options.CreaseAngle : 0.0f;
+            Builder.Update(&Weighting, sizeof(Weighting));
+            Builder.Update(&bUseCreaseAngle, sizeof(bUseCreaseAngle));
+            Builder.Update(&CreaseAngle, sizeof(CreaseAngle));
+        }
+
+        // UV 투영 설정은 입력에 UV0 가 없을 때만 쓰이지만, 키 계산을 단순하게 하기 위해 항상 넣는다
+        const uint8 UVProjection = static_cast<uint8>(Options.UVProjection);
+        Builder.Update(&UVProjection, sizeof(UVProjection));
+        Builder.Update(&Options.UVProjectionAxis, sizeof(FVector));
+        Builder.Update(&Options.UVProjectionCenter, sizeof(FVector));
+        Builder.Update(&Options.UVScale, sizeof(FVector2D));
+        Builder.Update(&Options.UVOffset, sizeof(FVector2D));
+
+        const uint8 bGenerateTangents = Options.bGenerateTangents ? 1 : 0;
+        Builder.Update(&bGenerateTangents, sizeof(bGenerateTangents));
+
+        // LOD 는 옵션 배열이 아니라 실제로 쓰일 비율/화면 크기로 넣는다
+        TArray<float> TriangleRatios;
+        TArray<float> ScreenSizes;
+        LIB_MeshProcessing::GetLODSettings(Options, TriangleRatios, ScreenSizes);
+        const int32 NumLODs = TriangleRatios.Num();
+        Builder.Update(&NumLODs, sizeof(NumLODs));
+        Builder.Update(TriangleRatios.GetData(), TriangleRatios.Num() * sizeof(float));
+        Builder.Update(ScreenSizes.GetData(), ScreenSizes.Num() * sizeof(float));
+
+        const uint8 bOptimizeVertexCache = Options.bOptimizeVertexCache ? 1 : 0;
+        Builder.Update(&bOptimizeVertexCache, sizeof(bOptimizeVertexCache));
+
+        const int32 MaxSectionVertices = Options.bSplitSections ? FMath::Max(Options.MaxSectionVertices, 3) : 0;
+        Builder.Update(&MaxSectionVertices, sizeof(MaxSectionVertices));
+
+        // 충돌은 결과 메시에 붙으므로 키에 넣는다 (쓰이지 않는 설정은 0)
+        const bool bConvexCollision = Options.CollisionMode == EProcCollisionMode::ConvexHull || Options.CollisionMode == EProcCollisionMode::ConvexDecomposition;
+        const uint8 CollisionMode = static_cast<uint8>(Options.CollisionMode);
+        const int32 MaxConvexHulls = Options.CollisionMode == EProcCollisionMode::ConvexDecomposition ? FMath::Max(Options.MaxConvexHulls, 1) : 0;
+        const int32 MaxHullVertices = bConvexCollision ? FMath::Max(Options.MaxHullVertices, 4) : 0;
+        const float MaxConcavity = Options.CollisionMode == EProcCollisionMode::ConvexDecomposition ? FMath::Max(Options.MaxConcavity, 0.0f) : 0.0f;
+        Builder.Update(&CollisionMode, sizeof(CollisionMode));
+        Builder.Update(&MaxConvexHulls, sizeof(MaxConvexHulls));
+        Builder.Update(&MaxHullVertices, sizeof(MaxHullVertices));
+        Builder.Update(&MaxConcavity, sizeof(MaxConcavity));
+    }
+}
+
+
+FProcMeshConvertCache& FProcMeshConvertCache::Get()
+{
+    static FProcMeshConvertCache Instance;
+    return Instance;
+}
+
+FProcMeshConvertCache::FProcMeshConvertCache()
+    : Meshes(DefaultCapacity)
+    , CacheDir(FPaths::ProjectSavedDir() / TEXT("ProcMeshCache"))
+    , DiskEntries(MaxDiskEntries)
+    , DiskBudgetBytes(DefaultDiskBudgetBytes)
+{
+}
+
+uint64 FProcMeshConvertCache::ComputeKey(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options)
+{
+    // 1. 버퍼별 해시를 병렬로 계산
+    constexpr int32 NumBuffers = 6;
+    uint64 BufferHashes[NumBuffers];
+    ParallelFor(NumBuffers, [&MeshData, &BufferHashes](int32 BufferIndex)
+        {
+            switch (BufferIndex)
+            {
+            case 0: BufferHashes[0] = HashArray(MeshData.Vertices); break;
+            case 1: BufferHashes[1] = HashArray(MeshData.Triangles); break;
+            case 2: BufferHashes[2] = HashArray(MeshData.Normals); break;
+            case 3: BufferHashes[3] = HashArray(MeshData.UV0); break;
+            case 4: BufferHashes[4] = HashArray(MeshData.VertexColors); break;
+            default: BufferHashes[5] = HashTangents(MeshData.Tangents); break;
+            }
+        });
+
+    // 2. 원소 수와 버퍼 해시, 옵션을 합쳐 키 생성
+    const int32 Counts[NumBuffers] = {
+        MeshData.Vertices.Num(), MeshData.Triangles.Num(), MeshData.Normals.Num(),
+        MeshData.UV0.Num(), MeshData.VertexColors.Num(), MeshData.Tangents.Num() };
+
+    FXxHash64Builder Builder;
+    Builder.Update(&CacheKeyVersion, sizeof(CacheKeyVersion));
+    Builder.Update(Counts, sizeof(Counts));
+    Builder.Update(BufferHashes, sizeof(BufferHashes));
+    HashOptions(Builder, Options);
+    return Builder.Finalize().Hash;
+}
+
+uint64 FProcMeshConvertCache::ComputeKey(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options)
+{
+    // 1. 성분 배열별 해시를 병렬로 계산 (모두 패딩 없는 연속 배열)
+    const TConstArrayView<uint8> Components[] = {
+        AsBytes(MeshBuffer.PositionX), AsBytes(MeshBuffer.PositionY), AsBytes(MeshBuffer.PositionZ),
+        AsBytes(MeshBuffer.Triangles),
+        AsBytes(MeshBuffer.NormalX), AsBytes(MeshBuffer.NormalY), AsBytes(MeshBuffer.NormalZ),
+        AsBytes(MeshBuffer.U), AsBytes(MeshBuffer.V),
+        AsBytes(MeshBuffer.Colors),
+        AsBytes(MeshBuffer.TangentX), AsBytes(MeshBuffer.TangentY), AsBytes(MeshBuffer.TangentZ), AsBytes(MeshBuffer.BinormalSign) };
+    constexpr int32 NumComponents = UE_ARRAY_COUNT(Components);
+
+    uint64 ComponentHashes[NumComponents];
+    int32 ComponentSizes[NumComponents];
+    ParallelFor(NumComponents, [&Components, &ComponentHashes, &ComponentSizes](int32 Index)
+        {
+            ComponentHashes[Index] = FXxHash64::HashBuffer(Components[Index].GetData(), Components[Index].Num()).Hash;
+            ComponentSizes[Index] = Components[Index].Num();
+        });
+
+    // 2. FProcMeshData 키와 겹치지 않도록 형식 태그를 넣어 합친다
+    const uint8 SourceTag = 'F';
+    FXxHash64Builder Builder;
+    Builder.Update(&CacheKeyVersion, sizeof(CacheKeyVersion));
+    Builder.Update(&SourceTag, sizeof(SourceTag));
+    Builder.Update(ComponentSizes, sizeof(ComponentSizes));
+    Builder.Update(ComponentHashes, sizeof(ComponentHashes));
+    HashOptions(Builder, Options);
+    return Builder.Finalize().Hash;
+}
+
+bool FProcMeshConvertCache::ContainsMesh(uint64 Key)
+{
+    FScopeLock ScopeLock(&Lock);
+    return Meshes.Contains(Key);
+}
+
+UStaticMesh* FProcMeshConvertCache::FindMesh(uint64 Key)
+{
+    check(IsInGameThread());
+
+    FScopeLock ScopeLock(&Lock);
+    const TWeakObjectPtr<UStaticMesh>* Found = Meshes.FindAndTouch(Key);
+    if (!Found)
+    {
+        return nullptr;
+    }
+
+    UStaticMesh* StaticMesh = Found->Get();
+    if (!StaticMesh)
+    {
+        // GC 된 항목은 바로 정리
+        Meshes.Remove(Key);
+    }
+    return StaticMesh;
+}
+
+void FProcMeshConvertCache::AddMesh(uint64 Key, UStaticMesh* StaticMesh)
+{
+    check(IsInGameThread());
+
+    if (StaticMesh)
+    {
+        FScopeLock ScopeLock(&Lock);
+        Meshes.Add(Key, StaticMesh);
+    }
+}
+
+bool FProcMeshConvertCache::LoadMeshDescriptions(uint64 Key, TArray<FMeshDescription>& OutMeshDescs)
+{
+    const FString FilePath = GetCacheFilePath(Key);
+    TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent));
+    if (!FileReader)
+    {
+        return false;
+    }
+
+    // 1. 헤더 확인 (형식이나 엔진 버전이 다르면 미스)
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint32 Changelist = 0;
+    *FileReader << Magic << Version << Changelist;
+    if (FileReader->IsError() || Magic != CacheFileMagic || Version != CacheFileVersion || Changelist != FEngineVersion::Current().GetChangelist())
+    {
+        return false;
+    }
+
+    // 2. 저장할 때의 커스텀 버전으로 MeshDescription 역직렬화
+    FCustomVersionContainer CustomVersions;
+    CustomVersions.Serialize(*FileReader);
+    TArray<uint8> Payload;
+    *FileReader << Payload;
+    if (FileReader->IsError() || !FileReader->Close())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Corrupted mesh cache file: %s"), *FilePath);
+        return false;
+    }
+
+    FMemoryReader PayloadReader(Payload, true);
+    PayloadReader.SetCustomVersions(CustomVersions);
+    int32 NumLODs = 0;
+    PayloadReader << NumLODs;
+    if (!PayloadReader.IsError() && NumLODs > 0 && NumLODs <= MAX_STATIC_MESH_LODS)
+    {
+        OutMeshDescs.SetNum(NumLODs);
+        for (FMeshDescription& MeshDesc : OutMeshDescs)
+        {
+            PayloadReader << MeshDesc;
+        }
+    }
+    if (PayloadReader.IsError() || OutMeshDescs.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Corrupted mesh cache file: %s"), *FilePath);
+        OutMeshDescs.Empty();
+        return false;
+    }
+
+    // 3. 최근 사용으로 표시 (다음 실행의 스캔 순서를 위해 수정 시각도 갱신)
+    TArray<FString> EvictedPaths;
+    {
+        FScopeLock ScopeLock(&DiskLock);
+        ScanDiskEntries(EvictedPaths);
+        DiskEntries.FindAndTouch(Key);
+    }
+    DeleteCacheFiles(EvictedPaths);
+    IFileManager::Get().SetTimeStamp(*FilePath, FDateTime::UtcNow());
+    return true;
+}
+
+void FProcMeshConvertCache::SaveMeshDescriptions(uint64 Key, TArray<FMeshDescription>& MeshDescs)
+{
+    int64 BudgetBytes = 0;
+    {
+        FScopeLock ScopeLock(&DiskLock);
+        BudgetBytes = DiskBudgetBytes;
+    }
+    if (BudgetBytes <= 0)
+    {
+        return;
+    }
+
+    // 1. 메모리에 직렬화하며 사용된 커스텀 버전을 수집
+    TArray<uint8> Payload;
+    FMemoryWriter PayloadWriter(Payload, true);
+    int32 NumLODs = MeshDescs.Num();
+    PayloadWriter << NumLODs;
+    for (FMeshDescription& MeshDesc : MeshDescs)
+    {
+        PayloadWriter << MeshDesc;
+    }
+    FCustomVersionContainer CustomVersions = PayloadWriter.GetCustomVersions();
+    if (Payload.Num() > BudgetBytes)
+    {
+        // 예산보다 큰 결과는 저장하지 않는다 (다른 파일을 모두 밀어내지 않도록)
+        return;
+    }
+
+    // 2. 임시 파일에 쓴 뒤 교체하여 다른 워커가 반쯤 쓰인 파일을 읽지 않게 한다
+    const FString FilePath = GetCacheFilePath(Key);
+    const FString TempPath = FilePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+    TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempPath));
+    if (!FileWriter)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to open mesh cache file: %s"), *TempPath);
+        return;
+    }
+
+    uint32 Magic = CacheFileMagic;
+    uint32 Version = CacheFileVersion;
+    uint32 Changelist = FEngineVersion::Current().GetChangelist();
+    *FileWriter << Magic << Version << Changelist;
+    CustomVersions.Serialize(*FileWriter);
+    *FileWriter << Payload;
+
+    const int64 FileSize = FileWriter->Tell();
+    const bool bWritten = FileWriter->Close() && !FileWriter->IsError();
+    FileWriter.Reset();
+    if (!bWritten || !IFileManager::Get().Move(*FilePath, *TempPath, true))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write mesh cache file: %s"), *FilePath);
+        IFileManager::Get().Delete(*TempPath);
+        return;
+    }
+
+    // 3. 크기를 반영하고 예산을 넘는 만큼 오래된 파일부터 지운다 (같은 키를 다시 쓴 경우 이전 크기는 뺀다)
+    TArray<FString> EvictedPaths;
+    {
+        FScopeLock ScopeLock(&DiskLock);
+        ScanDiskEntries(EvictedPaths);
+        if (const int64* PreviousSize = DiskEntries.Find(Key))
+        {
+            DiskBytes -= *PreviousSize;
+            DiskEntries.Remove(Key);
+        }
+        EvictDiskEntries(FMath::Max<int64>(DiskBudgetBytes - FileSize, 0), DiskEntries.Max() - 1, EvictedPaths);
+        DiskEntries.Add(Key, FileSize);
+        DiskBytes += FileSize;
+    }
+    DeleteCacheFiles(EvictedPaths);
+}
+
+void FProcMeshConvertCache::SetCapacity(int32 MaxEntries)
+{
+    FScopeLock ScopeLock(&Lock);
+    Meshes.Empty(FMath::Max(MaxEntries, 1));
+}
+
+void FProcMeshConvertCache::SetDiskBudget(int64 InMaxBytes)
+{
+    TArray<FString> EvictedPaths;
+    {
+        FScopeLock ScopeLock(&DiskLock);
+        DiskBudgetBytes = FMath::Max<int64>(InMaxBytes, 0);
+        ScanDiskEntries(EvictedPaths);
+        EvictDiskEntries(DiskBudgetBytes, DiskEntries.Max(), EvictedPaths);
+    }
+    DeleteCacheFiles(EvictedPaths);
+}
+
+void FProcMeshConvertCache::Clear(bool bIncludeDiskCache)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        Meshes.Empty(Meshes.Max());
+    }
+
+    if (bIncludeDiskCache)
+    {
+        FScopeLock ScopeLock(&DiskLock);
+        IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+        DiskEntries.Empty(MaxDiskEntries);
+        DiskBytes = 0;
+        bDiskScanned = true;
+    }
+}
+
+void FProcMeshConvertCache::ScanDiskEntries(TArray<FString>& OutEvictedPaths)
+{
+    if (bDiskScanned)
+    {
+        return;
+    }
+    bDiskScanned = true;
+
+    // 1. 캐시 파일 목록 (임시 파일 제외)
+    struct FDiskFile
+    {
+        uint64 Key = 0;
+        int64 Size = 0;
+        FDateTime ModificationTime;
+    };
+    TArray<FDiskFile> Files;
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*CacheDir, [&Files](const TCHAR* Path, const FFileStatData& StatData)
+        {
+            const FString FilePath(Path);
+            if (!StatData.bIsDirectory && FPaths::GetExtension(FilePath) == TEXT("pmcache"))
+            {
+                FDiskFile& File = Files.AddDefaulted_GetRef();
+                File.Key = FCString::Strtoui64(*FPaths::GetBaseFilename(FilePath), nullptr, 16);
+                File.Size = StatData.FileSize;
+                File.ModificationTime = StatData.ModificationTime;
+            }
+            return true;
+        });
+
+    // 2. 오래된 것부터 넣어 최근에 쓴 파일이 LRU 의 앞쪽이 되게 한다
+    Files.Sort([](const FDiskFile& A, const FDiskFile& B)
+        {
+            return A.ModificationTime < B.ModificationTime;
+        });
+    for (const FDiskFile& File : Files)
+    {
+        EvictDiskEntries(MAX_int64, DiskEntries.Max() - 1, OutEvictedPaths);
+        DiskEntries.Add(File.Key, File.Size);
+        DiskBytes += File.Size;
+    }
+
+    // 3. 이전 실행에서 예산이 달랐을 수 있으므로 바로 맞춘다
+    EvictDiskEntries(DiskBudgetBytes, DiskEntries.Max(), OutEvictedPaths);
+}
+
+void FProcMeshConvertCache::EvictDiskEntries(int64 MaxBytes, int32 MaxEntries, TArray<FString>& OutEvictedPaths)
+{
+    while ((DiskBytes > MaxBytes || DiskEntries.Num() > MaxEntries) && DiskEntries.Num() > 0)
+    {
+        const uint64 Key = DiskEntries.GetLeastRecentKey();
+        DiskBytes -= DiskEntries.RemoveLeastRecent();
+        OutEvictedPaths.Add(GetCacheFilePath(Key));
+    }
+}
+
+FString FProcMeshConvertCache::GetCacheFilePath(uint64 Key) const
+{
+    return CacheDir / FString::Printf(TEXT("%016llx.pmcache"), Key);
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/WeakObjectPtr.h"
+#include "LIB_Export.h"
+
+struct FMeshDescription;
+struct FProcMeshBufferView;
+
+/**
+ * 변환 결과 캐시. 입력 버퍼와 결과에 영향을 주는 옵션의 해시를 키로 사용합니다.
+ * 메모리 계층은 결과 메시를 약한 참조로 들고 있는 LRU 이므로, 메시가 GC 되면 자연스럽게 미스가 됩니다.
+ * 디스크 계층은 MeshDescription 을 Saved/ProcMeshCache 에 저장하여 다음 실행에서도 전처리를 건너뛰게 합니다.
+ * 디스크 계층도 파일 크기 합의 예산을 넘으면 가장 오래 쓰지 않은 파일부터 지웁니다. (실행 사이의 순서는 파일 수정 시각으로 이어진다)
+ */
+class FProcMeshConvertCache
+{
+public:
+	static FProcMeshConvertCache& Get();
+
+	// 아무 스레드에서나 호출할 수 있습니다.
+	static uint64 ComputeKey(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options);
+	static uint64 ComputeKey(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options);
+
+	// 메모리 계층에 키가 있는지만 확인합니다. 메시가 아직 살아 있는지는 게임 스레드에서 FindMesh 로 확인해야 합니다.
+	bool ContainsMesh(uint64 Key);
+
+	// 게임 스레드 전용
+	UStaticMesh* FindMesh(uint64 Key);
+	void AddMesh(uint64 Key, UStaticMesh* StaticMesh);
+
+	// 디스크 계층. LOD 순서의 MeshDescription 을 한 파일에 저장합니다. 아무 스레드에서나 호출할 수 있습니다.
+	bool LoadMeshDescriptions(uint64 Key, TArray<FMeshDescription>& OutMeshDescs);
+	void SaveMeshDescriptions(uint64 Key, TArray<FMeshDescription>& MeshDescs);
+
+	void SetCapacity(int32 MaxEntries);
+	// 디스크 계층 파일 크기 합의 상한. 0 이면 디스크에 저장하지 않습니다.
+	void SetDiskBudget(int64 InMaxBytes);
+	void Clear(bool bIncludeDiskCache);
+
+private:
+	FProcMeshConvertCache();
+
+	FString GetCacheFilePath(uint64 Key) const;
+
+	// 아래는 DiskLock 을 잡은 상태에서 호출
+	// 처음 한 번 기존 캐시 파일을 수정 시각 순으로 읽어 와 LRU 순서를 잇고, 예산을 넘는 파일 경로를 돌려준다
+	void ScanDiskEntries(TArray<FString>& OutEvictedPaths);
+	// 크기 합이 MaxBytes, 항목 수가 MaxEntries 이하가 될 때까지 가장 오래 쓰지 않은 항목을 빼고, 지울 파일 경로를 돌려준다 (삭제는 잠금 밖에서)
+	void EvictDiskEntries(int64 MaxBytes, int32 MaxEntries, TArray<FString>& OutEvictedPaths);
+
+	FCriticalSection Lock;
+	TLruCache<uint64, TWeakObjectPtr<UStaticMesh>> Meshes;
+	FString CacheDir;
+
+	FCriticalSection DiskLock;
+	TLruCache<uint64, int64> DiskEntries;	// 키 -> 파일 크기
+	int64 DiskBudgetBytes;
+	int64 DiskBytes = 0;
+	bool bDiskScanned = false;
+};
@@ -0,0 +1,942 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_ConvertScheduler.h"
+#include "Async/Async.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "LIB_MeshProcessing.h"
+#include "LIB_MeshBuffer.h"
+#include "LIB_ConvertCache.h"
+#include "MeshDescription.h"
+
+namespace
+{
+    // 완료 시 단계별 소요 시간을 로그로 남기는 기준
+    constexpr float SlowConvertLogMs = 100.0f;
+
+    /**
+     * 단계별 삼각형당 소요 시간 (초). 진행률 가중치와 마무리 대기열의 빌드 비용 추정에 쓴다.
+     * 처음에는 대략적인 값으로 시작하고 단계가 끝날 때마다 지수 이동 평균으로 갱신한다.
+     * 여러 워커가 동시에 갱신하면 한쪽 측정이 빠질 수 있지만 추정치이므로 잠그지 않는다.
+     */
+    std::atomic<double> StageSecondsPerTriangle[] =
+    {
+        { 2.0e-8 },     // CacheLookup
+        { 2.0e-7 },     // Prepare
+        { 5.0e-7 },     // BuildDescriptions
+        { 5.0e-8 },     // Collision
+        { 1.0e-6 },     // BuildMesh
+    };
+    static_assert(UE_ARRAY_COUNT(StageSecondsPerTriangle) == static_cast<int32>(EProcConvertStage::Num), "Stage cost table must match EProcConvertStage");
+
+    double GetStageSecondsPerTriangle(const EProcConvertStage Stage)
+    {
+        return StageSecondsPerTriangle[static_cast<int32>(Stage)].load(std::memory_order_relaxed);
+    }
+
+    void UpdateStageSecondsPerTriangle(const EProcConvertStage Stage, const double Seconds, const int32 NumTriangles)
+    {
+        if (NumTriangles > 0)
+        {
+            std::atomic<double>& Cost = StageSecondsPerTriangle[static_cast<int32>(Stage)];
+            Cost.store(FMath::Lerp(Cost.load(std::memory_order_relaxed), Seconds / NumTriangles, 0.25), std::memory_order_relaxed);
+        }
+    }
+
+    float& GetStageTiming(FProcMeshConvertTimings& Timings, const EProcConvertStage Stage)
+    {
+        switch (Stage)
+        {
+        case EProcConvertStage::CacheLookup:        return Timings.CacheLookupMs;
+        case EProcConvertStage::Prepare:            return Timings.PrepareMs;
+        case EProcConvertStage::BuildDescriptions:  return Timings.BuildDescriptionsMs;
+        case EProcConvertStage::Collision:          return Timings.CollisionMs;
+        default:                                    return Timings.BuildMeshMs;
+        }
+    }
+
+    float ToMs(const double Seconds)
+    {
+        return static_cast<float>(Seconds * 1000.0);
+    }
+
+    // 게임 스레드면 바로, 아니면 다음 게임 스레드 작업으로 실행 (싱글턴은 워커에서 처음 만들어질 수 있다)
+    void RunOnGameThread(TFunction<void()>&& Function)
+    {
+        if (IsInGameThread())
+        {
+            Function();
+            return;
+        }
+        AsyncTask(ENamedThreads::GameThread, MoveTemp(Function));
+    }
+
+    // 우선순위가 높은 작업 먼저, 같으면 먼저 들어온 작업 먼저
+    bool IsHigherPriority(const FProcMeshConvertJob& A, const FProcMeshConvertJob& B)
+    {
+        const int32 PriorityA = A.GetPriority();
+        const int32 PriorityB = B.GetPriority();
+        return PriorityA != PriorityB ? PriorityA > PriorityB : A.SubmitOrder < B.SubmitOrder;
+    }
+
+    // 빌드 비용 추정용. 모든 LOD 의 삼각형 수 합
+    int32 CountTriangles(const TArray<FMeshDescription>& MeshDescs)
+    {
+        int32 NumTriangles = 0;
+        for (const FMeshDescription& MeshDesc : MeshDescs)
+        {
+            NumTriangles += MeshDesc.Triangles().Num();
+        }
+        return NumTriangles;
+    }
+}
+
+
+// -- FProcMeshConvertJob implementation --
+FProcMeshConvertJob::FProcMeshConvertJob(FProcMeshData&& InMeshData, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority)
+    : MeshData(MoveTemp(InMeshData))
+    , Options(InOptions)
+    , SlotKey(InSlotKey)
+    , State(EProcConvertState::Pending)
+    , Priority(InPriority)
+{
+}
+
+FProcMeshConvertJob::FProcMeshConvertJob(const TSharedRef<const FProcMeshData, ESPMode::ThreadSafe>& InSharedMeshData, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority)
+    : SharedMeshData(InSharedMeshData)
+    , Options(InOptions)
+    , SlotKey(InSlotKey)
+    , State(EProcConvertState::Pending)
+    , Priority(InPriority)
+{
+}
+
+FProcMeshConvertJob::FProcMeshConvertJob(const TSharedRef<const FProcMeshBuffer, ESPMode::ThreadSafe>& InSharedBuffer, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority)
+    : SharedBuffer(InSharedBuffer)
+    , Options(InOptions)
+    , SlotKey(InSlotKey)
+    , State(EProcConvertState::Pending)
+    , Priority(InPriority)
+{
+}
+
+FProcMeshConvertJob::FProcMeshConvertJob(const FString& InSourceFilePath, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority)
+    : SourceFilePath(InSourceFilePath)
+    , Options(InOptions)
+    , SlotKey(InSlotKey)
+    , State(EProcConvertState::Pending)
+    , Priority(InPriority)
+{
+}
+
+void FProcMeshConvertJob::ReleaseInput()
+{
+    MeshData = FProcMeshData();
+    SharedMeshData.Reset();
+    SharedBuffer.Reset();
+    SourceFile.Reset();
+    BufferScratch = FProcMeshBuffer();
+}
+
+bool FProcMeshConvertJob::IsFinished() const
+{
+    const EProcConvertState Current = GetState();
+    return Current == EProcConvertState::Completed || Current == EProcConvertState::Failed || Current == EProcConvertState::Cancelled;
+}
+
+bool FProcMeshConvertJob::TransitionState(EProcConvertState Expected, EProcConvertState NewState)
+{
+    return State.compare_exchange_strong(Expected, NewState);
+}
+
+void FProcMeshConvertJob::Cancel()
+{
+    EProcConvertState Current = GetState();
+    while (Current == EProcConvertState::Pending || Current == EProcConvertState::Processing || Current == EProcConvertState::Finalizing)
+    {
+        if (State.compare_exchange_weak(Current, EProcConvertState::Cancelled))
+        {
+            // 호출자의 잠금 안에서 사용자 콜백이 불리지 않도록 항상 다음 게임 스레드 작업으로 미룬다
+            TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe> Self = AsShared();
+            AsyncTask(ENamedThreads::GameThread, [Self]()
+                {
+                    Self->Complete(ErrorCode_Cancelled, nullptr);
+                });
+            return;
+        }
+    }
+}
+
+void FProcMeshConvertJob::SetStageWork(EProcConvertStage Stage, int32 NumTriangles)
+{
+    StageWork[static_cast<int32>(Stage)] = FMath::Max(NumTriangles, 0);
+}
+
+void FProcMeshConvertJob::FinishStage(EProcConvertStage Stage, double StartTime)
+{
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    GetStageTiming(Timings, Stage) += ToMs(Seconds);
+    UpdateStageSecondsPerTriangle(Stage, Seconds, StageWork[static_cast<int32>(Stage)]);
+    bStageFinished[static_cast<int32>(Stage)] = true;
+
+    // 끝난 단계의 추정 비용 / 전체 추정 비용
+    double TotalCost = 0.0;
+    double FinishedCost = 0.0;
+    for (int32 i = 0; i < static_cast<int32>(EProcConvertStage::Num); ++i)
+    {
+        const double Cost = StageWork[i] * GetStageSecondsPerTriangle(static_cast<EProcConvertStage>(i));
+        TotalCost += Cost;
+        FinishedCost += bStageFinished[i] ? Cost : 0.0;
+    }
+    const float NewProgress = TotalCost > 0.0 ? static_cast<float>(FinishedCost / TotalCost) : 1.0f;
+
+    // 진행률을 쓰는 스레드는 작업을 가진 한 곳뿐이므로 비교 후 저장으로 충분하다
+    if (NewProgress > Progress.load())
+    {
+        Progress.store(NewProgress);
+    }
+}
+
+void FProcMeshConvertJob::Complete(int32 ErrorCode, UStaticMesh* StaticMesh)
+{
+    check(IsInGameThread());
+
+    if (bCompleteCalled)
+    {
+        return;
+    }
+    bCompleteCalled = true;
+
+    Timings.TotalMs = ToMs(FPlatformTime::Seconds() - SubmitTime);
+    if (ErrorCode == 0 && Timings.TotalMs > SlowConvertLogMs)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ProcMesh convert: %.1f ms for %d triangles (queue %.1f, cache lookup %.1f, prepare %.1f, descriptions %.1f, collision %.1f, finalize wait %.1f, build %.1f)"),
+            Timings.TotalMs, Timings.NumTriangles, Timings.QueueMs, Timings.CacheLookupMs, Timings.PrepareMs,
+            Timings.BuildDescriptionsMs, Timings.CollisionMs, Timings.FinalizeWaitMs, Timings.BuildMeshMs);
+    }
+
+    // 결과 전달 후 남은 버퍼와 콜백을 모두 해제
+    // (취소된 작업의 MeshData/MeshDescs 는 아직 워커가 쓰고 있을 수 있으므로 건드리지 않는다)
+    FOnComplete Callback = MoveTemp(OnComplete);
+    OnProgress = nullptr;
+    if (Callback)
+    {
+        Callback(ErrorCode, StaticMesh);
+    }
+}
+
+
+// -- FProcMeshProgressReporter implementation --
+FProcMeshProgressReporter& FProcMeshProgressReporter::Get()
+{
+    static FProcMeshProgressReporter Instance;
+    return Instance;
+}
+
+FProcMeshProgressReporter::FProcMeshProgressReporter()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FProcMeshProgressReporter::Tick));
+
+    // OnPreExit 는 스레드 안전하지 않으므로 게임 스레드에서 등록한다
+    RunOnGameThread([this]()
+        {
+            PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FProcMeshProgressReporter::Shutdown);
+        });
+}
+
+FProcMeshProgressReporter::~FProcMeshProgressReporter()
+{
+    // 엔진 종료 전에 모듈이 내려가는 경우 (핫 리로드 등)
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    Shutdown();
+}
+
+void FProcMeshProgressReporter::Shutdown()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    FScopeLock ScopeLock(&Lock);
+    IncomingJobs.Empty();
+    TrackedJobs.Empty();
+}
+
+void FProcMeshProgressReporter::Track(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job)
+{
+    FScopeLock ScopeLock(&Lock);
+    IncomingJobs.Add(Job);
+}
+
+bool FProcMeshProgressReporter::Tick(float DeltaTime)
+{
+    // 1. 새로 등록된 작업 가져오기
+    {
+        FScopeLock ScopeLock(&Lock);
+        for (const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job : IncomingJobs)
+        {
+            TrackedJobs.Add({ Job });
+        }
+        IncomingJobs.Reset();
+    }
+
+    // 2. 진행률이 오른 작업만 보고하고, 끝난 작업은 뺀다 (1.0 은 완료 콜백이 보고)
+    for (int32 i = TrackedJobs.Num() - 1; i >= 0; --i)
+    {
+        FTrackedJob& Tracked = TrackedJobs[i];
+        if (Tracked.Job->IsFinished())
+        {
+            TrackedJobs.RemoveAtSwap(i, 1, false);
+            continue;
+        }
+
+        const float Progress = Tracked.Job->GetProgress();
+        if (Progress > Tracked.ReportedProgress && Progress < 1.0f && Tracked.Job->OnProgress)
+        {
+            Tracked.ReportedProgress = Progress;
+            Tracked.Job->OnProgress(Progress);
+        }
+    }
+    return true;
+}
+
+
+// -- FProcMeshConvertScheduler implementation --
+FProcMeshConvertScheduler& FProcMeshConvertScheduler::Get()
+{
+    static FProcMeshConvertScheduler Instance;
+    return Instance;
+}
+
+FProcMeshConvertScheduler::FProcMeshConvertScheduler()
+{
+    MaxWorkers = FMath::Max(FTaskGraphInterface::Get().GetNumBackgroundThreads(), 1);
+}
+
+void FProcMeshConvertScheduler::Submit(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job)
+{
+    TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> Superseded;
+    {
+        FScopeLock ScopeLock(&Lock);
+
+        // 같은 슬롯의 이전 작업은 새 작업으로 대체된다
+        if (!Job->SlotKey.IsNone())
+        {
+            TWeakPtr<FProcMeshConvertJob, ESPMode::ThreadSafe>& SlotJob = SlotJobs.FindOrAdd(Job->SlotKey);
+            Superseded = SlotJob.Pin();
+            SlotJob = Job;
+        }
+    }
+
+    if (Superseded.IsValid())
+    {
+        Superseded->Cancel();
+    }
+
+    Job->SubmitTime = FPlatformTime::Seconds();
+    if (Job->OnProgress)
+    {
+        FProcMeshProgressReporter::Get().Track(Job);
+    }
+    Requeue(Job);
+}
+
+void FProcMeshConvertScheduler::Requeue(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job)
+{
+    bool bSpawnWorker = false;
+    {
+        FScopeLock ScopeLock(&Lock);
+
+        Job->SubmitOrder = NextSubmitOrder++;
+        Job->QueueEnterTime = FPlatformTime::Seconds();
+        PendingJobs.Add(Job);
+
+        if (NumWorkers < MaxWorkers)
+        {
+            ++NumWorkers;
+            bSpawnWorker = true;
+        }
+    }
+
+    if (bSpawnWorker)
+    {
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+            {
+                WorkerLoop();
+            });
+    }
+}
+
+TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> FProcMeshConvertScheduler::PopNextJob()
+{
+    // 대기 중에 취소된 작업 정리
+    PendingJobs.RemoveAll([](const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Pending)
+        {
+            return Pending->GetState() != EProcConvertState::Pending;
+        });
+
+    int32 BestIndex = INDEX_NONE;
+    for (int32 i = 0; i < PendingJobs.Num(); ++i)
+    {
+        const FProcMeshConvertJob& Candidate = *PendingJobs[i];
+        if (Candidate.Group.IsValid() && Candidate.Group->MaxConcurrent > 0 && Candidate.Group->NumInFlight >= Candidate.Group->MaxConcurrent)
+        {
+            continue;
+        }
+        if (BestIndex == INDEX_NONE || IsHigherPriority(Candidate, *PendingJobs[BestIndex]))
+        {
+            BestIndex = i;
+        }
+    }
+
+    if (BestIndex == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe> Job = PendingJobs[BestIndex];
+    PendingJobs.RemoveAt(BestIndex, 1, false);
+    if (Job->Group.IsValid())
+    {
+        ++Job->Group->NumInFlight;
+    }
+    return Job;
+}
+
+void FProcMeshConvertScheduler::WorkerLoop()
+{
+    for (;;)
+    {
+        TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> Job;
+        {
+            FScopeLock ScopeLock(&Lock);
+            Job = PopNextJob();
+            if (!Job.IsValid())
+            {
+                // 남은 작업은 그룹 제한에 걸린 것뿐이며, 실행 중인 워커가 끝나면서 이어서 처리한다
+                --NumWorkers;
+                return;
+            }
+        }
+
+        ProcessJob(*Job);
+
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (Job->Group.IsValid())
+            {
+                --Job->Group->NumInFlight;
+            }
+        }
+    }
+}
+
+namespace
+{
+    // 취소되었으면 입력 버퍼를 바로 해제하고 중단
+    bool IsAbandoned(FProcMeshConvertJob& Job)
+    {
+        if (!Job.IsCancelled())
+        {
+            return false;
+        }
+        Job.ReleaseInput();
+        Job.MeshDescs.Empty();
+        Job.CollisionHulls.Empty();
+        return true;
+    }
+
+    // 입력을 해제하고 게임 스레드에서 실패로 완료
+    void FailJob(FProcMeshConvertJob& Job)
+    {
+        Job.ReleaseInput();
+        if (Job.TransitionState(EProcConvertState::Processing, EProcConvertState::Failed))
+        {
+            TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe> Self = Job.AsShared();
+            AsyncTask(ENamedThreads::GameThread, [Self]()
+                {
+                    Self->Complete(FProcMeshConvertJob::ErrorCode_Failed, nullptr);
+                });
+        }
+    }
+
+    // 게임 스레드 마무리 대기열로 넘긴다
+    void EnqueueFinalize(FProcMeshConvertJob& Job)
+    {
+        if (Job.TransitionState(EProcConvertState::Processing, EProcConvertState::Finalizing))
+        {
+            Job.FinalizeEnqueueTime = FPlatformTime::Seconds();
+            FProcMeshFinalizeQueue::Get().Enqueue(Job.AsShared());
+        }
+        else
+        {
+            Job.MeshDescs.Empty();
+            Job.CollisionHulls.Empty();
+        }
+    }
+
+    // 입력 삼각형 수로 단계별 작업량을 정한다. BuildMesh 는 LOD 비율의 합으로 추정했다가 MeshDescription 이 나오면 실제 값으로 바꾼다
+    void EstimateStageWork(FProcMeshConvertJob& Job, const int32 NumTriangles)
+    {
+        TArray<float> TriangleRatios;
+        TArray<float> ScreenSizes;
+        LIB_MeshProcessing::GetLODSettings(Job.Options, TriangleRatios, ScreenSizes);
+        float TotalRatio = 0.0f;
+        for (const float Ratio : TriangleRatios)
+        {
+            TotalRatio += Ratio;
+        }
+
+        const bool bBuildHulls = Job.Options.CollisionMode == EProcCollisionMode::ConvexHull || Job.Options.CollisionMode == EProcCollisionMode::ConvexDecomposition;
+        Job.Timings.NumTriangles = NumTriangles;
+        Job.SetStageWork(EProcConvertStage::CacheLookup, NumTriangles);
+        Job.SetStageWork(EProcConvertStage::Prepare, NumTriangles);
+        Job.SetStageWork(EProcConvertStage::BuildDescriptions, NumTriangles);
+        Job.SetStageWork(EProcConvertStage::Collision, bBuildHulls ? NumTriangles : 0);
+        Job.SetStageWork(EProcConvertStage::BuildMesh, FMath::CeilToInt(NumTriangles * TotalRatio));
+    }
+
+    /**
+     * 검사 -> 캐시 조회 -> 전처리 -> MeshDescription 생성 -> 마무리 대기열 순서로 작업을 처리한다.
+     * Prepare 는 정리/UV/법선 처리 후 View 를 MeshDescription 을 만들 버퍼로 바꾸고, 남은 기하가 없으면 false 를 돌려준다.
+     * 각 단계가 끝날 때 FinishStage 로 시간을 기록하고 진행률을 올린다.
+     */
+    template<typename ViewType, typename PrepareFunc>
+    void RunConvertSteps(FProcMeshConvertJob& Job, ViewType View, PrepareFunc&& Prepare)
+    {
+        FProcMeshConvertCache& Cache = FProcMeshConvertCache::Get();
+        const bool bUseDiskCache = Job.Options.bUseCache && Job.Options.bUseDiskCache;
+        double StageStart = FPlatformTime::Seconds();
+
+        // Step 1: Validate input
+        if (!LIB_MeshProcessing::IsValidMeshData(View))
+        {
+            FailJob(Job);
+            return;
+        }
+        EstimateStageWork(Job, View.Triangles.Num() / 3);
+
+        // Step 1-1: Look up the conversion cache
+        if (Job.Options.bUseCache)
+        {
+            if (IsAbandoned(Job))
+            {
+                return;
+            }
+
+            // 메시가 아직 살아 있는지는 게임 스레드에서만 확인할 수 있으므로 입력은 그대로 둔 채 넘긴다
+            // (다시 들어온 작업은 키를 이미 계산했고 메모리 캐시에서 실패한 상태)
+            if (!Job.bSkipMemoryCache)
+            {
+                Job.CacheKey = FProcMeshConvertCache::ComputeKey(View, Job.Options);
+                if (Cache.ContainsMesh(Job.CacheKey))
+                {
+                    // 빌드 없이 끝나므로 남은 단계는 작업량이 없다 (GC 되어 다시 들어오면 다시 추정)
+                    Job.SetStageWork(EProcConvertStage::Prepare, 0);
+                    Job.SetStageWork(EProcConvertStage::BuildDescriptions, 0);
+                    Job.SetStageWork(EProcConvertStage::Collision, 0);
+                    Job.SetStageWork(EProcConvertStage::BuildMesh, 0);
+                    Job.FinishStage(EProcConvertStage::CacheLookup, StageStart);
+                    Job.bFinalizeFromCache = true;
+                    EnqueueFinalize(Job);
+                    return;
+                }
+            }
+
+            if (bUseDiskCache)
+            {
+                TArray<FMeshDescription> CachedDescs;
+                if (Cache.LoadMeshDescriptions(Job.CacheKey, CachedDescs))
+                {
+                    Job.ReleaseInput();
+                    Job.MeshDescs = MoveTemp(CachedDescs);
+                    Job.SetStageWork(EProcConvertStage::Prepare, 0);
+                    Job.SetStageWork(EProcConvertStage::BuildDescriptions, 0);
+                    Job.SetStageWork(EProcConvertStage::BuildMesh, CountTriangles(Job.MeshDescs));
+                    Job.FinishStage(EProcConvertStage::CacheLookup, StageStart);
+
+                    StageStart = FPlatformTime::Seconds();
+                    LIB_MeshProcessing::BuildCollisionHulls(Job.MeshDescs[0], Job.Options, Job.CollisionHulls);
+                    Job.FinishStage(EProcConvertStage::Collision, StageStart);
+                    EnqueueFinalize(Job);
+                    return;
+                }
+            }
+        }
+        Job.FinishStage(EProcConvertStage::CacheLookup, StageStart);
+
+        // Step 2-3: Repair, generate UVs if missing, recalculate normals and tangents if requested
+        if (IsAbandoned(Job))
+        {
+            return;
+        }
+        StageStart = FPlatformTime::Seconds();
+        if (!Prepare(View))
+        {
+            // 정리 후 남은 삼각형이 없는 경우
+            FailJob(Job);
+            return;
+        }
+        Job.FinishStage(EProcConvertStage::Prepare, StageStart);
+
+        // Step 4: Build MeshDescriptions (simplified LODs, vertex cache order) on the worker
+        if (IsAbandoned(Job))
+        {
+            return;
+        }
+        StageStart = FPlatformTime::Seconds();
+        LIB_MeshProcessing::BuildLODMeshDescriptions(View, Job.Options, Job.MeshDescs, &Job.VertexCacheStats);
+        Job.ReleaseInput(); // 원본 버퍼는 더 이상 필요 없으므로 바로 해제
+        if (bUseDiskCache)
+        {
+            Cache.SaveMeshDescriptions(Job.CacheKey, Job.MeshDescs);
+        }
+        Job.SetStageWork(EProcConvertStage::BuildMesh, CountTriangles(Job.MeshDescs));
+        Job.FinishStage(EProcConvertStage::BuildDescriptions, StageStart);
+
+        // Step 4-1: Collision hulls from LOD0 (cooking starts on the game thread without waiting)
+        StageStart = FPlatformTime::Seconds();
+        LIB_MeshProcessing::BuildCollisionHulls(Job.MeshDescs[0], Job.Options, Job.CollisionHulls);
+        Job.FinishStage(EProcConvertStage::Collision, StageStart);
+
+        // Step 5: Safe StaticMesh Creation
+        // 게임 스레드의 프레임 예산 안에서 우선순위 순으로 빌드된다
+        EnqueueFinalize(Job);
+    }
+}
+
+void FProcMeshConvertScheduler::ProcessJob(FProcMeshConvertJob& Job)
+{
+    if (!Job.TransitionState(EProcConvertState::Pending, EProcConvertState::Processing))
+    {
+        return;
+    }
+    Job.Timings.QueueMs += ToMs(FPlatformTime::Seconds() - Job.QueueEnterTime);
+
+    // 파일 입력은 워커에서 매핑한다 (압축된 스트림만 해제)
+    if (!Job.SourceFilePath.IsEmpty() && !Job.SourceFile.IsValid())
+    {
+        Job.SourceFile = FProcMeshFile::Load(Job.SourceFilePath);
+        if (!Job.SourceFile.IsValid())
+        {
+            FailJob(Job);
+            return;
+        }
+    }
+
+    // 공유 입력은 수정하지 않고 원본 버퍼를 그대로 읽으며, 새로 만든 버퍼만 작업의 Scratch 에 둔다
+    auto PrepareSharedBuffer = [&Job](FProcMeshBufferView& View)
+    {
+        FProcMeshBufferView Prepared;
+        const bool bPrepared = LIB_MeshProcessing::PrepareMeshView(View, Job.Options, Job.BufferScratch, Prepared, &Job.RepairStats);
+        View = Prepared;
+        return bPrepared;
+    };
+    auto PrepareSharedMeshData = [&Job](FProcMeshDataView& View)
+    {
+        FProcMeshDataView Prepared;
+        const bool bPrepared = LIB_MeshProcessing::PrepareMeshView(View, Job.Options, Job.MeshData, Prepared, &Job.RepairStats);
+        View = Prepared;
+        return bPrepared;
+    };
+
+    if (Job.SourceFile.IsValid())
+    {
+        if (Job.SourceFile->IsBuffer())
+        {
+            RunConvertSteps(Job, Job.SourceFile->GetMeshBuffer(), PrepareSharedBuffer);
+        }
+        else
+        {
+            RunConvertSteps(Job, Job.SourceFile->GetMeshData(), PrepareSharedMeshData);
+        }
+    }
+    else if (Job.SharedBuffer.IsValid())
+    {
+        RunConvertSteps(Job, FProcMeshBufferView(*Job.SharedBuffer), PrepareSharedBuffer);
+    }
+    else if (Job.SharedMeshData.IsValid())
+    {
+        RunConvertSteps(Job, FProcMeshDataView(*Job.SharedMeshData), PrepareSharedMeshData);
+    }
+    else
+    {
+        // 작업이 소유한 입력은 제자리에서 전처리한다
+        RunConvertSteps(Job, FProcMeshDataView(Job.MeshData), [&Job](FProcMeshDataView& View)
+            {
+                const bool bPrepared = LIB_MeshProcessing::PrepareMeshData(Job.MeshData, Job.Options, &Job.RepairStats);
+                View = Job.MeshData;
+                return bPrepared;
+            });
+    }
+}
+
+
+// -- FProcMeshFinalizeQueue implementation --
+FProcMeshFinalizeQueue& FProcMeshFinalizeQueue::Get()
+{
+    static FProcMeshFinalizeQueue Instance;
+    return Instance;
+}
+
+FProcMeshFinalizeQueue::FProcMeshFinalizeQueue()
+{
+    // FTSTicker 는 스레드 안전하므로 워커에서 처음 Get() 이 불려도 등록할 수 있다
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FProcMeshFinalizeQueue::Tick));
+
+    // OnPreExit 는 스레드 안전하지 않으므로 게임 스레드에서 등록한다
+    RunOnGameThread([this]()
+        {
+            PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FProcMeshFinalizeQueue::Shutdown);
+        });
+}
+
+FProcMeshFinalizeQueue::~FProcMeshFinalizeQueue()
+{
+    // 엔진 종료 전에 모듈이 내려가는 경우 (핫 리로드 등)
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    Shutdown();
+}
+
+void FProcMeshFinalizeQueue::Shutdown()
+{
+    // 종료 후 남은 틱이 해제된 this 를 호출하지 않도록 티커를 먼저 뗀다
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    FScopeLock ScopeLock(&Lock);
+    PendingJobs.Empty();
+}
+
+void FProcMeshFinalizeQueue::Enqueue(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job)
+{
+    FScopeLock ScopeLock(&Lock);
+    PendingJobs.Add(Job);
+}
+
+void FProcMeshFinalizeQueue::SetFrameBudgetMs(float InBudgetMs)
+{
+    check(IsInGameThread());
+    BudgetMs = FMath::Max(InBudgetMs, 0.0f);
+}
+
+bool FProcMeshFinalizeQueue::Tick(float DeltaTime)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = BudgetMs / 1000.0;
+    int32 NumFinalized = 0;
+
+    for (;;)
+    {
+        // 1. 취소된 작업을 버리고 우선순위가 가장 높은 작업 선택
+        TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> Job;
+        {
+            FScopeLock ScopeLock(&Lock);
+            PendingJobs.RemoveAll([](const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Pending)
+                {
+                    if (Pending->GetState() == EProcConvertState::Finalizing)
+                    {
+                        return false;
+                    }
+                    Pending->MeshDescs.Empty();
+                    Pending->CollisionHulls.Empty();
+                    return true;
+                });
+
+            int32 BestIndex = INDEX_NONE;
+            for (int32 i = 0; i < PendingJobs.Num(); ++i)
+            {
+                if (BestIndex == INDEX_NONE || IsHigherPriority(*PendingJobs[i], *PendingJobs[BestIndex]))
+                {
+                    BestIndex = i;
+                }
+            }
+            if (BestIndex == INDEX_NONE)
+            {
+                break;
+            }
+
+            // 2. 남은 예산으로 끝나지 않을 것 같으면 다음 프레임으로 미룬다 (캐시 적중 후보는 빌드하지 않으므로 비용 0)
+            const FProcMeshConvertJob& Best = *PendingJobs[BestIndex];
+            const int32 EstimatedTriangles = Best.bFinalizeFromCache ? 0 : CountTriangles(Best.MeshDescs);
+            const double Elapsed = FPlatformTime::Seconds() - StartTime;
+            if (NumFinalized > 0 && Elapsed + GetStageSecondsPerTriangle(EProcConvertStage::BuildMesh) * EstimatedTriangles > BudgetSeconds)
+            {
+                break;
+            }
+
+            Job = PendingJobs[BestIndex];
+            PendingJobs.RemoveAt(BestIndex, 1, false);
+        }
+        Job->Timings.FinalizeWaitMs += ToMs(FPlatformTime::Seconds() - Job->FinalizeEnqueueTime);
+
+        // 3. 캐시 적중 후보는 메시가 살아 있으면 바로 완료하고, GC 되었으면 워커에서 처음부터 다시 처리
+        if (Job->bFinalizeFromCache)
+        {
+            Job->bFinalizeFromCache = false;
+            if (UStaticMesh* CachedMesh = FProcMeshConvertCache::Get().FindMesh(Job->CacheKey))
+            {
+                if (Job->TransitionState(EProcConvertState::Finalizing, EProcConvertState::Completed))
+                {
+                    Job->ReleaseInput();
+                    Job->Complete(0, CachedMesh);
+                }
+            }
+            else if (Job->TransitionState(EProcConvertState::Finalizing, EProcConvertState::Pending))
+            {
+                Job->bSkipMemoryCache = true;
+                FProcMeshConvertScheduler::Get().Requeue(Job.ToSharedRef());
+            }
+            continue;
+        }
+
+        // 4. 스태틱 메시 빌드 (삼각형당 빌드 시간은 FinishStage 에서 지수 이동 평균으로 갱신된다)
+        const double BuildStart = FPlatformTime::Seconds();
+        TArray<float> TriangleRatios;
+        TArray<float> ScreenSizes;
+        LIB_MeshProcessing::GetLODSettings(Job->Options, TriangleRatios, ScreenSizes);
+        UStaticMesh* StaticMesh = ULIB_Export::BuildStaticMeshFromDescriptions(Job->MeshDescs, ScreenSizes);
+        Job->MeshDescs.Empty();
+        Job->FinishStage(EProcConvertStage::BuildMesh, BuildStart);
+
+        // 빌드 도중 다른 스레드에서 취소되었다면 결과를 버린다
+        const EProcConvertState FinalState = StaticMesh ? EProcConvertState::Completed : EProcConvertState::Failed;
+        if (Job->TransitionState(EProcConvertState::Finalizing, FinalState))
+        {
+            if (StaticMesh && Job->Options.bUseCache)
+            {
+                FProcMeshConvertCache::Get().AddMesh(Job->CacheKey, StaticMesh);
+            }
+
+            // 충돌 쿠킹은 메시를 넘겨준 뒤 백그라운드에서 끝나고, 그때 물리 상태를 다시 만든다
+            if (StaticMesh && Job->Options.CollisionMode != EProcCollisionMode::None)
+            {
+                ULIB_Export::BuildCollisionAsync(StaticMesh, Job->Options.CollisionMode, MoveTemp(Job->CollisionHulls), {}, MoveTemp(Job->OnCollisionReady));
+            }
+            Job->Complete(StaticMesh ? 0 : FProcMeshConvertJob::ErrorCode_Failed, StaticMesh);
+        }
+        Job->CollisionHulls.Empty();
+        ++NumFinalized;
+    }
+    return true;
+}
+
+
+// -- FProcMeshConvertBatch implementation --
+FProcMeshConvertBatch::FProcMeshConvertBatch(
+    TArray<FProcMeshData>&& InItems,
+    const FProcMeshConvertOptions& InOptions,
+    const ULIB_Export::FOnStaticMeshProgress& InOnProgress,
+    const ULIB_Export::FOnStaticMeshBatchItem& InOnItemResult,
+    const ULIB_Export::FOnStaticMeshBatchResult& InOnBatchResult)
+    : OnProgress(InOnProgress)
+    , OnItemResult(InOnItemResult)
+    , OnBatchResult(InOnBatchResult)
+{
+    Jobs.Reserve(InItems.Num());
+    for (FProcMeshData& Item : InItems)
+    {
+        Jobs.Add(MakeShared<FProcMeshConvertJob, ESPMode::ThreadSafe>(MoveTemp(Item), InOptions, NAME_None, 0));
+    }
+    InItems.Reset();
+    Results.SetNum(Jobs.Num());
+}
+
+void FProcMeshConvertBatch::Start(int32 MaxWorkers)
+{
+    check(IsInGameThread());
+
+    if (Jobs.Num() == 0)
+    {
+        OnProgress.ExecuteIfBound(1.0f);
+        OnBatchResult.ExecuteIfBound(TArray<UStaticMesh*>());
+        return;
+    }
+
+    TSharedRef<FProcMeshConvertGroup, ESPMode::ThreadSafe> Group = MakeShared<FProcMeshConvertGroup, ESPMode::ThreadSafe>();
+    Group->MaxConcurrent = MaxWorkers;
+
+    // 작업 -> 배치 참조는 약한 참조로 두어 순환 참조를 만들지 않는다
+    TWeakPtr<FProcMeshConvertBatch, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+    {
+        Jobs[Index]->Group = Group;
+        Jobs[Index]->OnComplete = [WeakSelf, Index](int32 ErrorCode, UStaticMesh* StaticMesh)
+        {
+            if (TSharedPtr<FProcMeshConvertBatch, ESPMode::ThreadSafe> Self = WeakSelf.Pin())
+            {
+                Self->OnItemFinished(Index, ErrorCode, StaticMesh);
+            }
+        };
+        FProcMeshConvertScheduler::Get().Submit(Jobs[Index]);
+    }
+
+    // 틱 델리게이트가 강한 참조를 들고 있다가 Tick 이 false 를 반환하거나 Shutdown 에서 떼어지면 함께 해제된다
+    TSharedRef<FProcMeshConvertBatch, ESPMode::ThreadSafe> Self = AsShared();
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self](float DeltaTime)
+        {
+            return Self->Tick(DeltaTime);
+        }));
+
+    // 종료 후에는 남은 작업이 끝나지 않으므로 UObject 정리 전에 틱과 결과를 놓는다 (Start 는 게임 스레드에서만 불림)
+    PreExitHandle = FCoreDelegates::OnPreExit.AddSP(Self, &FProcMeshConvertBatch::Shutdown);
+}
+
+void FProcMeshConvertBatch::Shutdown()
+{
+    // 티커가 마지막 강한 참조일 수 있으므로 정리가 끝날 때까지 붙잡아 둔다
+    TSharedRef<FProcMeshConvertBatch, ESPMode::ThreadSafe> Self = AsShared();
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    // 취소 완료는 배치가 해제된 뒤에 불리므로 작업의 약한 참조에서 걸러진다
+    for (const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job : Jobs)
+    {
+        Job->Cancel();
+    }
+    Results.Reset();
+    Jobs.Reset();
+}
+
+void FProcMeshConvertBatch::OnItemFinished(int32 Index, int32 ErrorCode, UStaticMesh* StaticMesh)
+{
+    Results[Index].Reset(StaticMesh);
+    ++NumFinished;
+    OnItemResult.ExecuteIfBound(Index, ErrorCode, StaticMesh);
+}
+
+bool FProcMeshConvertBatch::Tick(float DeltaTime)
+{
+    // 1. 진행률 보고 (프레임당 한 번)
+    float Progress = 0.0f;
+    for (const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job : Jobs)
+    {
+        Progress += Job->IsFinished() ? 1.0f : Job->GetProgress();
+    }
+    Progress /= Jobs.Num();
+    if (Progress != LastReportedProgress)
+    {
+        LastReportedProgress = Progress;
+        OnProgress.ExecuteIfBound(Progress);
+    }
+
+    if (NumFinished < Jobs.Num())
+    {
+        return true;
+    }
+
+    // 2. 전체 결과 전달 후 틱 해제
+    TArray<UStaticMesh*> StaticMeshes;
+    StaticMeshes.Reserve(Results.Num());
+    for (const TStrongObjectPtr<UStaticMesh>& Result : Results)
+    {
+        StaticMeshes.Add(Result.Get());
+    }
+    OnBatchResult.ExecuteIfBound(StaticMeshes);
+    Results.Reset();
+    Jobs.Reset();
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    TickerHandle.Reset();
+    return false;
+}
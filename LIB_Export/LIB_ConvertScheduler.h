@@ -0,0 +1,277 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "MeshDescription.h"
+#include "UObject/StrongObjectPtr.h"
+#include "LIB_Export.h"
+#include "LIB_MeshBuffer.h"
+#include "LIB_MeshFile.h"
+#include <atomic>
+
+// 동시에 워커에서 처리할 수 있는 작업 수를 제한하는 작업 묶음 (배치 변환용). 스케줄러 잠금 안에서만 접근한다.
+struct FProcMeshConvertGroup
+{
+	int32 MaxConcurrent = 0;	// 0 이하이면 제한 없음
+	int32 NumInFlight = 0;
+};
+
+// 진행률 가중치와 단계별 시간 측정의 단위가 되는 변환 단계
+enum class EProcConvertStage : uint8
+{
+	CacheLookup,		// 입력 검사와 캐시 키 계산/조회
+	Prepare,			// 정리, 법선, UV, 탄젠트
+	BuildDescriptions,	// LOD 단순화와 정점 캐시 정렬을 포함한 MeshDescription 생성
+	Collision,			// 충돌용 볼록 껍질
+	BuildMesh,			// 게임 스레드 스태틱 메시 빌드
+	Num
+};
+
+/**
+ * 변환 작업 하나. 스케줄러 대기열 -> 워커 전처리 -> 게임 스레드 마무리 순서로 진행됩니다.
+ * 상태 전환은 원자적으로 이루어지므로 어느 단계에서든 취소할 수 있습니다.
+ */
+class FProcMeshConvertJob : public TSharedFromThis<FProcMeshConvertJob, ESPMode::ThreadSafe>
+{
+public:
+	using FOnProgress = TFunction<void(float)>;
+	using FOnComplete = TUniqueFunction<void(int32, UStaticMesh*)>;
+
+	static constexpr int32 ErrorCode_Failed = -1;
+	static constexpr int32 ErrorCode_Cancelled = -2;
+
+	FProcMeshConvertJob(FProcMeshData&& InMeshData, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority);
+	// 공유 입력은 복사하지 않고 작업이 끝날 때까지 참조만 합니다.
+	FProcMeshConvertJob(const TSharedRef<const FProcMeshData, ESPMode::ThreadSafe>& InSharedMeshData, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority);
+	FProcMeshConvertJob(const TSharedRef<const FProcMeshBuffer, ESPMode::ThreadSafe>& InSharedBuffer, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority);
+	// FProcMeshFile 로 저장한 파일을 워커에서 불러와 변환합니다.
+	FProcMeshConvertJob(const FString& InSourceFilePath, const FProcMeshConvertOptions& InOptions, FName InSlotKey, int32 InPriority);
+
+	EProcConvertState GetState() const { return State.load(); }
+	bool IsCancelled() const { return GetState() == EProcConvertState::Cancelled; }
+	bool IsFinished() const;
+
+	int32 GetPriority() const { return Priority.load(); }
+	void SetPriority(int32 NewPriority) { Priority.store(NewPriority); }
+
+	// Expected 상태일 때만 NewState 로 전환합니다.
+	bool TransitionState(EProcConvertState Expected, EProcConvertState NewState);
+
+	// 아직 끝나지 않은 작업을 취소하고, 게임 스레드에서 OnComplete(ErrorCode_Cancelled) 를 호출합니다.
+	void Cancel();
+
+	/**
+	 * 단계별 작업량(삼각형 수)을 정합니다. 진행률은 전체 작업량 x 단계별 실측 삼각형당 시간 중 끝난 단계의 비율입니다.
+	 * 해당 단계를 실행하는 스레드에서 호출하며, 건너뛰는 단계는 0 으로 둡니다.
+	 */
+	void SetStageWork(EProcConvertStage Stage, int32 NumTriangles);
+
+	// 단계를 마치고 소요 시간을 Timings 와 단계별 비용 추정에 반영한 뒤 진행률을 올립니다. (진행률은 줄어들지 않음)
+	void FinishStage(EProcConvertStage Stage, double StartTime);
+
+	// 아무 스레드. 실제 보고는 FProcMeshProgressReporter 가 프레임당 한 번 합니다.
+	float GetProgress() const { return Progress.load(); }
+
+	// 게임 스레드 전용. OnComplete 는 한 번만 호출됩니다.
+	void Complete(int32 ErrorCode, UStaticMesh* StaticMesh);
+
+	// 입력과 전처리 버퍼를 모두 해제합니다. (워커 또는 워커가 끝난 뒤의 게임 스레드에서 호출)
+	void ReleaseInput();
+
+	// 입력은 MeshData, SharedMeshData, SharedBuffer, SourceFilePath 중 하나.
+	// 공유 입력이면 MeshData / BufferScratch 는 전처리에서 새로 만든 버퍼만 담는다.
+	FProcMeshData MeshData;
+	TSharedPtr<const FProcMeshData, ESPMode::ThreadSafe> SharedMeshData;
+	TSharedPtr<const FProcMeshBuffer, ESPMode::ThreadSafe> SharedBuffer;
+	FString SourceFilePath;
+	TSharedPtr<const FProcMeshFile, ESPMode::ThreadSafe> SourceFile;	// 워커가 SourceFilePath 를 불러온 결과 (매핑된 파일)
+	FProcMeshBuffer BufferScratch;
+	FProcMeshConvertOptions Options;
+	FName SlotKey;
+
+	// 워커가 만든 LOD 순서의 결과. Finalizing 상태에서만 유효합니다.
+	TArray<FMeshDescription> MeshDescs;
+
+	// Options.CollisionMode 가 볼록 껍질일 때 워커가 LOD0 으로 계산한 껍질별 점 집합. Finalizing 상태에서만 유효합니다.
+	TArray<TArray<FVector3f>> CollisionHulls;
+
+	// Options.bRepairMesh 일 때 워커가 채우는 정리 결과
+	FProcMeshRepairStats RepairStats;
+
+	// Options.bOptimizeVertexCache 일 때 워커가 채우는 LOD0 재정렬 결과
+	FProcMeshVertexCacheStats VertexCacheStats;
+
+	// Options.bUseCache 일 때 워커가 계산한 캐시 키
+	uint64 CacheKey = 0;
+	// 메모리 캐시에 키가 있어 전처리 없이 마무리 대기열로 넘어온 작업 (메시가 GC 되었으면 다시 워커로 돌아간다)
+	bool bFinalizeFromCache = false;
+	bool bSkipMemoryCache = false;
+
+	TSharedPtr<FProcMeshConvertGroup, ESPMode::ThreadSafe> Group;
+	FOnProgress OnProgress;
+	FOnComplete OnComplete;
+	// 완료된 작업의 충돌 쿠킹이 끝나면 게임 스레드에서 호출
+	TFunction<void(UStaticMesh*, bool)> OnCollisionReady;
+
+	// 같은 우선순위에서는 먼저 들어온 작업부터 처리
+	uint64 SubmitOrder = 0;
+
+	// 제출 시각과 워커/마무리 대기열에 들어간 시각 (QueueMs, FinalizeWaitMs, TotalMs 계산용)
+	double SubmitTime = 0.0;
+	double QueueEnterTime = 0.0;
+	double FinalizeEnqueueTime = 0.0;
+	// 워커와 게임 스레드가 차례로 채우는 단계별 소요 시간. 완료(또는 실패) 후에만 읽을 수 있습니다.
+	FProcMeshConvertTimings Timings;
+
+private:
+	std::atomic<EProcConvertState> State;
+	std::atomic<int32> Priority;
+	std::atomic<float> Progress{ 0.0f };
+	bool bCompleteCalled = false;
+
+	// 작업을 가진 스레드만 접근 (워커 -> 마무리 대기열 -> 게임 스레드 순으로 넘어간다)
+	int32 StageWork[static_cast<int32>(EProcConvertStage::Num)] = {};
+	bool bStageFinished[static_cast<int32>(EProcConvertStage::Num)] = {};
+};
+
+/**
+ * OnProgress 가 있는 작업의 진행률을 게임 스레드 틱에서 모아, 작업마다 프레임당 최대 한 번, 값이 올랐을 때만 보고합니다.
+ * 워커는 진행률만 갱신하고 게임 스레드 작업을 따로 올리지 않습니다. 1.0 은 완료 콜백에서 보고하므로 여기서는 보내지 않습니다.
+ */
+class FProcMeshProgressReporter
+{
+public:
+	static FProcMeshProgressReporter& Get();
+
+	// 아무 스레드에서나 호출할 수 있습니다. 작업이 끝나면 자동으로 빠집니다.
+	void Track(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job);
+
+private:
+	FProcMeshProgressReporter();
+	~FProcMeshProgressReporter();
+	bool Tick(float DeltaTime);
+	// 티커를 해제하고 추적 중인 작업을 놓는다 (엔진 종료 전 또는 싱글턴 소멸 시)
+	void Shutdown();
+
+	struct FTrackedJob
+	{
+		TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe> Job;
+		float ReportedProgress = 0.0f;
+	};
+
+	FCriticalSection Lock;
+	TArray<TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>> IncomingJobs;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreExitHandle;
+
+	// 게임 스레드 전용 상태
+	TArray<FTrackedJob> TrackedJobs;
+};
+
+/**
+ * 변환 작업 대기열. 백그라운드 스레드 수만큼의 워커가 우선순위가 가장 높은 작업부터 꺼내 처리합니다.
+ * 같은 SlotKey 로 새 작업이 들어오면 이전 작업은 자동으로 취소됩니다.
+ */
+class FProcMeshConvertScheduler
+{
+public:
+	static FProcMeshConvertScheduler& Get();
+
+	// 아무 스레드에서나 호출할 수 있습니다. OnProgress 가 있으면 FProcMeshProgressReporter 에 등록합니다.
+	void Submit(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job);
+
+	// 이미 제출된 작업을 슬롯 대체 없이 대기열에 다시 넣습니다. 작업은 Pending 상태여야 합니다.
+	void Requeue(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job);
+
+private:
+	FProcMeshConvertScheduler();
+
+	void WorkerLoop();
+
+	// Lock 을 잡은 상태에서 호출
+	TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> PopNextJob();
+
+	void ProcessJob(FProcMeshConvertJob& Job);
+
+	FCriticalSection Lock;
+	TArray<TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>> PendingJobs;
+	TMap<FName, TWeakPtr<FProcMeshConvertJob, ESPMode::ThreadSafe>> SlotJobs;
+	int32 NumWorkers = 0;
+	int32 MaxWorkers = 1;
+	uint64 NextSubmitOrder = 0;
+};
+
+/**
+ * 워커에서 MeshDescription 까지 만든 작업을 게임 스레드에서 UStaticMesh 로 빌드하는 대기열.
+ * 우선순위가 높은 작업부터, 실측한 삼각형당 빌드 시간(BuildMesh 단계 비용)으로 비용을 추정하여 프레임 예산 안에 들어오는 만큼만 빌드합니다.
+ * (한 프레임에 최소 하나는 처리하므로 예산보다 큰 메시도 결국 완료됩니다)
+ */
+class FProcMeshFinalizeQueue
+{
+public:
+	static FProcMeshFinalizeQueue& Get();
+
+	// 아무 스레드에서나 호출할 수 있습니다. 작업은 Finalizing 상태여야 합니다.
+	void Enqueue(const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job);
+
+	void SetFrameBudgetMs(float InBudgetMs);
+	float GetFrameBudgetMs() const { return BudgetMs; }
+
+private:
+	FProcMeshFinalizeQueue();
+	~FProcMeshFinalizeQueue();
+	bool Tick(float DeltaTime);
+	// 티커를 해제하고 남은 작업을 버린다 (엔진 종료 전 또는 싱글턴 소멸 시)
+	void Shutdown();
+
+	FCriticalSection Lock;
+	TArray<TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>> PendingJobs;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreExitHandle;
+
+	// 게임 스레드 전용 상태
+	float BudgetMs = 4.0f;
+};
+
+/**
+ * 여러 FProcMeshData 를 하나의 작업 묶음으로 스케줄러에 넣고, 게임 스레드에서 결과를 모아 전달하는 배치 작업.
+ * 진행률은 작업별 단계 가중 진행률의 평균이며 프레임당 한 번만 보고합니다.
+ */
+class FProcMeshConvertBatch : public TSharedFromThis<FProcMeshConvertBatch, ESPMode::ThreadSafe>
+{
+public:
+	FProcMeshConvertBatch(
+		TArray<FProcMeshData>&& InItems,
+		const FProcMeshConvertOptions& InOptions,
+		const ULIB_Export::FOnStaticMeshProgress& InOnProgress,
+		const ULIB_Export::FOnStaticMeshBatchItem& InOnItemResult,
+		const ULIB_Export::FOnStaticMeshBatchResult& InOnBatchResult);
+
+	/**
+	 * 작업을 스케줄러에 넣고 게임 스레드 틱을 등록합니다. 게임 스레드에서 호출해야 합니다.
+	 * @param MaxWorkers 이 배치에서 동시에 처리할 최대 작업 수. 0 이하이면 스케줄러 워커 수만큼 사용합니다.
+	 */
+	void Start(int32 MaxWorkers);
+
+private:
+	void OnItemFinished(int32 Index, int32 ErrorCode, UStaticMesh* StaticMesh);
+	bool Tick(float DeltaTime);
+	// 엔진 종료 전: 티커를 해제하고 남은 작업을 취소한 뒤 결과를 놓는다
+	void Shutdown();
+
+	TArray<TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>> Jobs;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreExitHandle;
+
+	ULIB_Export::FOnStaticMeshProgress OnProgress;
+	ULIB_Export::FOnStaticMeshBatchItem OnItemResult;
+	ULIB_Export::FOnStaticMeshBatchResult OnBatchResult;
+
+	// 게임 스레드 전용 상태
+	TArray<TStrongObjectPtr<UStaticMesh>> Results;
+	int32 NumFinished = 0;
+	float LastReportedProgress = -1.0f;
+};
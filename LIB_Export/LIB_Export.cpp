@@ -1,330 +1,936 @@
-#pragma once
-
-#include "LIB_Export.h"
-#include "StaticMeshAttributes.h"
-#include "MeshDescription.h"
-#include "StaticMeshResources.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
-#include <fstream>
-#include "GeometryScript/MeshAssetFunctions.h"
-#include "GeometryScript/MeshQueryFunctions.h"
-#include "UObject/UObjectGlobals.h"
-#include "UDynamicMesh.h"
-#include "DynamicMesh/DynamicMesh3.h"
-#include "DynamicMesh/DynamicMeshAttributeSet.h"
-
-#include "IImageWrapperModule.h"
-
-
-UStaticMesh* ULIB_Export::ConvertProcToStaticMesh(FProcMeshData MeshData, const bool RecalculateNormal)
-{
-    // 1. 유효성 검사 추가
-    if (MeshData.Vertices.Num() == 0 || MeshData.Triangles.Num() % 3 != 0)
-        return nullptr;
-
-    // UV0가 없는 경우 UV를 자동 생성
-    if (MeshData.UV0.Num() == 0)
-    {
-        MeshData.UV0.SetNum(MeshData.Vertices.Num());
-        for (int32 i = 0; i < MeshData.Vertices.Num(); i++)
-        {
-            const FVector& Vert = MeshData.Vertices[i];
-            MeshData.UV0[i] = FVector2D(Vert.X, Vert.Y); // 간단한 평면 투영
-        }
-    }
-
-    // RecalculateNormal 이 true일때  Normals를 자동 생성
-    if (RecalculateNormal)
-    {
-        MeshData.Normals.SetNum(MeshData.Vertices.Num());
-        for (int32 i = 0; i < MeshData.Triangles.Num(); i += 3)
-        {
-            const int32 Index0 = MeshData.Triangles[i];
-            const int32 Index1 = MeshData.Triangles[i + 1];
-            const int32 Index2 = MeshData.Triangles[i + 2];
-
-            if (MeshData.Vertices.IsValidIndex(Index0) && MeshData.Vertices.IsValidIndex(Index1) && MeshData.Vertices.IsValidIndex(Index2))
-            {
-                const FVector Edge1 = MeshData.Vertices[Index1] - MeshData.Vertices[Index0];
-                const FVector Edge2 = MeshData.Vertices[Index2] - MeshData.Vertices[Index0];
-                const FVector Normal = FVector::CrossProduct(Edge2, Edge1).GetSafeNormal();
-
-                MeshData.Normals[Index0] = Normal;
-                MeshData.Normals[Index1] = Normal;
-                MeshData.Normals[Index2] = Normal;
-            }
-        }
-    }
-
-    // 2. 스태틱 메시 생성
-    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
-
-    // 중요: 렌더 리소스를 올바르게 초기화
-    StaticMesh->ReleaseResources();  // 기존 리소스 제거
-    StaticMesh->InitResources();     // 새 리소스 초기화
-
-    FMeshDescription MeshDesc;
-    FStaticMeshAttributes Attributes(MeshDesc);
-    Attributes.Register();
-    
-    // 3. 정점 생성
-    TArray<FVertexID> VertexIDs;
-    for (const FVector& Vert : MeshData.Vertices)
-    {
-        FVertexID Vid = MeshDesc.CreateVertex();
-        Attributes.GetVertexPositions()[Vid] = FVector3f(Vert);
-        VertexIDs.Add(Vid);
-    }
-
-    // 4. 폴리곤 그룹 및 UV 채널 설정
-    FPolygonGroupID Pgid = MeshDesc.CreatePolygonGroup();
-    const int32 NumUvChannels = 1;
-    Attributes.GetVertexInstanceUVs().SetNumChannels(NumUvChannels);
-
-    // 5. 삼각형 및 정점 인스턴스 생성
-    for (int32 i = 0; i < MeshData.Triangles.Num(); i += 3)
-    {
-        // 삼각형을 구성하는 세 개의 인덱스를 먼저 추출
-        const int32 Index0 = MeshData.Triangles[i];
-        const int32 Index1 = MeshData.Triangles[i + 1];
-        const int32 Index2 = MeshData.Triangles[i + 2];
-
-        // 모든 정점 인덱스가 유효한지 확인
-        if (!VertexIDs.IsValidIndex(Index0) || !VertexIDs.IsValidIndex(Index1) || !VertexIDs.IsValidIndex(Index2))
-        {
-            // 유효하지 않은 인덱스가 있으면 해당 삼각형 전체를 건너뛰기
-            continue;
-        }
-
-        // 유효한 경우, 정점 인스턴스를 생성하여 저장
-        TArray<FVertexInstanceID> VertexInstances;
-        const int32 Indices[3] = { Index0, Index1, Index2 };
-
-
-        // 각 정점 인스턴스에 속성 할당
-        for (int32 j = 0; j < 3; j++)
-        {
-            const int32 VertIndex = Indices[j];
-            //if (!VertexIDs.IsValidIndex(VertIndex))
-            //{
-            //    // Invalid vertex index, skip this triangle
-            //    continue;
-            //}
-
-            FVertexInstanceID InstanceID = MeshDesc.CreateVertexInstance(VertexIDs[VertIndex]);
-
-            // 법선 설정
-            if (MeshData.Normals.IsValidIndex(VertIndex))
-                Attributes.GetVertexInstanceNormals()[InstanceID] = FVector3f(MeshData.Normals[VertIndex]);
-
-            // UV 설정 (채널 0)
-            if (MeshData.UV0.IsValidIndex(VertIndex))
-                Attributes.GetVertexInstanceUVs().Set(InstanceID, 0, FVector2f(MeshData.UV0[VertIndex]));
-
-            // 버텍스 컬러 설정
-            if (MeshData.VertexColors.IsValidIndex(VertIndex))
-                Attributes.GetVertexInstanceColors()[InstanceID] = FLinearColor(MeshData.VertexColors[VertIndex]);
-
-            // 탄젠트 설정
-            if (MeshData.Tangents.IsValidIndex(VertIndex))
-            {
-                const FProcMeshTangent& Tangent = MeshData.Tangents[VertIndex];
-                Attributes.GetVertexInstanceTangents()[InstanceID] = FVector3f(Tangent.TangentX);
-                Attributes.GetVertexInstanceBinormalSigns()[InstanceID] = Tangent.bFlipTangentY ? -1.0f : 1.0f;
-            }
-            VertexInstances.Add(InstanceID);
-        }
-
-        // 삼각형 생성
-        if (VertexInstances.Num() == 3)
-        {
-            MeshDesc.CreateTriangle(Pgid, VertexInstances);
-        }
-    }
-
-    // 6. 메시 빌드 설정
-    StaticMesh->CreateBodySetup();
-    
-    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
-    BuildParams.bBuildSimpleCollision = false;
-    BuildParams.bFastBuild = true;
-    StaticMesh->bAllowCPUAccess = true;
-    StaticMesh->BuildFromMeshDescriptions({ &MeshDesc }, BuildParams);
-    StaticMesh->InitResources();
-   
-    return StaticMesh;
-}
-
-/////////////////////////////////////////////////////////////////////////////
-
-void ULIB_Export::ConvertProcToStaticMeshAsync(
-    FProcMeshData MeshData,
-    const bool RecalculateNormal,
-    FOnStaticMeshProgress OnProgress,
-    FOnStaticMeshResult OnResult
-)
-{
-    // 공유 리소스 접근이나 GC 충돌 방지를 위해 WeakObjectPtr과 StaticMesh outer 설정 변경
-    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [MeshData = MoveTemp(MeshData), RecalculateNormal, OnProgress, OnResult]() mutable
-        {
-            float Progress = 0.0f;
-            int32 ErrorCode = 0;
-            UStaticMesh* Result = nullptr;
-
-            const int32 TotalSteps = 4;
-            int32 CurrentStep = 0;
-
-            // Step 1: Validate input
-            if (MeshData.Vertices.Num() == 0 || MeshData.Triangles.Num() % 3 != 0)
-            {
-                ErrorCode = -1;
-                AsyncTask(ENamedThreads::GameThread, [OnResult, ErrorCode]()
-                    {
-                        OnResult.ExecuteIfBound(ErrorCode, nullptr);
-                    });
-                return;
-            }
-            ++CurrentStep;
-            Progress = static_cast<float>(CurrentStep) / TotalSteps;
-            AsyncTask(ENamedThreads::GameThread, [OnProgress, Progress]()
-                {
-                    OnProgress.ExecuteIfBound(Progress);
-                });
-
-            // Step 2: Generate UVs if missing
-            if (MeshData.UV0.Num() == 0)
-            {
-                MeshData.UV0.SetNum(MeshData.Vertices.Num());
-                for (int32 i = 0; i < MeshData.Vertices.Num(); ++i)
-                {
-                    const FVector& Vert = MeshData.Vertices[i];
-                    MeshData.UV0[i] = FVector2D(Vert.X, Vert.Y);
-                }
-            }
-            ++CurrentStep;
-            Progress = static_cast<float>(CurrentStep) / TotalSteps;
-            AsyncTask(ENamedThreads::GameThread, [OnProgress, Progress]()
-                {
-                    OnProgress.ExecuteIfBound(Progress);
-                });
-
-            // Step 3: Recalculate normals if requested
-            if (RecalculateNormal)
-            {
-                MeshData.Normals.SetNumZeroed(MeshData.Vertices.Num());
-                for (int32 i = 0; i < MeshData.Triangles.Num(); i += 3)
-                {
-                    const int32 Index0 = MeshData.Triangles[i];
-                    const int32 Index1 = MeshData.Triangles[i + 1];
-                    const int32 Index2 = MeshData.Triangles[i + 2];
-
-                    if (MeshData.Vertices.IsValidIndex(Index0) && MeshData.Vertices.IsValidIndex(Index1) && MeshData.Vertices.IsValidIndex(Index2))
-                    {
-                        const FVector Edge1 = MeshData.Vertices[Index1] - MeshData.Vertices[Index0];
-                        const FVector Edge2 = MeshData.Vertices[Index2] - MeshData.Vertices[Index0];
-                        const FVector Normal = FVector::CrossProduct(Edge2, Edge1).GetSafeNormal();
-
-                        MeshData.Normals[Index0] = Normal;
-                        MeshData.Normals[Index1] = Normal;
-                        MeshData.Normals[Index2] = Normal;
-                    }
-                }
-            }
-            ++CurrentStep;
-            Progress = static_cast<float>(CurrentStep) / TotalSteps;
-            AsyncTask(ENamedThreads::GameThread, [OnProgress, Progress]()
-                {
-                    OnProgress.ExecuteIfBound(Progress);
-                });
-
-            // Step 4: Safe StaticMesh Creation
-            AsyncTask(ENamedThreads::GameThread, [MeshData = MoveTemp(MeshData), RecalculateNormal, OnResult, OnProgress]()
-                {
-                    UStaticMesh* StaticMesh = ULIB_Export::ConvertProcToStaticMesh(MeshData, RecalculateNormal);
-                    const int32 ErrorCode = (StaticMesh != nullptr) ? 0 : -1;
-                    OnProgress.ExecuteIfBound(1.0f);
-                    OnResult.ExecuteIfBound(ErrorCode, StaticMesh);
-                });
-        });
-}
-
-void ULIB_Export::TakeScreenShot(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bAddSuffix, FString& FullFilePath)
-{
-    // 현재 날짜와 시간을 파일 이름에 추가
-    FString CurrentDateTime = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_"));
-    FullFilePath = FilePath + "/" + CurrentDateTime + FileName;
-
-    // 스크린샷 요청
-    FScreenshotRequest::RequestScreenshot(FullFilePath, bCaptureUI, false);
-
-    // 렌더링 명령 대기
-    FlushRenderingCommands();
-}
-
-void ULIB_Export::ConvetFileToTexture(const FString& FullFilePath, UTexture2D*& OutTexture)
-{ // 파일이 저장되었는지 확인
-    if (!FPaths::FileExists(FullFilePath))
-    {
-        UE_LOG(LogTemp, Error, TEXT("Screenshot file was not saved: %s"), *FullFilePath);
-        OutTexture = nullptr;
-        return;
-    }
-
-    // 파일 데이터를 읽어와 텍스처로 변환
-    TArray<uint8> FileData;
-    if (FFileHelper::LoadFileToArray(FileData, *FullFilePath))
-    {
-        // 이미지 데이터를 UTexture2D로 변환
-        IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-        if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
-        {
-            TArray<uint8> RawData;
-            if (ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
-            {
-                // 텍스처 생성
-                OutTexture = UTexture2D::CreateTransient(
-                    ImageWrapper->GetWidth(),
-                    ImageWrapper->GetHeight(),
-                    PF_B8G8R8A8
-                );
-
-                if (OutTexture)
-                {
-                    // 텍스처 데이터 설정
-                    void* TextureData = OutTexture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-                    FMemory::Memcpy(TextureData, RawData.GetData(), RawData.Num());
-                    OutTexture->GetPlatformData()->Mips[0].BulkData.Unlock();
-
-                    // 텍스처 리소스 업데이트
-                    OutTexture->UpdateResource();
-                }
-            }
-            else
-            {
-                UE_LOG(LogTemp, Error, TEXT("Failed to extract raw data from image."));
-                OutTexture = nullptr;
-            }
-        }
-        else
-        {
-            UE_LOG(LogTemp, Error, TEXT("Failed to initialize ImageWrapper or set compressed data."));
-            OutTexture = nullptr;
-        }
-    }
-    else
-    {
-        UE_LOG(LogTemp, Error, TEXT("Failed to load file data from %s"), *FullFilePath);
-        OutTexture = nullptr;
-    }
-}
-
-/////////////////////////////////////////////////////////////////////////////
-
-bool ULIB_Export::SaveStaticMeshToStl(UStaticMesh* StaticMesh, const FString& FilePath)
-{
-    
-    return true;
-}
+#pragma once
+
+#include "LIB_Export.h"
+#include "StaticMeshAttributes.h"
+#include "MeshDescription.h"
+#include "StaticMeshResources.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <fstream>
+#include "GeometryScript/MeshAssetFunctions.h"
+#include "GeometryScript/MeshQueryFunctions.h"
+#include "UObject/UObjectGlobals.h"
+#include "UDynamicMesh.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+
+#include "IImageWrapperModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Components/StaticMeshComponent.h"
+#include "LIB_MeshProcessing.h"
+#include "LIB_ConvertScheduler.h"
+#include "LIB_ConvertCache.h"
+#include "LIB_MeshBuffer.h"
+#include "LIB_MeshFile.h"
+#include "LIB_MeshExport.h"
+#include "LIB_ScreenshotCapture.h"
+#include "LIB_ImageLoader.h"
+#include "LIB_TextureCache.h"
+#include "LIB_ImageBatchLoad.h"
+#include "LIB_IncrementalConvert.h"
+
+UStaticMesh* ULIB_Export::ConvertProcToStaticMesh(FProcMeshData MeshData, const bool RecalculateNormal)
+{
+    FProcMeshConvertOptions Options;
+    Options.bRecalculateNormal = RecalculateNormal;
+    return ConvertProcToStaticMeshWithOptions(MoveTemp(MeshData), Options);
+}
+
+namespace
+{
+    // 아직 StaticMesh 를 쓰는 등록된 컴포넌트만 새 충돌로 물리 상태를 다시 만든다
+    void RecreatePhysicsStates(UStaticMesh* StaticMesh, TConstArrayView<TWeakObjectPtr<UStaticMeshComponent>> Components)
+    {
+        for (const TWeakObjectPtr<UStaticMeshComponent>& WeakComponent : Components)
+        {
+            UStaticMeshComponent* Component = WeakComponent.Get();
+            if (Component && Component->GetStaticMesh() == StaticMesh && Component->IsRegistered())
+            {
+                Component->RecreatePhysicsState();
+            }
+        }
+    }
+
+    /**
+     * 캐시 조회 -> 전처리 -> MeshDescription 생성 -> 스태틱 메시 빌드의 공통 흐름.
+     * Prepare 는 Source 를 전처리한 뒤 MeshDescription 을 만들 버퍼를 OutView 로 돌려준다.
+     */
+    template<typename ViewType>
+    UStaticMesh* ConvertWithCache(const ViewType& Source, const FProcMeshConvertOptions& Options, TFunctionRef<bool(ViewType&)> Prepare)
+    {
+        // 0. 캐시 조회 (메모리에 살아 있는 결과가 있으면 그대로 반환)
+        FProcMeshConvertCache& Cache = FProcMeshConvertCache::Get();
+        const uint64 CacheKey = Options.bUseCache ? FProcMeshConvertCache::ComputeKey(Source, Options) : 0;
+        if (Options.bUseCache)
+        {
+            if (UStaticMesh* CachedMesh = Cache.FindMesh(CacheKey))
+                return CachedMesh;
+        }
+
+        TArray<FMeshDescription> MeshDescs;
+        const bool bUseDiskCache = Options.bUseCache && Options.bUseDiskCache;
+        if (!bUseDiskCache || !Cache.LoadMeshDescriptions(CacheKey, MeshDescs))
+        {
+            // 1. 유효성 검사 및 UV/법선 생성
+            ViewType Prepared;
+            if (!Prepare(Prepared))
+                return nullptr;
+
+            // 2. 정점, 정점 인스턴스, 삼각형 생성 (LOD 를 쓰면 단순화한 LOD 까지)
+            LIB_MeshProcessing::BuildLODMeshDescriptions(Prepared, Options, MeshDescs);
+            if (bUseDiskCache)
+                Cache.SaveMeshDescriptions(CacheKey, MeshDescs);
+        }
+
+        // 3. 스태틱 메시 빌드
+        TArray<float> TriangleRatios;
+        TArray<float> ScreenSizes;
+        LIB_MeshProcessing::GetLODSettings(Options, TriangleRatios, ScreenSizes);
+        UStaticMesh* StaticMesh = ULIB_Export::BuildStaticMeshFromDescriptions(MeshDescs, ScreenSizes);
+        if (Options.bUseCache)
+            Cache.AddMesh(CacheKey, StaticMesh);
+
+        // 4. 충돌 (껍질 계산은 이 스레드에서, 쿠킹은 비동기로 끝난 뒤 물리 상태에 반영)
+        if (StaticMesh && Options.CollisionMode != EProcCollisionMode::None)
+        {
+            TArray<TArray<FVector3f>> CollisionHulls;
+            LIB_MeshProcessing::BuildCollisionHulls(MeshDescs[0], Options, CollisionHulls);
+            ULIB_Export::BuildCollisionAsync(StaticMesh, Options.CollisionMode, MoveTemp(CollisionHulls));
+        }
+        return StaticMesh;
+    }
+
+    ULIB_ConvertHandle* SubmitConvertJob(
+        const TSharedRef<FProcMeshConvertJob, ESPMode::ThreadSafe>& Job,
+        const ULIB_Export::FOnStaticMeshProgress& OnProgress,
+        const ULIB_Export::FOnStaticMeshResult& OnResult)
+    {
+        Job->OnProgress = [OnProgress](float Progress)
+        {
+            OnProgress.ExecuteIfBound(Progress);
+        };
+        Job->OnComplete = [OnProgress, OnResult](int32 ErrorCode, UStaticMesh* StaticMesh)
+        {
+            if (ErrorCode == 0)
+            {
+                OnProgress.ExecuteIfBound(1.0f);
+            }
+            OnResult.ExecuteIfBound(ErrorCode, StaticMesh);
+        };
+
+        // 핸들이 GC 되었으면 알릴 곳이 없으므로 약한 참조로 둔다
+        ULIB_ConvertHandle* Handle = NewObject<ULIB_ConvertHandle>();
+        TWeakObjectPtr<ULIB_ConvertHandle> WeakHandle = Handle;
+        Job->OnCollisionReady = [WeakHandle](UStaticMesh* StaticMesh, bool bSuccess)
+        {
+            if (ULIB_ConvertHandle* PinnedHandle = WeakHandle.Get())
+            {
+                RecreatePhysicsStates(StaticMesh, PinnedHandle->CollisionTargets);
+                PinnedHandle->OnCollisionReady.Broadcast(StaticMesh, bSuccess);
+            }
+        };
+        Handle->Job = Job;
+        FProcMeshConvertScheduler::Get().Submit(Job);
+        return Handle;
+    }
+}
+
+UStaticMesh* ULIB_Export::ConvertProcToStaticMeshWithOptions(FProcMeshData MeshData, const FProcMeshConvertOptions& Options)
+{
+    // 값으로 받은 입력은 이미 소유하고 있으므로 제자리에서 전처리한다
+    return ConvertWithCache<FProcMeshDataView>(MeshData, Options, [&MeshData, &Options](FProcMeshDataView& OutView)
+        {
+            if (!LIB_MeshProcessing::PrepareMeshData(MeshData, Options))
+                return false;
+            OutView = MeshData;
+            return true;
+        });
+}
+
+UStaticMesh* ULIB_Export::ConvertProcToStaticMesh(const FProcMeshDataView& MeshView, const FProcMeshConvertOptions& Options)
+{
+    // 원본은 그대로 두고 새로 만든 버퍼만 Scratch 에 둔다
+    FProcMeshData Scratch;
+    return ConvertWithCache<FProcMeshDataView>(MeshView, Options, [&MeshView, &Options, &Scratch](FProcMeshDataView& OutView)
+        {
+            return LIB_MeshProcessing::PrepareMeshView(MeshView, Options, Scratch, OutView);
+        });
+}
+
+UStaticMesh* ULIB_Export::ConvertProcToStaticMesh(const FProcMeshBuffer& MeshBuffer, const FProcMeshConvertOptions& Options)
+{
+    return ConvertProcToStaticMesh(FProcMeshBufferView(MeshBuffer), Options);
+}
+
+UStaticMesh* ULIB_Export::ConvertProcToStaticMesh(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options)
+{
+    // 원본은 그대로 두고 새로 만든 성분 배열만 Scratch 에 둔다
+    FProcMeshBuffer Scratch;
+    return ConvertWithCache<FProcMeshBufferView>(MeshBuffer, Options, [&MeshBuffer, &Options, &Scratch](FProcMeshBufferView& OutView)
+        {
+            return LIB_MeshProcessing::PrepareMeshView(MeshBuffer, Options, Scratch, OutView);
+        });
+}
+
+bool ULIB_Export::SaveProcMeshDataToFile(const FProcMeshData& MeshData, const FString& FilePath, bool bCompress)
+{
+    return FProcMeshFile::Save(FilePath, FProcMeshDataView(MeshData), bCompress);
+}
+
+bool ULIB_Export::LoadProcMeshDataFromFile(const FString& FilePath, FProcMeshData& OutMeshData)
+{
+    const TSharedPtr<const FProcMeshFile, ESPMode::ThreadSafe> File = FProcMeshFile::Load(FilePath);
+    if (!File.IsValid())
+        return false;
+
+    // 블루프린트용 복사본. 변환만 할 거라면 ConvertProcMeshFileToStaticMesh 가 복사 없이 읽는다.
+    if (File->IsBuffer())
+    {
+        FProcMeshBuffer Buffer;
+        Buffer.CopyFrom(File->GetMeshBuffer());
+        OutMeshData = Buffer.ToMeshData();
+    }
+    else
+    {
+        OutMeshData = File->GetMeshData().ToMeshData();
+    }
+    return true;
+}
+
+UStaticMesh* ULIB_Export::ConvertProcMeshFileToStaticMesh(const FString& FilePath, const FProcMeshConvertOptions& Options)
+{
+    // 매핑된 파일의 스트림을 그대로 뷰로 넘긴다
+    const TSharedPtr<const FProcMeshFile, ESPMode::ThreadSafe> File = FProcMeshFile::Load(FilePath);
+    if (!File.IsValid())
+        return nullptr;
+
+    return File->IsBuffer()
+        ? ConvertProcToStaticMesh(File->GetMeshBuffer(), Options)
+        : ConvertProcToStaticMesh(File->GetMeshData(), Options);
+}
+
+UStaticMesh* ULIB_Export::BuildStaticMeshFromDescription(const FMeshDescription& MeshDesc)
+{
+    return BuildStaticMeshFromDescriptions(MakeArrayView(&MeshDesc, 1), {});
+}
+
+UStaticMesh* ULIB_Export::BuildStaticMeshFromDescriptions(TConstArrayView<FMeshDescription> LODMeshDescs, TConstArrayView<float> LODScreenSizes)
+{
+    check(IsInGameThread());
+    if (LODMeshDescs.Num() == 0)
+        return nullptr;
+
+    // 1. 스태틱 메시 생성
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+
+    // 중요: 렌더 리소스를 올바르게 초기화
+    StaticMesh->ReleaseResources();  // 기존 리소스 제거
+    StaticMesh->InitResources();     // 새 리소스 초기화
+
+    // 2. 메시 빌드 설정
+    StaticMesh->CreateBodySetup();
+
+    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+    BuildParams.bBuildSimpleCollision = false;
+    BuildParams.bFastBuild = true;
+    StaticMesh->bAllowCPUAccess = true;
+
+    // 섹션(폴리곤 그룹)이 여러 개여도 모두 머티리얼 0 번을 쓰도록 슬롯을 하나 등록한다
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, LIB_MeshProcessing::GetMaterialSlotName(), LIB_MeshProcessing::GetMaterialSlotName()));
+
+    TArray<const FMeshDescription*> MeshDescPtrs;
+    for (const FMeshDescription& MeshDesc : LODMeshDescs)
+    {
+        MeshDescPtrs.Add(&MeshDesc);
+    }
+    StaticMesh->BuildFromMeshDescriptions(MeshDescPtrs, BuildParams);
+
+    // 3. LOD 전환 화면 크기 (런타임 빌드는 소스 모델 설정을 거치지 않으므로 렌더 데이터에 직접 설정)
+    FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    if (RenderData && LODScreenSizes.Num() == LODMeshDescs.Num())
+    {
+        for (int32 LODIndex = 0; LODIndex < LODScreenSizes.Num() && LODIndex < MAX_STATIC_MESH_LODS; ++LODIndex)
+        {
+            RenderData->ScreenSize[LODIndex].Default = LODScreenSizes[LODIndex];
+        }
+    }
+    StaticMesh->InitResources();
+
+    return StaticMesh;
+}
+
+void ULIB_Export::BuildCollisionAsync(UStaticMesh* StaticMesh, EProcCollisionMode CollisionMode, TArray<TArray<FVector3f>>&& ConvexHulls, TArray<TWeakObjectPtr<UStaticMeshComponent>> Components, TFunction<void(UStaticMesh*, bool)> OnReady)
+{
+    check(IsInGameThread());
+    if (!IsValid(StaticMesh) || CollisionMode == EProcCollisionMode::None)
+        return;
+
+    // 1. 단순 충돌 구성 (볼록 껍질은 점 집합만 넘기고 실제 껍질은 쿠킹에서 만든다)
+    UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+    if (!BodySetup)
+    {
+        StaticMesh->CreateBodySetup();
+        BodySetup = StaticMesh->GetBodySetup();
+    }
+    BodySetup->RemoveSimpleCollision();
+
+    if (CollisionMode == EProcCollisionMode::ComplexAsSimple)
+    {
+        // 삼각형 메시는 bAllowCPUAccess 로 유지된 LOD0 렌더 데이터에서 가져온다
+        BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+    }
+    else
+    {
+        // 복잡 충돌 질의도 껍질로 처리하여 삼각형 메시 쿠킹을 건너뛴다
+        BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+        for (const TArray<FVector3f>& Hull : ConvexHulls)
+        {
+            FKConvexElem& ConvexElem = BodySetup->AggGeom.ConvexElems.AddDefaulted_GetRef();
+            ConvexElem.VertexData.Reserve(Hull.Num());
+            for (const FVector3f& Point : Hull)
+            {
+                ConvexElem.VertexData.Add(FVector(Point));
+            }
+            ConvexElem.UpdateElemBox();
+        }
+        if (BodySetup->AggGeom.ConvexElems.Num() == 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("BuildCollisionAsync: no convex hull for %s."), *StaticMesh->GetName());
+        }
+    }
+
+    // 2. 쿠킹은 백그라운드에서, 완료 콜백은 게임 스레드에서 불린다
+    BodySetup->InvalidatePhysicsData();
+    TWeakObjectPtr<UStaticMesh> WeakMesh = StaticMesh;
+    BodySetup->CreatePhysicsMeshesAsync(FOnAsyncPhysicsCookFinished::CreateLambda([WeakMesh, Components = MoveTemp(Components), OnReady](bool bSuccess)
+        {
+            UStaticMesh* CookedMesh = WeakMesh.Get();
+            if (!CookedMesh)
+                return;
+            if (!bSuccess)
+            {
+                UE_LOG(LogTemp, Error, TEXT("BuildCollisionAsync: failed to cook collision for %s."), *CookedMesh->GetName());
+            }
+
+            // 3. 쿠킹 전에 이 메시로 물리 상태를 만든 요청 컴포넌트는 새 충돌로 다시 만든다
+            RecreatePhysicsStates(CookedMesh, Components);
+            if (OnReady)
+            {
+                OnReady(CookedMesh, bSuccess);
+            }
+        }));
+}
+
+void ULIB_Export::SetAsyncConvertFrameBudget(float BudgetMs)
+{
+    FProcMeshFinalizeQueue::Get().SetFrameBudgetMs(BudgetMs);
+}
+
+void ULIB_Export::SetConvertCacheCapacity(int32 MaxEntries)
+{
+    FProcMeshConvertCache::Get().SetCapacity(MaxEntries);
+}
+
+void ULIB_Export::ClearConvertCache(bool bIncludeDiskCache)
+{
+    FProcMeshConvertCache::Get().Clear(bIncludeDiskCache);
+}
+
+void ULIB_Export::SetConvertDiskCacheBudget(int32 MaxMegabytes)
+{
+    FProcMeshConvertCache::Get().SetDiskBudget(static_cast<int64>(FMath::Max(MaxMegabytes, 0)) * 1024 * 1024);
+}
+
+FProcMeshRepairStats ULIB_Export::RepairProcMeshData(FProcMeshData& MeshData, float WeldThreshold)
+{
+    return LIB_MeshProcessing::RepairMesh(MeshData, FMath::Max(WeldThreshold, 0.0f));
+}
+
+FProcMeshVertexCacheStats ULIB_Export::OptimizeProcMeshIndices(FProcMeshData& MeshData)
+{
+    return LIB_MeshProcessing::OptimizeVertexOrder(MeshData);
+}
+
+ULIB_IncrementalConverter* ULIB_Export::CreateIncrementalConverter(FProcMeshData MeshData, const FProcMeshConvertOptions& Options)
+{
+    TSharedPtr<FProcMeshIncrementalState> State = MakeShared<FProcMeshIncrementalState>();
+    if (!State->Initialize(MoveTemp(MeshData), Options))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CreateIncrementalConverter: invalid mesh data."));
+        return nullptr;
+    }
+
+    // 첫 Rebuild 는 모든 구간을 빌드한다
+    ULIB_IncrementalConverter* Converter = NewObject<ULIB_IncrementalConverter>();
+    Converter->State = State;
+    Converter->Rebuild();
+    return Converter;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+ULIB_ConvertHandle* ULIB_Export::ConvertProcToStaticMeshAsync(
+    FProcMeshData MeshData,
+    const bool RecalculateNormal,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshResult OnResult
+)
+{
+    FProcMeshConvertOptions Options;
+    Options.bRecalculateNormal = RecalculateNormal;
+    return ConvertProcToStaticMeshAsyncWithOptions(MoveTemp(MeshData), Options, OnProgress, OnResult);
+}
+
+ULIB_ConvertHandle* ULIB_Export::ConvertProcToStaticMeshAsyncWithOptions(
+    FProcMeshData MeshData,
+    const FProcMeshConvertOptions& Options,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshResult OnResult,
+    FName SlotKey,
+    int32 Priority
+)
+{
+    // 전처리와 MeshDescription 생성은 스케줄러 워커에서, 스태틱 메시 빌드는 게임 스레드 마무리 대기열에서 진행된다
+    return SubmitConvertJob(MakeShared<FProcMeshConvertJob, ESPMode::ThreadSafe>(MoveTemp(MeshData), Options, SlotKey, Priority), OnProgress, OnResult);
+}
+
+ULIB_ConvertHandle* ULIB_Export::ConvertProcToStaticMeshAsync(
+    const TSharedRef<const FProcMeshData, ESPMode::ThreadSafe>& MeshData,
+    const FProcMeshConvertOptions& Options,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshResult OnResult,
+    FName SlotKey,
+    int32 Priority
+)
+{
+    return SubmitConvertJob(MakeShared<FProcMeshConvertJob, ESPMode::ThreadSafe>(MeshData, Options, SlotKey, Priority), OnProgress, OnResult);
+}
+
+ULIB_ConvertHandle* ULIB_Export::ConvertProcToStaticMeshAsync(
+    const TSharedRef<const FProcMeshBuffer, ESPMode::ThreadSafe>& MeshBuffer,
+    const FProcMeshConvertOptions& Options,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshResult OnResult,
+    FName SlotKey,
+    int32 Priority
+)
+{
+    return SubmitConvertJob(MakeShared<FProcMeshConvertJob, ESPMode::ThreadSafe>(MeshBuffer, Options, SlotKey, Priority), OnProgress, OnResult);
+}
+
+ULIB_ConvertHandle* ULIB_Export::ConvertProcMeshFileToStaticMeshAsync(
+    const FString& FilePath,
+    const FProcMeshConvertOptions& Options,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshResult OnResult,
+    FName SlotKey,
+    int32 Priority
+)
+{
+    // 파일 매핑과 체크섬 확인까지 워커에서 진행된다
+    return SubmitConvertJob(MakeShared<FProcMeshConvertJob, ESPMode::ThreadSafe>(FilePath, Options, SlotKey, Priority), OnProgress, OnResult);
+}
+
+void ULIB_Export::ConvertProcToStaticMeshBatchAsync(
+    TArray<FProcMeshData> MeshDatas,
+    const FProcMeshConvertOptions& Options,
+    int32 MaxWorkers,
+    FOnStaticMeshProgress OnProgress,
+    FOnStaticMeshBatchItem OnItemResult,
+    FOnStaticMeshBatchResult OnBatchResult
+)
+{
+    TSharedRef<FProcMeshConvertBatch, ESPMode::ThreadSafe> Batch = MakeShared<FProcMeshConvertBatch, ESPMode::ThreadSafe>(
+        MoveTemp(MeshDatas), Options, OnProgress, OnItemResult, OnBatchResult);
+    Batch->Start(MaxWorkers);
+}
+
+void ULIB_Export::TakeScreenShot(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bAddSuffix, FString& FullFilePath)
+{
+    // 현재 날짜와 시간을 파일 이름에 추가
+    FString CurrentDateTime = FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_"));
+    FullFilePath = FilePath + "/" + CurrentDateTime + FileName;
+
+    // 스크린샷 요청
+    FScreenshotRequest::RequestScreenshot(FullFilePath, bCaptureUI, false);
+
+    // 렌더링 명령 대기
+    FlushRenderingCommands();
+}
+
+void ULIB_Export::TakeScreenShotAsync(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bSaveToFile, bool bCreateTexture, FOnScreenShotCaptured OnCaptured)
+{
+    // 저장 경로는 TakeScreenShot 과 같은 규칙 (확장자가 없으면 PNG)
+    FString FullFilePath;
+    if (bSaveToFile)
+    {
+        FullFilePath = FilePath + "/" + FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_")) + FileName;
+        if (FPaths::GetExtension(FullFilePath).IsEmpty())
+        {
+            FullFilePath += TEXT(".png");
+        }
+    }
+
+    const bool bStarted = FScreenshotCapture::Start(bCaptureUI, FullFilePath,
+        [OnCaptured, bCreateTexture](int32 ErrorCode, const FString& SavedFilePath, int32 Width, int32 Height, TArray<FColor>&& Pixels)
+        {
+            UTexture2D* Texture = nullptr;
+            if (ErrorCode == 0 && bCreateTexture)
+            {
+                FDecodedImage Image;
+                Image.Width = Width;
+                Image.Height = Height;
+                Image.PixelFormat = PF_B8G8R8A8;
+                Image.Mips.AddDefaulted_GetRef().Append(reinterpret_cast<const uint8*>(Pixels.GetData()), Pixels.Num() * sizeof(FColor));
+                Texture = LIB_ImageLoader::CreateTexture(Image);
+            }
+            OnCaptured.ExecuteIfBound(ErrorCode, SavedFilePath, Texture);
+        });
+    if (!bStarted)
+    {
+        OnCaptured.ExecuteIfBound(FScreenshotCapture::ErrorCode_Failed, FString(), nullptr);
+    }
+}
+
+void ULIB_Export::ConvetFileToTexture(const FString& FullFilePath, UTexture2D*& OutTexture)
+{ // 파일이 저장되었는지 확인
+    OutTexture = nullptr;
+    if (!FPaths::FileExists(FullFilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Screenshot file was not saved: %s"), *FullFilePath);
+        return;
+    }
+
+    // 파일이 바뀌지 않았다면 캐시된 텍스처, 아니면 헤더로 형식을 판별해 디코드한 뒤 텍스처로 변환
+    OutTexture = FTextureCache::Get().Load(FullFilePath, false);
+}
+
+void ULIB_Export::ConvetFileToTextureAsync(const FString& FullFilePath, bool bGenerateMips, FOnTextureLoaded OnLoaded)
+{
+    if (!FPaths::FileExists(FullFilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ConvetFileToTextureAsync: file does not exist: %s"), *FullFilePath);
+        OnLoaded.ExecuteIfBound(-1, nullptr);
+        return;
+    }
+
+    FTextureCache::Get().LoadAsync(FullFilePath, bGenerateMips, [OnLoaded](UTexture2D* Texture)
+        {
+            OnLoaded.ExecuteIfBound(Texture ? 0 : -1, Texture);
+        });
+}
+
+void ULIB_Export::ConvetFilesToTexturesAsync(
+    TArray<FString> FullFilePaths,
+    bool bGenerateMips,
+    int32 MaxWorkers,
+    int32 MaxInFlightMegabytes,
+    int32 UploadMegabytesPerFrame,
+    FOnTextureProgress OnProgress,
+    FOnTextureBatchItem OnItemLoaded,
+    FOnTextureBatchResult OnBatchResult
+)
+{
+    TSharedRef<FImageBatchLoad, ESPMode::ThreadSafe> Batch = MakeShared<FImageBatchLoad, ESPMode::ThreadSafe>(
+        MoveTemp(FullFilePaths), bGenerateMips, OnProgress, OnItemLoaded, OnBatchResult);
+    Batch->Start(MaxWorkers, static_cast<int64>(MaxInFlightMegabytes) * 1024 * 1024, static_cast<int64>(UploadMegabytesPerFrame) * 1024 * 1024);
+}
+
+void ULIB_Export::SetTextureCacheBudget(int32 MaxMegabytes)
+{
+    FTextureCache::Get().SetBudget(static_cast<int64>(FMath::Max(MaxMegabytes, 0)) * 1024 * 1024);
+}
+
+void ULIB_Export::ClearTextureCache()
+{
+    FTextureCache::Get().Clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void ULIB_ConvertHandle::Cancel()
+{
+    if (Job.IsValid())
+    {
+        Job->Cancel();
+    }
+}
+
+void ULIB_ConvertHandle::SetPriority(int32 NewPriority)
+{
+    if (Job.IsValid())
+    {
+        Job->SetPriority(NewPriority);
+    }
+}
+
+int32 ULIB_ConvertHandle::GetPriority() const
+{
+    return Job.IsValid() ? Job->GetPriority() : 0;
+}
+
+EProcConvertState ULIB_ConvertHandle::GetState() const
+{
+    return Job.IsValid() ? Job->GetState() : EProcConvertState::Failed;
+}
+
+FProcMeshRepairStats ULIB_ConvertHandle::GetRepairStats() const
+{
+    // 워커가 쓰는 값이므로 전처리가 끝난 뒤에만 읽는다
+    const EProcConvertState State = GetState();
+    const bool bPrepared = State == EProcConvertState::Finalizing || State == EProcConvertState::Completed || State == EProcConvertState::Failed;
+    return (Job.IsValid() && bPrepared) ? Job->RepairStats : FProcMeshRepairStats();
+}
+
+FProcMeshVertexCacheStats ULIB_ConvertHandle::GetVertexCacheStats() const
+{
+    const EProcConvertState State = GetState();
+    const bool bPrepared = State == EProcConvertState::Finalizing || State == EProcConvertState::Completed || State == EProcConvertState::Failed;
+    return (Job.IsValid() && bPrepared) ? Job->VertexCacheStats : FProcMeshVertexCacheStats();
+}
+
+void ULIB_ConvertHandle::AddCollisionTarget(UStaticMeshComponent* Component)
+{
+    if (IsValid(Component))
+    {
+        CollisionTargets.AddUnique(Component);
+    }
+}
+
+FProcMeshConvertTimings ULIB_ConvertHandle::GetTimings() const
+{
+    // 취소된 작업은 워커가 아직 기록 중일 수 있다
+    const EProcConvertState State = GetState();
+    const bool bFinished = State == EProcConvertState::Completed || State == EProcConvertState::Failed;
+    return (Job.IsValid() && bFinished) ? Job->Timings : FProcMeshConvertTimings();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void ULIB_IncrementalConverter::UpdateVertices(int32 FirstVertex, const TArray<FVector>& Vertices)
+{
+    if (!State.IsValid())
+        return;
+
+    TArray<FVector>& Dest = State->GetMutableMeshData().Vertices;
+    const int32 Begin = FMath::Max(FirstVertex, 0);
+    const int32 End = FMath::Min(FirstVertex + Vertices.Num(), Dest.Num());
+    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+    {
+        Dest[Vertex] = Vertices[Vertex - FirstVertex];
+    }
+    State->MarkVerticesDirty(Begin, End - Begin);
+}
+
+void ULIB_IncrementalConverter::UpdateVertexColors(int32 FirstVertex, const TArray<FLinearColor>& VertexColors)
+{
+    if (!State.IsValid())
+        return;
+
+    TArray<FLinearColor>& Dest = State->GetMutableMeshData().VertexColors;
+    const int32 Begin = FMath::Max(FirstVertex, 0);
+    const int32 End = FMath::Min(FirstVertex + VertexColors.Num(), Dest.Num());
+    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+    {
+        Dest[Vertex] = VertexColors[Vertex - FirstVertex];
+    }
+    State->MarkVerticesDirty(Begin, End - Begin);
+}
+
+void ULIB_IncrementalConverter::UpdateTriangles(int32 FirstTriangle, const TArray<int32>& Indices)
+{
+    if (!State.IsValid())
+        return;
+    if (Indices.Num() % 3 != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UpdateTriangles: index count must be a multiple of 3."));
+        return;
+    }
+
+    TArray<int32>& Dest = State->GetMutableMeshData().Triangles;
+    const int32 Begin = FMath::Max(FirstTriangle, 0);
+    const int32 End = FMath::Min(FirstTriangle + Indices.Num() / 3, Dest.Num() / 3);
+    for (int32 Triangle = Begin; Triangle < End; ++Triangle)
+    {
+        FMemory::Memcpy(&Dest[Triangle * 3], &Indices[(Triangle - FirstTriangle) * 3], 3 * sizeof(int32));
+    }
+    State->MarkTrianglesDirty(Begin, End - Begin);
+}
+
+void ULIB_IncrementalConverter::MarkVerticesDirty(int32 FirstVertex, int32 NumVertices)
+{
+    if (State.IsValid())
+    {
+        State->MarkVerticesDirty(FirstVertex, NumVertices);
+    }
+}
+
+void ULIB_IncrementalConverter::MarkTrianglesDirty(int32 FirstTriangle, int32 NumTriangles)
+{
+    if (State.IsValid())
+    {
+        State->MarkTrianglesDirty(FirstTriangle, NumTriangles);
+    }
+}
+
+TArray<int32> ULIB_IncrementalConverter::Rebuild()
+{
+    check(IsInGameThread());
+
+    TArray<int32> Sections;
+    if (!State.IsValid() || !State->IsDirty())
+        return Sections;
+
+    // 1. 법선 갱신과 구간 MeshDescription 생성 (병렬)
+    TArray<FMeshDescription> MeshDescs;
+    if (!State->BuildDirtySections(Sections, MeshDescs))
+        return Sections;
+
+    // 2. 바뀐 구간만 스태틱 메시로 빌드하여 교체
+    const FProcMeshConvertOptions& Options = State->GetSectionOptions();
+    SectionMeshes.SetNum(State->NumSections());
+    for (int32 i = 0; i < Sections.Num(); ++i)
+    {
+        UStaticMesh* StaticMesh = MeshDescs[i].Triangles().Num() > 0 ? ULIB_Export::BuildStaticMeshFromDescription(MeshDescs[i]) : nullptr;
+        UStaticMeshComponent* Component = SectionComponents.IsValidIndex(Sections[i]) ? SectionComponents[Sections[i]].Get() : nullptr;
+        if (Component)
+        {
+            Component->SetStaticMesh(StaticMesh);
+        }
+        if (StaticMesh && Options.CollisionMode != EProcCollisionMode::None)
+        {
+            TArray<TWeakObjectPtr<UStaticMeshComponent>> Components;
+            if (Component)
+            {
+                Components.Add(Component);
+            }
+            TArray<TArray<FVector3f>> CollisionHulls;
+            LIB_MeshProcessing::BuildCollisionHulls(MeshDescs[i], Options, CollisionHulls);
+            ULIB_Export::BuildCollisionAsync(StaticMesh, Options.CollisionMode, MoveTemp(CollisionHulls), MoveTemp(Components));
+        }
+        SectionMeshes[Sections[i]] = StaticMesh;
+    }
+    return Sections;
+}
+
+void ULIB_IncrementalConverter::SetSectionComponent(int32 SectionIndex, UStaticMeshComponent* Component)
+{
+    if (SectionIndex < 0 || SectionIndex >= GetNumSections())
+        return;
+
+    SectionComponents.SetNum(GetNumSections());
+    SectionComponents[SectionIndex] = Component;
+    if (IsValid(Component))
+    {
+        Component->SetStaticMesh(SectionMeshes[SectionIndex]);
+    }
+}
+
+UStaticMesh* ULIB_IncrementalConverter::GetSectionMesh(int32 SectionIndex) const
+{
+    return SectionMeshes.IsValidIndex(SectionIndex) ? SectionMeshes[SectionIndex].Get() : nullptr;
+}
+
+TArray<UStaticMesh*> ULIB_IncrementalConverter::GetSectionMeshes() const
+{
+    TArray<UStaticMesh*> StaticMeshes;
+    StaticMeshes.Reserve(SectionMeshes.Num());
+    for (const TObjectPtr<UStaticMesh>& StaticMesh : SectionMeshes)
+    {
+        StaticMeshes.Add(StaticMesh.Get());
+    }
+    return StaticMeshes;
+}
+
+FProcMeshData& ULIB_IncrementalConverter::GetMutableMeshData()
+{
+    check(State.IsValid());
+    return State->GetMutableMeshData();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool ULIB_Export::SaveStaticMeshToStl(UStaticMesh* StaticMesh, const FString& FilePath)
+{
+    // 바이너리 STL 레코드: 법선(12) + 정점 3개(36) + 속성(2) = 50바이트
+    static_assert(PLATFORM_LITTLE_ENDIAN, "Binary STL is little-endian");
+    constexpr int32 StlHeaderSize = 80;
+    constexpr int32 StlRecordSize = 50;
+    constexpr int32 TrianglesPerBlock = 4096;      // ParallelFor 작업 단위
+    constexpr int32 TrianglesPerChunk = 1 << 16;   // 버퍼 하나당 삼각형 수 (약 3.2MB)
+
+    // 1. 유효성 검사
+    if (!IsValid(StaticMesh) || FilePath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: invalid static mesh or file path."));
+        return false;
+    }
+
+    const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    if (!RenderData || RenderData->LODResources.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: %s has no render data."), *StaticMesh->GetName());
+        return false;
+    }
+
+    // bAllowCPUAccess 로 유지된 LOD0 렌더 데이터를 복사 없이 그대로 읽는다
+    const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+    const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+    const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+    if (Positions.GetNumVertices() == 0 || Positions.GetVertexData() == nullptr || Indices.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: LOD0 of %s has no CPU-accessible geometry (bAllowCPUAccess?)."), *StaticMesh->GetName());
+        return false;
+    }
+
+    // 2. 섹션 범위 수집 (인덱스 버퍼 전체가 아닌 실제 그려지는 삼각형만 기록)
+    struct FTriangleRange
+    {
+        uint32 FirstIndex;
+        uint32 NumTriangles;
+    };
+    TArray<FTriangleRange> Ranges;
+    uint64 TotalTriangles = 0;
+    for (const FStaticMeshSection& Section : LOD.Sections)
+    {
+        const uint32 MaxTriangles = (static_cast<uint32>(Indices.Num()) - FMath::Min<uint32>(Section.FirstIndex, Indices.Num())) / 3;
+        const uint32 NumTriangles = FMath::Min(Section.NumTriangles, MaxTriangles);
+        if (NumTriangles > 0)
+        {
+            Ranges.Add({ Section.FirstIndex, NumTriangles });
+            TotalTriangles += NumTriangles;
+        }
+    }
+    if (TotalTriangles == 0 || TotalTriangles > MAX_uint32)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: unsupported triangle count %llu."), TotalTriangles);
+        return false;
+    }
+
+    // 3. 파일 열기
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FilePath));
+    if (!FileHandle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: failed to open %s for writing."), *FilePath);
+        return false;
+    }
+
+    uint8 Header[StlHeaderSize + sizeof(uint32)] = {};
+    const ANSICHAR HeaderText[] = "Binary STL exported by LIB_Export";
+    FMemory::Memcpy(Header, HeaderText, sizeof(HeaderText) - 1);
+    const uint32 TriangleCount = static_cast<uint32>(TotalTriangles);
+    FMemory::Memcpy(Header + StlHeaderSize, &TriangleCount, sizeof(uint32));
+    bool bSuccess = FileHandle->Write(Header, sizeof(Header));
+
+    // 4. 레코드 생성 및 기록
+    // 버퍼 두 개를 번갈아 사용: 한쪽을 디스크에 쓰는 동안 다른 쪽을 병렬로 채운다
+    TArray<uint8> Buffers[2];
+    Buffers[0].SetNumUninitialized(TrianglesPerChunk * StlRecordSize);
+    Buffers[1].SetNumUninitialized(TrianglesPerChunk * StlRecordSize);
+    TFuture<bool> PendingWrite;
+    int32 BufferIndex = 0;
+
+    auto FillRecords = [&Positions, &Indices](uint8* Dest, uint32 FirstIndex, int32 NumTriangles)
+    {
+        const int32 NumBlocks = FMath::DivideAndRoundUp(NumTriangles, TrianglesPerBlock);
+        ParallelFor(NumBlocks, [&Positions, &Indices, Dest, FirstIndex, NumTriangles](int32 BlockIndex)
+            {
+                const int32 Begin = BlockIndex * TrianglesPerBlock;
+                const int32 End = FMath::Min(Begin + TrianglesPerBlock, NumTriangles);
+                for (int32 Tri = Begin; Tri < End; ++Tri)
+                {
+                    const uint32 Base = FirstIndex + Tri * 3;
+                    // UE 좌표계(왼손)를 STL 관례(오른손)로 변환하기 위해 Y축 반전
+                    FVector3f V[3];
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const FVector3f& P = Positions.VertexPosition(Indices[Base + Corner]);
+                        V[Corner] = FVector3f(P.X, -P.Y, P.Z);
+                    }
+                    const FVector3f Normal = FVector3f::CrossProduct(V[1] - V[0], V[2] - V[0]).GetSafeNormal();
+
+                    uint8* Record = Dest + static_cast<int64>(Tri) * StlRecordSize;
+                    FMemory::Memcpy(Record, &Normal, sizeof(FVector3f));
+                    FMemory::Memcpy(Record + 12, V, sizeof(V));
+                    Record[48] = 0;
+                    Record[49] = 0;
+                }
+            });
+    };
+
+    for (const FTriangleRange& Range : Ranges)
+    {
+        for (uint32 Offset = 0; bSuccess && Offset < Range.NumTriangles; Offset += TrianglesPerChunk)
+        {
+            const int32 NumTriangles = static_cast<int32>(FMath::Min<uint32>(TrianglesPerChunk, Range.NumTriangles - Offset));
+            TArray<uint8>& Buffer = Buffers[BufferIndex];
+            FillRecords(Buffer.GetData(), Range.FirstIndex + Offset * 3, NumTriangles);
+
+            // 이전 버퍼 쓰기가 끝나야 다음 쓰기를 시작할 수 있다
+            if (PendingWrite.IsValid())
+            {
+                bSuccess = PendingWrite.Get();
+            }
+            if (bSuccess)
+            {
+                IFileHandle* Handle = FileHandle.Get();
+                const uint8* Data = Buffer.GetData();
+                const int64 Size = static_cast<int64>(NumTriangles) * StlRecordSize;
+                PendingWrite = Async(EAsyncExecution::ThreadPool, [Handle, Data, Size]()
+                    {
+                        return Handle->Write(Data, Size);
+                    });
+            }
+            BufferIndex ^= 1;
+        }
+    }
+    if (PendingWrite.IsValid())
+    {
+        bSuccess = PendingWrite.Get() && bSuccess;
+    }
+
+    bSuccess = bSuccess && FileHandle->Flush();
+    FileHandle.Reset();
+
+    if (!bSuccess)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SaveStaticMeshToStl: failed while writing %s."), *FilePath);
+        PlatformFile.DeleteFile(*FilePath);
+        return false;
+    }
+    return true;
+}
+
+bool ULIB_Export::ExportStaticMesh(UStaticMesh* StaticMesh, const FString& FilePath, EProcMeshExportFormat Format, int32 LODIndex)
+{
+    if (!IsValid(StaticMesh) || FilePath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ExportStaticMesh: invalid static mesh or file path."));
+        return false;
+    }
+
+    const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    if (!RenderData || !RenderData->LODResources.IsValidIndex(LODIndex))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ExportStaticMesh: %s has no render data for LOD %d."), *StaticMesh->GetName(), LODIndex);
+        return false;
+    }
+
+    return LIB_MeshExport::ExportStaticMeshLOD(RenderData->LODResources[LODIndex], FilePath, Format);
+}
+
+bool ULIB_Export::ExportProcMeshData(const FProcMeshData& MeshData, const FString& FilePath, EProcMeshExportFormat Format)
+{
+    if (FilePath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ExportProcMeshData: invalid file path."));
+        return false;
+    }
+
+    return LIB_MeshExport::ExportMeshData(FProcMeshDataView(MeshData), FilePath, Format);
+}
@@ -1,76 +1,654 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Kismet/BlueprintFunctionLibrary.h"
-#include "Engine/StaticMesh.h"
-#include "ProceduralMeshComponent.h"
-#include "Delegates/Delegate.h"
-#include "Kismet/BlueprintAsyncActionBase.h"
-#include "LIB_Export.generated.h"
-
-/**
- * 
- */
-
-USTRUCT(BlueprintType)
-struct FProcMeshData
-{
-	GENERATED_BODY()
-
-public:
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<FVector> Vertices;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<int32> Triangles;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<FVector> Normals;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<FVector2D> UV0;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<FLinearColor> VertexColors;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
-	TArray<FProcMeshTangent> Tangents;
-};
-
-UCLASS()
-class SAMSUNGGLASSSIM_5_3_API ULIB_Export : public UBlueprintFunctionLibrary
-{
-	GENERATED_BODY()
-
-public:
-	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshConverted, UStaticMesh*, StaticMesh);
-	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshProgress, float, Progress);
-	DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnStaticMeshResult, int32, ErrorCode, UStaticMesh*, StaticMesh);
-
-	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshConverted2, UStaticMesh*, StaticMesh);
-	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshProgress2, float, Progress);
-	DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnStaticMeshResult2, int32, ErrorCode, UStaticMesh*, StaticMesh);
-
-	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
-	static UStaticMesh* ConvertProcToStaticMesh(FProcMeshData MeshData, const bool RecalculateNormal);
-
-	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
-	static bool SaveStaticMeshToStl(UStaticMesh* StaticMesh, const FString& FilePath);
-
-	// Updated async version with progress and result handling
-	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
-	static void ConvertProcToStaticMeshAsync(
-		FProcMeshData MeshData,
-		const bool RecalculateNormal,
-		FOnStaticMeshProgress OnProgress,
-		FOnStaticMeshResult OnResult
-	);
-
-	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
-	static void TakeScreenShot(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bAddSuffix, FString& FullFilePath);
-
-	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
-	static void ConvetFileToTexture(const FString& FileFullPath, UTexture2D*& OutTexture);
-};
-
-
-
-
-
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Engine/StaticMesh.h"
+#include "ProceduralMeshComponent.h"
+#include "Delegates/Delegate.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "LIB_Export.generated.h"
+
+class UStaticMeshComponent;
+struct FMeshDescription;
+struct FProcMeshBuffer;
+struct FProcMeshBufferView;
+
+/**
+ * 
+ */
+
+USTRUCT(BlueprintType)
+struct FProcMeshData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<FVector> Vertices;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<int32> Triangles;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<FVector> Normals;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<FVector2D> UV0;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<FLinearColor> VertexColors;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	TArray<FProcMeshTangent> Tangents;
+};
+
+/**
+ * FProcMeshData 와 같은 구성의 읽기 전용 뷰 (C++ 전용).
+ * 변환 함수는 버퍼를 복사하지 않고 그대로 읽으므로, 호출이 끝날 때까지 원본 배열을 유지해야 합니다.
+ */
+struct FProcMeshDataView
+{
+	TConstArrayView<FVector> Vertices;
+	TConstArrayView<int32> Triangles;
+	TConstArrayView<FVector> Normals;
+	TConstArrayView<FVector2D> UV0;
+	TConstArrayView<FLinearColor> VertexColors;
+	TConstArrayView<FProcMeshTangent> Tangents;
+
+	FProcMeshDataView() = default;
+
+	FProcMeshDataView(const FProcMeshData& MeshData)
+		: Vertices(MeshData.Vertices)
+		, Triangles(MeshData.Triangles)
+		, Normals(MeshData.Normals)
+		, UV0(MeshData.UV0)
+		, VertexColors(MeshData.VertexColors)
+		, Tangents(MeshData.Tangents)
+	{
+	}
+
+	FProcMeshData ToMeshData() const
+	{
+		FProcMeshData MeshData;
+		MeshData.Vertices = Vertices;
+		MeshData.Triangles = Triangles;
+		MeshData.Normals = Normals;
+		MeshData.UV0 = UV0;
+		MeshData.VertexColors = VertexColors;
+		MeshData.Tangents = Tangents;
+		return MeshData;
+	}
+};
+
+// 정점 법선 재계산 시 인접 삼각형 법선의 가중치
+UENUM(BlueprintType)
+enum class EProcNormalWeighting : uint8
+{
+	None,	// 단순 평균
+	Area,	// 삼각형 면적 가중
+	Angle	// 정점에서의 내각 가중
+};
+
+// UV0 가 없을 때 자동 생성하는 UV 의 투영 방식 (모두 투영축 기준 좌표계에서 계산)
+UENUM(BlueprintType)
+enum class EProcUVProjection : uint8
+{
+	Planar,			// 투영축에 수직인 평면으로 투영
+	Box,			// 정점 법선의 가장 큰 성분 축 평면으로 투영 (트라이플래너)
+	Cylindrical,	// U: 투영축 둘레 각도 [0, 1], V: 축 방향 거리
+	Spherical		// U: 투영축 둘레 각도 [0, 1], V: 축에서 잰 극각 [0, 1]
+};
+
+// 변환한 스태틱 메시에 붙일 충돌. 볼록 껍질 계산은 워커에서, 쿠킹은 메시를 넘겨준 뒤 비동기로 진행된다
+UENUM(BlueprintType)
+enum class EProcCollisionMode : uint8
+{
+	None,					// 충돌 없음
+	ConvexHull,				// LOD0 전체를 감싸는 단순화한 볼록 껍질 하나
+	ConvexDecomposition,	// 오목한 곳을 기준으로 나눈 삼각형 묶음마다 볼록 껍질 하나 (오목한 메시용, 볼록하면 껍질 하나)
+	ComplexAsSimple			// LOD0 삼각형 메시를 그대로 쿠킹하여 단순 충돌로도 사용
+};
+
+USTRUCT(BlueprintType)
+struct FProcMeshConvertOptions
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bRecalculateNormal = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bRecalculateNormal"))
+	EProcNormalWeighting NormalWeighting = EProcNormalWeighting::Angle;
+
+	// 켜면 인접 삼각형 사이 각도가 CreaseAngle 을 넘는 엣지를 하드 엣지로 분리 (정점이 복제됨)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bRecalculateNormal"))
+	bool bUseCreaseAngle = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bRecalculateNormal && bUseCreaseAngle", ClampMin = "0.0", ClampMax = "180.0"))
+	float CreaseAngle = 60.0f;
+
+	// 입력에 UV0 가 없을 때 사용할 투영. 기본값(+Z 평면, 배율 1, 오프셋 0)은 정점의 XY 좌표를 그대로 사용
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	EProcUVProjection UVProjection = EProcUVProjection::Planar;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	FVector UVProjectionAxis = FVector::UpVector;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	FVector UVProjectionCenter = FVector::ZeroVector;
+
+	// 투영 결과에 UV = Projected * UVScale + UVOffset 으로 적용
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	FVector2D UVScale = FVector2D::UnitVector;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	FVector2D UVOffset = FVector2D::ZeroVector;
+
+	// 빌드 전에 NaN/Inf 정점, 잘못된 인덱스, 면적 0 삼각형, 참조되지 않는 정점을 정리하고 가까운 정점을 용접
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bRepairMesh = false;
+
+	// 이 거리 안의 정점 위치를 하나로 맞춘다 (0 이면 위치가 정확히 같은 정점만)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bRepairMesh", ClampMin = "0.0"))
+	float RepairWeldThreshold = 0.0f;
+
+	// 최종 UV0/법선으로 MikkTSpace 호환 탄젠트를 새로 생성 (입력 탄젠트는 무시)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bGenerateTangents = false;
+
+	// 1 보다 크면 워커에서 QEM 단순화로 LOD1 부터를 만들어 같은 스태틱 메시에 붙인다
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 NumLODs = 1;
+
+	// LOD1 부터의 원본 대비 목표 삼각형 비율. 없는 항목은 LODScreenSizes 의 제곱, 그것도 없으면 이전 LOD 의 절반
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "NumLODs > 1"))
+	TArray<float> LODTriangleRatios;
+
+	// LOD1 부터의 전환 화면 크기. 없는 항목은 삼각형 비율의 제곱근
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "NumLODs > 1"))
+	TArray<float> LODScreenSizes;
+
+	// 큰 메시를 삼각형 중심의 Morton 순서로 나누어 구간마다 별도의 섹션(폴리곤 그룹)으로 만든다
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bSplitSections = false;
+
+	// 한 섹션이 참조하는 정점 수 상한 (기본값은 16비트 인덱스 범위)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bSplitSections", ClampMin = "3"))
+	int32 MaxSectionVertices = 65536;
+
+	// 워커에서 각 LOD 의 삼각형 순서를 정점 캐시(Tipsify)와 오버드로 기준으로 재정렬 (정점 인스턴스도 그 순서로 만들어진다)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bOptimizeVertexCache = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	EProcCollisionMode CollisionMode = EProcCollisionMode::None;
+
+	// ConvexDecomposition 으로 만들 볼록 껍질 최대 수
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "CollisionMode == EProcCollisionMode::ConvexDecomposition", ClampMin = "1", ClampMax = "64"))
+	int32 MaxConvexHulls = 8;
+
+	// ConvexDecomposition 에서 이보다 오목한 묶음만 더 나눕니다. (묶음 껍질 안쪽으로 들어간 표면의 최대 깊이, 메시 바운드 대각선에 대한 비율)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "CollisionMode == EProcCollisionMode::ConvexDecomposition", ClampMin = "0.001", ClampMax = "0.5"))
+	float MaxConcavity = 0.02f;
+
+	// 볼록 껍질 하나의 최대 정점 수 (고르게 퍼진 방향마다 가장 바깥 정점을 고른다)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (ClampMin = "4", ClampMax = "256"))
+	int32 MaxHullVertices = 32;
+
+	// 같은 입력과 옵션의 변환 결과를 재사용 (결과 메시를 여러 호출자가 공유하므로 수정하지 말 것)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export")
+	bool bUseCache = false;
+
+	// 메모리 캐시에 없으면 Saved/ProcMeshCache 에 저장된 MeshDescription 을 조회하고, 새로 만든 결과도 저장
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "LIB_Export", meta = (EditCondition = "bUseCache"))
+	bool bUseDiskCache = false;
+};
+
+// 메시 정리 단계의 결과
+USTRUCT(BlueprintType)
+struct FProcMeshRepairStats
+{
+	GENERATED_BODY()
+
+public:
+	// 범위를 벗어난 인덱스나 NaN/Inf 정점을 써서 제거된 삼각형
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumInvalidTriangles = 0;
+
+	// 용접 후 붕괴되었거나 면적이 0 이라 제거된 삼각형
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumDegenerateTriangles = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumNonFiniteVertices = 0;
+
+	// 위치와 속성이 같아져 다른 정점으로 합쳐진 정점
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumWeldedVertices = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumUnreferencedVertices = 0;
+
+	// 단계별 소요 시간 (ms)
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float WeldMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float FilterMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float CompactMs = 0.0f;
+};
+
+// 인덱스 재정렬 단계의 결과. ACMR 은 삼각형당 평균 정점 캐시 미스 수 (LIB_MeshProcessing::VertexCacheSize 크기의 FIFO 로 측정)
+USTRUCT(BlueprintType)
+struct FProcMeshVertexCacheStats
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float ACMRBefore = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float ACMRAfter = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float OptimizeMs = 0.0f;
+};
+
+// 비동기 변환의 단계별 소요 시간 (ms). 실행되지 않은 단계는 0
+USTRUCT(BlueprintType)
+struct FProcMeshConvertTimings
+{
+	GENERATED_BODY()
+
+public:
+	// 제출(또는 재처리)부터 워커가 작업을 꺼낼 때까지
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float QueueMs = 0.0f;
+
+	// 입력 검사와 캐시 키 계산 및 조회
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float CacheLookupMs = 0.0f;
+
+	// 정리, 법선, UV, 탄젠트
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float PrepareMs = 0.0f;
+
+	// LOD 단순화, 섹션 분할, 정점 캐시 정렬을 포함한 MeshDescription 생성
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float BuildDescriptionsMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float CollisionMs = 0.0f;
+
+	// 게임 스레드 마무리 대기열에서 프레임 예산을 기다린 시간
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float FinalizeWaitMs = 0.0f;
+
+	// 게임 스레드 스태틱 메시 빌드
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float BuildMeshMs = 0.0f;
+
+	// 제출부터 완료까지
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	float TotalMs = 0.0f;
+
+	// 입력 삼각형 수
+	UPROPERTY(BlueprintReadOnly, Category = "LIB_Export")
+	int32 NumTriangles = 0;
+};
+
+// ExportStaticMesh / ExportProcMeshData 의 파일 형식
+UENUM(BlueprintType)
+enum class EProcMeshExportFormat : uint8
+{
+	Obj,	// 텍스트 OBJ (v 뒤에 정점 색)
+	Ply,	// 바이너리 리틀 엔디언 PLY
+	Glb		// glTF 2.0 바이너리 (.glb)
+};
+
+// 비동기 변환 작업의 현재 상태
+UENUM(BlueprintType)
+enum class EProcConvertState : uint8
+{
+	Pending,	// 워커 대기 중
+	Processing,	// 워커에서 전처리/MeshDescription 생성 중
+	Finalizing,	// 게임 스레드 빌드 대기 중
+	Completed,
+	Failed,
+	Cancelled
+};
+
+class FProcMeshConvertJob;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnProcCollisionReady, UStaticMesh*, StaticMesh, bool, bSuccess);
+
+/**
+ * ConvertProcToStaticMeshAsync 가 반환하는 작업 핸들.
+ * 핸들을 버려도 작업은 계속 진행되며, 취소는 Cancel() 로만 이루어집니다.
+ */
+UCLASS(BlueprintType)
+class SAMSUNGGLASSSIM_5_3_API ULIB_ConvertHandle : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// 아직 끝나지 않았다면 취소하고 OnResult 를 ErrorCode -2 로 호출합니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void Cancel();
+
+	// 값이 클수록 워커와 게임 스레드 빌드 대기열에서 먼저 처리됩니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void SetPriority(int32 NewPriority);
+
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	int32 GetPriority() const;
+
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	EProcConvertState GetState() const;
+
+	// Options.bRepairMesh 로 변환한 작업의 정리 결과. 전처리가 끝나기 전(또는 캐시 적중 시)에는 모두 0 입니다.
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	FProcMeshRepairStats GetRepairStats() const;
+
+	// Options.bOptimizeVertexCache 로 변환한 작업의 LOD0 재정렬 결과. 전처리가 끝나기 전(또는 캐시 적중 시)에는 모두 0 입니다.
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	FProcMeshVertexCacheStats GetVertexCacheStats() const;
+
+	// 단계별 소요 시간. 작업이 완료(또는 실패)된 뒤에만 채워져 있습니다.
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	FProcMeshConvertTimings GetTimings() const;
+
+	// 결과 메시를 넣은 컴포넌트를 등록하면 충돌 쿠킹이 끝날 때 그 컴포넌트만 물리 상태를 다시 만듭니다. (핸들이 살아 있는 동안만)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void AddCollisionTarget(UStaticMeshComponent* Component);
+
+	// Options.CollisionMode 로 요청한 충돌의 쿠킹이 끝나면 호출됩니다. (메시는 OnResult 로 먼저 전달되며, 캐시 적중 시에는 호출되지 않음)
+	UPROPERTY(BlueprintAssignable, Category = "LIB_Export")
+	FOnProcCollisionReady OnCollisionReady;
+
+	TSharedPtr<FProcMeshConvertJob, ESPMode::ThreadSafe> Job;
+
+	TArray<TWeakObjectPtr<UStaticMeshComponent>> CollisionTargets;
+};
+
+class FProcMeshIncrementalState;
+
+/**
+ * 큰 프로시저럴 메시의 일부만 자주 바뀔 때 쓰는 점진 변환기. ULIB_Export::CreateIncrementalConverter 로 만듭니다.
+ * 메시는 공간적으로 가까운 삼각형끼리 나눈 구간(Options.MaxSectionVertices 기준)마다 별도의 스태틱 메시가 되며,
+ * Rebuild 는 바뀐 범위와 그 주변 법선/탄젠트에 닿는 구간만 다시 빌드합니다. 법선, 자동 생성 UV, 탄젠트는 메시 전체 기준이라 구간 경계에서 이어집니다. 구간 메시는 모두 같은 좌표계이므로 같은 트랜스폼에 배치합니다.
+ * 정점 수와 삼각형 수는 바꿀 수 없습니다. (바뀌면 새 변환기를 만들 것)
+ */
+UCLASS(BlueprintType)
+class SAMSUNGGLASSSIM_5_3_API ULIB_IncrementalConverter : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// FirstVertex 부터 정점 위치를 덮어쓰고 바뀐 것으로 표시합니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void UpdateVertices(int32 FirstVertex, const TArray<FVector>& Vertices);
+
+	// FirstVertex 부터 정점 색을 덮어쓰고 바뀐 것으로 표시합니다. (처음 변환에 정점 색이 있어야 함)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void UpdateVertexColors(int32 FirstVertex, const TArray<FLinearColor>& VertexColors);
+
+	// FirstTriangle 번째 삼각형부터 인덱스를 덮어쓰고 바뀐 것으로 표시합니다. (Indices 는 3의 배수)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void UpdateTriangles(int32 FirstTriangle, const TArray<int32>& Indices);
+
+	// GetMutableMeshData 로 직접 고친 범위를 알립니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void MarkVerticesDirty(int32 FirstVertex, int32 NumVertices);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void MarkTrianglesDirty(int32 FirstTriangle, int32 NumTriangles);
+
+	/**
+	 * 표시된 변경에 닿는 구간만 다시 빌드합니다. (게임 스레드 전용)
+	 * 법선 재계산, 구간 MeshDescription 생성은 병렬로 진행되며, 바뀐 구간의 메시는 새 오브젝트로 교체됩니다.
+	 * @return 다시 만든 구간 번호. 삼각형이 남지 않았거나 전처리에 실패한 구간의 메시는 nullptr
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	TArray<int32> Rebuild();
+
+	// 지금 구간 메시를 Component 에 넣고 Rebuild 때마다 새 메시로 바꿉니다. 충돌 쿠킹이 끝나면 이 컴포넌트만 물리 상태를 다시 만듭니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	void SetSectionComponent(int32 SectionIndex, UStaticMeshComponent* Component);
+
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	int32 GetNumSections() const { return SectionMeshes.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	UStaticMesh* GetSectionMesh(int32 SectionIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "LIB_Export")
+	TArray<UStaticMesh*> GetSectionMeshes() const;
+
+	// C++ 전용: 배열을 직접 고친 뒤 MarkVerticesDirty / MarkTrianglesDirty 로 알립니다. (배열 크기는 바꾸지 말 것)
+	FProcMeshData& GetMutableMeshData();
+
+	TSharedPtr<FProcMeshIncrementalState> State;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UStaticMesh>> SectionMeshes;
+
+	TArray<TWeakObjectPtr<UStaticMeshComponent>> SectionComponents;
+};
+
+UCLASS()
+class SAMSUNGGLASSSIM_5_3_API ULIB_Export : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshConverted, UStaticMesh*, StaticMesh);
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshProgress, float, Progress);
+	DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnStaticMeshResult, int32, ErrorCode, UStaticMesh*, StaticMesh);
+
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshConverted2, UStaticMesh*, StaticMesh);
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshProgress2, float, Progress);
+	DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnStaticMeshResult2, int32, ErrorCode, UStaticMesh*, StaticMesh);
+
+	DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnStaticMeshBatchItem, int32, Index, int32, ErrorCode, UStaticMesh*, StaticMesh);
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStaticMeshBatchResult, const TArray<UStaticMesh*>&, StaticMeshes);
+
+	DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnScreenShotCaptured, int32, ErrorCode, const FString&, FullFilePath, UTexture2D*, Texture);
+	DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnTextureLoaded, int32, ErrorCode, UTexture2D*, Texture);
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnTextureProgress, float, Progress);
+	DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnTextureBatchItem, int32, Index, int32, ErrorCode, UTexture2D*, Texture);
+	DECLARE_DYNAMIC_DELEGATE_OneParam(FOnTextureBatchResult, const TArray<UTexture2D*>&, Textures);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static UStaticMesh* ConvertProcToStaticMesh(FProcMeshData MeshData, const bool RecalculateNormal);
+
+	// LOD0 렌더 데이터를 바이너리 STL로 저장 (bAllowCPUAccess 필요)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static bool SaveStaticMeshToStl(UStaticMesh* StaticMesh, const FString& FilePath);
+
+	// 스태틱 메시 LOD 를 위치/법선/UV/정점 색과 인덱스를 포함해 내보냄 (bAllowCPUAccess 필요)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static bool ExportStaticMesh(UStaticMesh* StaticMesh, const FString& FilePath, EProcMeshExportFormat Format, int32 LODIndex = 0);
+
+	// 프로시저럴 메시 데이터를 스태틱 메시로 변환하지 않고 바로 내보냄
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static bool ExportProcMeshData(const FProcMeshData& MeshData, const FString& FilePath, EProcMeshExportFormat Format);
+
+	// Updated async version with progress and result handling
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static ULIB_ConvertHandle* ConvertProcToStaticMeshAsync(
+		FProcMeshData MeshData,
+		const bool RecalculateNormal,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshResult OnResult
+	);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static UStaticMesh* ConvertProcToStaticMeshWithOptions(FProcMeshData MeshData, const FProcMeshConvertOptions& Options);
+
+	// SlotKey 가 같은 작업이 새로 들어오면 이전 작업은 취소된다 (ErrorCode -2). Priority 가 클수록 먼저 처리된다.
+	// OnProgress 는 단계별 작업량(삼각형 수 x 실측 단계 비용)으로 가중한 값을 프레임당 최대 한 번 받고, 성공하면 마지막에 1.0 을 받는다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static ULIB_ConvertHandle* ConvertProcToStaticMeshAsyncWithOptions(
+		FProcMeshData MeshData,
+		const FProcMeshConvertOptions& Options,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshResult OnResult,
+		FName SlotKey = NAME_None,
+		int32 Priority = 0
+	);
+
+	// 처음 한 번 전체를 구간별로 변환하고, 이후에는 바뀐 범위에 닿는 구간만 다시 빌드하는 변환기를 만듭니다. 입력이 유효하지 않으면 nullptr
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static ULIB_IncrementalConverter* CreateIncrementalConverter(FProcMeshData MeshData, const FProcMeshConvertOptions& Options);
+
+	// 비동기 변환의 게임 스레드 마무리(스태틱 메시 빌드)에 쓸 프레임당 시간 예산 (ms)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void SetAsyncConvertFrameBudget(float BudgetMs = 4.0f);
+
+	// 변환 결과 메모리 캐시의 최대 항목 수 (바꾸면 기존 항목은 비워진다)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void SetConvertCacheCapacity(int32 MaxEntries = 64);
+
+	// 변환 전처리의 메시 정리 단계만 실행합니다. (Options.bRepairMesh 와 같은 처리)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static FProcMeshRepairStats RepairProcMeshData(UPARAM(ref) FProcMeshData& MeshData, float WeldThreshold = 0.0f);
+
+	// 삼각형을 정점 캐시/오버드로 순서로 재정렬하고, 정점 배열도 처음 쓰이는 순서로 옮깁니다. (Options.bOptimizeVertexCache 와 같은 처리)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static FProcMeshVertexCacheStats OptimizeProcMeshIndices(UPARAM(ref) FProcMeshData& MeshData);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ClearConvertCache(bool bIncludeDiskCache);
+
+	// 변환 결과 디스크 캐시(Saved/ProcMeshCache)의 파일 크기 합 상한 (기본 512MB). 넘으면 가장 오래 쓰지 않은 파일부터 지운다
+	// 0 이면 디스크에 새로 저장하지 않고 기존 파일을 모두 지운다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void SetConvertDiskCacheBudget(int32 MaxMegabytes = 512);
+
+	// 메시를 정렬된 바이너리 파일로 저장 (bCompress 이면 LZ4 블록 압축)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static bool SaveProcMeshDataToFile(const FProcMeshData& MeshData, const FString& FilePath, bool bCompress = false);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static bool LoadProcMeshDataFromFile(const FString& FilePath, FProcMeshData& OutMeshData);
+
+	// 저장된 파일을 메모리 매핑하여 원소 단위 역직렬화 없이 바로 변환
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static UStaticMesh* ConvertProcMeshFileToStaticMesh(const FString& FilePath, const FProcMeshConvertOptions& Options);
+
+	// 파일 매핑부터 워커에서 진행하는 비동기 버전. 파일을 읽을 수 없으면 ErrorCode -1
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static ULIB_ConvertHandle* ConvertProcMeshFileToStaticMeshAsync(
+		const FString& FilePath,
+		const FProcMeshConvertOptions& Options,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshResult OnResult,
+		FName SlotKey = NAME_None,
+		int32 Priority = 0
+	);
+
+	// 여러 프로시저럴 메시를 최대 MaxWorkers 개의 워커로 변환
+	// OnItemResult 는 항목이 끝날 때마다, OnBatchResult 는 전체가 끝났을 때 입력 순서대로 한 번 호출된다
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ConvertProcToStaticMeshBatchAsync(
+		TArray<FProcMeshData> MeshDatas,
+		const FProcMeshConvertOptions& Options,
+		int32 MaxWorkers,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshBatchItem OnItemResult,
+		FOnStaticMeshBatchResult OnBatchResult
+	);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void TakeScreenShot(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bAddSuffix, FString& FullFilePath);
+
+	/**
+	 * 게임 스레드를 멈추지 않고 스크린샷을 찍어, 파일이 실제로 저장된 뒤 (또는 메모리 이미지가 준비된 뒤) OnCaptured 를 호출합니다.
+	 * bSaveToFile 이면 FilePath/날짜_FileName(.png) 에 저장하고, bCreateTexture 이면 같은 픽셀로 트랜지언트 텍스처를 만듭니다.
+	 * ErrorCode 0 이면 성공, -1 이면 실패 (같은 bCaptureUI 방식의 캡처가 이미 진행 중인 경우 포함, 경로가 달라도 마찬가지)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void TakeScreenShotAsync(const FString& FilePath, const FString& FileName, bool bCaptureUI, bool bSaveToFile, bool bCreateTexture, FOnScreenShotCaptured OnCaptured);
+
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ConvetFileToTexture(const FString& FileFullPath, UTexture2D*& OutTexture);
+
+	// 파일 읽기와 디코드(PNG/JPEG/BMP/EXR 헤더로 판별), 선택적 밉 생성은 워커에서 하고 텍스처 생성과 업로드만 게임 스레드에서 합니다.
+	// ErrorCode 0 이면 성공, -1 이면 실패
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ConvetFileToTextureAsync(const FString& FullFilePath, bool bGenerateMips, FOnTextureLoaded OnLoaded);
+
+	// 여러 이미지를 최대 MaxWorkers 개의 워커로 디코드하고, 끝난 순서대로 프레임당 UploadMegabytesPerFrame 만큼 텍스처로 만들어
+	// OnItemLoaded 로 넘긴다 (최소 한 장). 디코드 중이거나 업로드를 기다리는 크기는 MaxInFlightMegabytes 를 넘지 않는다 (더 큰 이미지 하나는 예외).
+	// 텍스처 캐시를 거치므로 ConvetFileToTextureAsync 등에서 같은 파일을 디코드 중이면 한 번만 디코드한다.
+	// OnBatchResult 는 전체가 끝났을 때 입력 순서대로 한 번 호출된다. 0 이하인 제한 값은 제한 없음
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ConvetFilesToTexturesAsync(
+		TArray<FString> FullFilePaths,
+		bool bGenerateMips,
+		int32 MaxWorkers,
+		int32 MaxInFlightMegabytes,
+		int32 UploadMegabytesPerFrame,
+		FOnTextureProgress OnProgress,
+		FOnTextureBatchItem OnItemLoaded,
+		FOnTextureBatchResult OnBatchResult
+	);
+
+	// ConvetFileToTexture(Async) 가 같은 파일(경로, 크기, 수정 시각)에 대해 재사용하는 텍스처 캐시의 예산 (디코드된 크기 기준, 기본 256MB)
+	// 0 이면 캐시하지 않고, 동시에 들어온 같은 파일 요청만 한 번의 디코드로 합칩니다.
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void SetTextureCacheBudget(int32 MaxMegabytes);
+
+	// 캐시가 들고 있는 텍스처 참조를 모두 놓습니다 (이미 받은 텍스처는 호출자가 참조하는 동안 유효)
+	UFUNCTION(BlueprintCallable, Category = "LIB_Export")
+	static void ClearTextureCache();
+
+	// C++ 전용: 호출자가 소유한 버퍼를 복사하지 않고 읽어서 변환 (원본은 수정하지 않음)
+	static UStaticMesh* ConvertProcToStaticMesh(const FProcMeshDataView& MeshView, const FProcMeshConvertOptions& Options);
+
+	// C++ 전용: 변경하지 않는 공유 버퍼를 작업이 끝날 때까지 참조하며 변환 (복사 없음)
+	static ULIB_ConvertHandle* ConvertProcToStaticMeshAsync(
+		const TSharedRef<const FProcMeshData, ESPMode::ThreadSafe>& MeshData,
+		const FProcMeshConvertOptions& Options,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshResult OnResult,
+		FName SlotKey = NAME_None,
+		int32 Priority = 0
+	);
+
+	// C++ 전용: 단정밀도 SoA 버퍼를 복사하지 않고 읽어서 변환 (원본은 수정하지 않음)
+	static UStaticMesh* ConvertProcToStaticMesh(const FProcMeshBuffer& MeshBuffer, const FProcMeshConvertOptions& Options);
+	static UStaticMesh* ConvertProcToStaticMesh(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options);
+
+	// C++ 전용: 변경하지 않는 공유 SoA 버퍼를 작업이 끝날 때까지 참조하며 변환
+	static ULIB_ConvertHandle* ConvertProcToStaticMeshAsync(
+		const TSharedRef<const FProcMeshBuffer, ESPMode::ThreadSafe>& MeshBuffer,
+		const FProcMeshConvertOptions& Options,
+		FOnStaticMeshProgress OnProgress,
+		FOnStaticMeshResult OnResult,
+		FName SlotKey = NAME_None,
+		int32 Priority = 0
+	);
+
+	// 이미 만들어진 MeshDescription 으로 트랜지언트 스태틱 메시를 빌드 (게임 스레드 전용)
+	static UStaticMesh* BuildStaticMeshFromDescription(const FMeshDescription& MeshDesc);
+
+	// LOD 순서의 MeshDescription 으로 빌드. LODScreenSizes 가 LOD 수와 같으면 LOD 전환 화면 크기로 사용 (게임 스레드 전용)
+	static UStaticMesh* BuildStaticMeshFromDescriptions(TConstArrayView<FMeshDescription> LODMeshDescs, TConstArrayView<float> LODScreenSizes);
+
+	/**
+	 * CollisionMode 에 따른 충돌을 붙이고 쿠킹을 비동기로 시작합니다. (게임 스레드 전용)
+	 * 쿠킹이 끝나면 Components 중 아직 이 메시를 쓰는 컴포넌트만 물리 상태를 다시 만들고 OnReady 를 호출합니다.
+	 * @param ConvexHulls LIB_MeshProcessing::BuildCollisionHulls 의 결과 (ComplexAsSimple 이면 비어 있음)
+	 * @param Components 쿠킹 전에 이 메시를 받은 컴포넌트 (나중에 메시를 넣는 컴포넌트는 그때 쿠킹된 충돌로 물리 상태를 만듦)
+	 */
+	static void BuildCollisionAsync(UStaticMesh* StaticMesh, EProcCollisionMode CollisionMode, TArray<TArray<FVector3f>>&& ConvexHulls, TArray<TWeakObjectPtr<UStaticMeshComponent>> Components = {}, TFunction<void(UStaticMesh*, bool)> OnReady = nullptr);
+};
+
+
+
+
+
@@ -0,0 +1,242 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_ImageBatchLoad.h"
+#include "LIB_TextureCache.h"
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Texture2D.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+FImageBatchLoad::FImageBatchLoad(
+    TArray<FString>&& InFilePaths,
+    const bool bInGenerateMips,
+    const ULIB_Export::FOnTextureProgress& InOnProgress,
+    const ULIB_Export::FOnTextureBatchItem& InOnItemLoaded,
+    const ULIB_Export::FOnTextureBatchResult& InOnBatchResult)
+    : FilePaths(MoveTemp(InFilePaths))
+    , bGenerateMips(bInGenerateMips)
+    , OnProgress(InOnProgress)
+    , OnItemLoaded(InOnItemLoaded)
+    , OnBatchResult(InOnBatchResult)
+{
+    Results.SetNum(FilePaths.Num());
+}
+
+void FImageBatchLoad::Start(int32 InMaxWorkers, int64 InMaxInFlightBytes, int64 InMaxUploadBytesPerFrame)
+{
+    check(IsInGameThread());
+
+    if (FilePaths.Num() == 0)
+    {
+        OnProgress.ExecuteIfBound(1.0f);
+        OnBatchResult.ExecuteIfBound(TArray<UTexture2D*>());
+        return;
+    }
+
+    MaxWorkers = InMaxWorkers > 0 ? InMaxWorkers : FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+    MaxInFlightBytes = InMaxInFlightBytes > 0 ? InMaxInFlightBytes : MAX_int64;
+    MaxUploadBytesPerFrame = InMaxUploadBytesPerFrame > 0 ? InMaxUploadBytesPerFrame : MAX_int64;
+
+    // 1. 캐시에 요청. 적중하거나 다른 곳에서 디코드 중이면 결과를 기다리기만 하고, 아니면 이 배치가 디코드한다
+    FTextureCache& Cache = FTextureCache::Get();
+    LoadIds.SetNumZeroed(FilePaths.Num());
+    TWeakPtr<FImageBatchLoad, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    for (int32 Index = 0; Index < FilePaths.Num(); ++Index)
+    {
+        const bool bMustDecode = Cache.RequestLoad(FilePaths[Index], bGenerateMips, [WeakSelf, Index](UTexture2D* Texture)
+            {
+                if (TSharedPtr<FImageBatchLoad, ESPMode::ThreadSafe> Self = WeakSelf.Pin())
+                {
+                    Self->OnTextureReady(Index, Texture);
+                }
+            }, LoadIds[Index]);
+        if (bMustDecode)
+        {
+            PendingIndices.Add(Index);
+        }
+    }
+
+    // 2. 워커 시작
+    LIB_ImageLoader::LoadImageWrapperModule();
+    DispatchWorkers();
+
+    // 틱 델리게이트가 강한 참조를 들고 있다가 Tick 이 false 를 반환하거나 Shutdown 에서 떼어지면 함께 해제된다
+    TSharedRef<FImageBatchLoad, ESPMode::ThreadSafe> Self = AsShared();
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self](float DeltaTime)
+        {
+            return Self->Tick(DeltaTime);
+        }));
+
+    // 텍스처 캐시와 같이 UObject 정리 전에 결과 참조를 놓는다 (Start 는 게임 스레드에서만 불림)
+    PreExitHandle = FCoreDelegates::OnPreExit.AddSP(Self, &FImageBatchLoad::Shutdown);
+}
+
+void FImageBatchLoad::Shutdown()
+{
+    // 티커가 마지막 강한 참조일 수 있으므로 정리가 끝날 때까지 붙잡아 둔다
+    TSharedRef<FImageBatchLoad, ESPMode::ThreadSafe> Self = AsShared();
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+
+    // 돌고 있는 워커는 지금 파일까지만 디코드하고 끝난다
+    NextPending.store(PendingIndices.Num());
+    {
+        FScopeLock ScopeLock(&DeferredLock);
+        DeferredIndices.Reset();
+        NumDeferred.store(0);
+    }
+    Decoded.Empty();
+    ReadyIndices.Reset();
+    Results.Reset();
+}
+
+void FImageBatchLoad::DispatchWorkers()
+{
+    while (NumActiveWorkers.load() < MaxWorkers && (NextPending.load() < PendingIndices.Num() || NumDeferred.load() > 0) && InFlightBytes.load() < MaxInFlightBytes)
+    {
+        NumActiveWorkers.fetch_add(1);
+        TSharedRef<FImageBatchLoad, ESPMode::ThreadSafe> Self = AsShared();
+        Async(EAsyncExecution::ThreadPool, [Self]()
+            {
+                Self->RunWorker();
+            });
+    }
+}
+
+bool FImageBatchLoad::TryReserve(int64 NumBytes)
+{
+    int64 Current = InFlightBytes.load();
+    do
+    {
+        if (Current > 0 && Current + NumBytes > MaxInFlightBytes)
+        {
+            return false;
+        }
+    } while (!InFlightBytes.compare_exchange_weak(Current, Current + NumBytes));
+    return true;
+}
+
+void FImageBatchLoad::RunWorker()
+{
+    // 풀 스레드를 붙잡고 기다리지 않도록, 예산을 잡지 못하면 종료하고 게임 스레드가 다시 띄우게 한다
+    for (;;)
+    {
+        // 1. 미뤄 둔 항목부터, 없으면 다음 항목
+        int32 Index = INDEX_NONE;
+        if (NumDeferred.load() > 0)
+        {
+            FScopeLock ScopeLock(&DeferredLock);
+            if (DeferredIndices.Num() > 0)
+            {
+                Index = DeferredIndices.Pop(false);
+                NumDeferred.fetch_sub(1);
+            }
+        }
+        if (Index == INDEX_NONE)
+        {
+            const int32 Pending = NextPending.fetch_add(1);
+            if (Pending >= PendingIndices.Num())
+            {
+                break;
+            }
+            Index = PendingIndices[Pending];
+        }
+
+        // 2. 파일을 읽고 헤더로 계산한 디코드 크기를 먼저 잡는다 (읽지 못한 파일은 0 으로 두고 디코드에서 실패 처리)
+        const FString& FilePath = FilePaths[Index];
+        TArray64<uint8> FileData;
+        const bool bLoaded = FFileHelper::LoadFileToArray(FileData, *FilePath);
+        const int64 EstimatedBytes = bLoaded ? LIB_ImageLoader::GetDecodedNumBytes(FileData, bGenerateMips) : 0;
+        if (!TryReserve(EstimatedBytes))
+        {
+            FScopeLock ScopeLock(&DeferredLock);
+            DeferredIndices.Add(Index);
+            NumDeferred.fetch_add(1);
+            break;
+        }
+
+        // 3. 디코드 후 업로드 대기열로
+        FDecodedItem Item;
+        Item.Index = Index;
+        Item.ReservedBytes = EstimatedBytes;
+        Item.Image = MakeShared<FDecodedImage, ESPMode::ThreadSafe>();
+        if (bLoaded)
+        {
+            LIB_ImageLoader::DecodeImage(FileData, bGenerateMips, *Item.Image, *FilePath);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to load file data from %s"), *FilePath);
+        }
+        FileData.Empty();
+        Decoded.Enqueue(MoveTemp(Item));
+    }
+    NumActiveWorkers.fetch_sub(1);
+}
+
+void FImageBatchLoad::OnTextureReady(int32 Index, UTexture2D* Texture)
+{
+    // Shutdown 뒤에는 워커가 배치를 붙잡고 있어도 결과를 받지 않는다
+    if (!Results.IsValidIndex(Index))
+        return;
+
+    Results[Index].Reset(Texture);
+    ReadyIndices.Add(Index);
+}
+
+bool FImageBatchLoad::Tick(float DeltaTime)
+{
+    const int32 NumFinishedBefore = NumFinished;
+
+    // 1. 디코드가 끝난 순서대로 프레임 예산만큼 텍스처 생성 (최소 한 장)
+    //    캐시가 이 항목과 같은 파일을 기다리던 요청 모두에 결과를 넘기며, 이 배치의 몫은 OnTextureReady 로 들어온다
+    FTextureCache& Cache = FTextureCache::Get();
+    int64 UploadedBytes = 0;
+    FDecodedItem Item;
+    while (UploadedBytes < MaxUploadBytesPerFrame && Decoded.Dequeue(Item))
+    {
+        Cache.FinishLoad(FilePaths[Item.Index], bGenerateMips, LoadIds[Item.Index], *Item.Image);
+        UploadedBytes += Item.Image->GetNumBytes();
+        Item.Image.Reset();
+        InFlightBytes.fetch_sub(Item.ReservedBytes);
+    }
+
+    // 2. 캐시 적중, 다른 곳의 디코드, 이 배치의 업로드로 받은 결과를 전달
+    for (const int32 Index : ReadyIndices)
+    {
+        UTexture2D* Texture = Results[Index].Get();
+        ++NumFinished;
+        OnItemLoaded.ExecuteIfBound(Index, Texture ? 0 : -1, Texture);
+    }
+    ReadyIndices.Reset();
+
+    // 3. 업로드로 여유가 생겼으면 멈춘 워커를 다시 띄운다
+    DispatchWorkers();
+
+    if (NumFinished != NumFinishedBefore)
+    {
+        OnProgress.ExecuteIfBound(static_cast<float>(NumFinished) / FilePaths.Num());
+    }
+
+    if (NumFinished < FilePaths.Num())
+    {
+        return true;
+    }
+
+    // 4. 입력 순서대로 전체 결과 전달 후 틱 해제
+    TArray<UTexture2D*> Textures;
+    Textures.Reserve(Results.Num());
+    for (const TStrongObjectPtr<UTexture2D>& Result : Results)
+    {
+        Textures.Add(Result.Get());
+    }
+    OnBatchResult.ExecuteIfBound(Textures);
+    Results.Reset();
+    FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+    TickerHandle.Reset();
+    return false;
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/StrongObjectPtr.h"
+#include "LIB_Export.h"
+#include "LIB_ImageLoader.h"
+#include <atomic>
+
+/**
+ * 여러 이미지 파일을 제한된 수의 워커로 디코드하고, 끝난 순서대로 프레임당 업로드 예산만큼 텍스처로 만들어 넘기는 배치.
+ * 워커는 파일을 읽은 뒤 헤더로 계산한 디코드 크기를 예산에서 먼저 잡고 디코드하며, 업로드가 끝나면 돌려줍니다.
+ * 잡을 수 없으면 그 파일은 미뤄 두고 멈추므로, 디코드 중이거나 업로드를 기다리는 바이트는 MaxInFlightBytes 를 넘지 않습니다.
+ * (예산보다 큰 이미지 하나는 다른 것이 없을 때만 진행)
+ * 요청은 텍스처 캐시를 거칩니다. 캐시에 있으면 디코드 없이 넘기고, 같은 파일을 다른 곳(ConvetFileToTextureAsync, 다른 배치)에서
+ * 디코드 중이면 그 결과를 받으며, 이 배치가 디코드한 결과도 캐시를 통해 기다리던 요청 모두에 나눠 줍니다.
+ */
+class FImageBatchLoad : public TSharedFromThis<FImageBatchLoad, ESPMode::ThreadSafe>
+{
+public:
+	FImageBatchLoad(
+		TArray<FString>&& InFilePaths,
+		bool bInGenerateMips,
+		const ULIB_Export::FOnTextureProgress& InOnProgress,
+		const ULIB_Export::FOnTextureBatchItem& InOnItemLoaded,
+		const ULIB_Export::FOnTextureBatchResult& InOnBatchResult);
+
+	/**
+	 * 워커를 시작하고 게임 스레드 틱을 등록합니다. 게임 스레드에서 호출해야 합니다.
+	 * @param MaxWorkers 동시에 디코드할 최대 파일 수. 0 이하이면 워커 스레드 수만큼 사용합니다.
+	 * @param InMaxInFlightBytes 디코드 후 업로드를 기다리는 바이트 상한. 0 이하이면 제한 없음
+	 * @param InMaxUploadBytesPerFrame 프레임당 텍스처로 만들 바이트 예산 (최소 한 장). 0 이하이면 제한 없음
+	 */
+	void Start(int32 MaxWorkers, int64 InMaxInFlightBytes, int64 InMaxUploadBytesPerFrame);
+
+private:
+	struct FDecodedItem
+	{
+		int32 Index = INDEX_NONE;
+		int64 ReservedBytes = 0;
+		TSharedPtr<FDecodedImage, ESPMode::ThreadSafe> Image;
+	};
+
+	// 게임 스레드: 한도 안에서 워커를 더 띄운다
+	void DispatchWorkers();
+	// 스레드 풀: 예산을 잡지 못하거나 파일이 떨어질 때까지 이어서 디코드
+	void RunWorker();
+	// 아무 스레드: 비어 있으면(최소 한 장) 또는 남은 예산 안이면 NumBytes 를 잡는다
+	bool TryReserve(int64 NumBytes);
+	// 게임 스레드: 텍스처 캐시가 넘겨준 결과 (다음 틱에 전달)
+	void OnTextureReady(int32 Index, UTexture2D* Texture);
+	bool Tick(float DeltaTime);
+	// 엔진 종료 전: 티커를 해제하고 새 디코드를 멈춘 뒤 결과를 놓는다
+	void Shutdown();
+
+	const TArray<FString> FilePaths;
+	const bool bGenerateMips;
+
+	ULIB_Export::FOnTextureProgress OnProgress;
+	ULIB_Export::FOnTextureBatchItem OnItemLoaded;
+	ULIB_Export::FOnTextureBatchResult OnBatchResult;
+
+	int32 MaxWorkers = 0;
+	int64 MaxInFlightBytes = 0;
+	int64 MaxUploadBytesPerFrame = 0;
+
+	// 이 배치가 디코드를 맡은 항목과 캐시의 요청 번호 (Start 이후 읽기 전용)
+	TArray<int32> PendingIndices;
+	TArray<uint64> LoadIds;
+	std::atomic<int32> NextPending{ 0 };
+	std::atomic<int32> NumActiveWorkers{ 0 };
+	std::atomic<int64> InFlightBytes{ 0 };
+	TQueue<FDecodedItem, EQueueMode::Mpsc> Decoded;
+
+	// 예산을 잡지 못해 미뤄 둔 항목 (다음에 띄운 워커가 먼저 처리)
+	FCriticalSection DeferredLock;
+	TArray<int32> DeferredIndices;
+	std::atomic<int32> NumDeferred{ 0 };
+
+	// 게임 스레드 전용 상태
+	TArray<int32> ReadyIndices;	// 캐시가 결과를 넘겨줬지만 아직 전달하지 않은 항목
+	TArray<TStrongObjectPtr<UTexture2D>> Results;
+	int32 NumFinished = 0;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreExitHandle;
+};
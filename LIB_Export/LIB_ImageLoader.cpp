@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_ImageLoader.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+    IImageWrapperModule& GetImageWrapperModule()
+    {
+        return FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    }
+
+    // 밉 하나를 2x2 박스 필터로 줄인다. 홀수 크기는 가장자리 텍셀을 다시 사용
+    template<typename TexelType, typename AverageFunctionType>
+    void DownsampleMip(const TArray64<uint8>& Source, const int32 SourceWidth, const int32 SourceHeight, TArray64<uint8>& Dest, const AverageFunctionType& Average)
+    {
+        const int32 DestWidth = FMath::Max(1, SourceWidth >> 1);
+        const int32 DestHeight = FMath::Max(1, SourceHeight >> 1);
+        Dest.SetNumUninitialized(static_cast<int64>(DestWidth) * DestHeight * sizeof(TexelType));
+
+        const TexelType* Src = reinterpret_cast<const TexelType*>(Source.GetData());
+        TexelType* Dst = reinterpret_cast<TexelType*>(Dest.GetData());
+        ParallelFor(DestHeight, [=](int32 Y)
+            {
+                const int32 Y0 = FMath::Min(Y * 2, SourceHeight - 1);
+                const int32 Y1 = FMath::Min(Y * 2 + 1, SourceHeight - 1);
+                for (int32 X = 0; X < DestWidth; ++X)
+                {
+                    const int32 X0 = FMath::Min(X * 2, SourceWidth - 1);
+                    const int32 X1 = FMath::Min(X * 2 + 1, SourceWidth - 1);
+                    Dst[static_cast<int64>(Y) * DestWidth + X] = Average(
+                        Src[static_cast<int64>(Y0) * SourceWidth + X0], Src[static_cast<int64>(Y0) * SourceWidth + X1],
+                        Src[static_cast<int64>(Y1) * SourceWidth + X0], Src[static_cast<int64>(Y1) * SourceWidth + X1]);
+                }
+            });
+    }
+}
+
+int64 FDecodedImage::GetNumBytes() const
+{
+    int64 NumBytes = 0;
+    for (const TArray64<uint8>& Mip : Mips)
+    {
+        NumBytes += Mip.Num();
+    }
+    return NumBytes;
+}
+
+namespace LIB_ImageLoader
+{
+    void LoadImageWrapperModule()
+    {
+        check(IsInGameThread());
+        FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    }
+
+    bool DecodeImage(TArrayView64<const uint8> FileData, const bool bGenerateMips, FDecodedImage& OutImage, const TCHAR* DebugName)
+    {
+        OutImage = FDecodedImage();
+
+        // 1. 헤더로 형식 판별
+        IImageWrapperModule& ImageWrapperModule = GetImageWrapperModule();
+        const EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(FileData.GetData(), FileData.Num());
+        if (ImageFormat != EImageFormat::PNG && ImageFormat != EImageFormat::JPEG && ImageFormat != EImageFormat::BMP && ImageFormat != EImageFormat::EXR)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unsupported image format: %s"), DebugName);
+            return false;
+        }
+
+        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+        if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to initialize ImageWrapper or set compressed data: %s"), DebugName);
+            return false;
+        }
+
+        // 2. 디코드 (EXR 은 선형 half float, 나머지는 sRGB BGRA8)
+        const bool bHDR = ImageFormat == EImageFormat::EXR;
+        TArray64<uint8> RawData;
+        if (!ImageWrapper->GetRaw(bHDR ? ERGBFormat::RGBAF : ERGBFormat::BGRA, bHDR ? 16 : 8, RawData))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to extract raw data from image: %s"), DebugName);
+            return false;
+        }
+
+        OutImage.Width = static_cast<int32>(ImageWrapper->GetWidth());
+        OutImage.Height = static_cast<int32>(ImageWrapper->GetHeight());
+        OutImage.PixelFormat = bHDR ? PF_FloatRGBA : PF_B8G8R8A8;
+        OutImage.bSRGB = !bHDR;
+        OutImage.Mips.Add(MoveTemp(RawData));
+
+        // 3. 밉 체인
+        if (bGenerateMips)
+        {
+            GenerateMips(OutImage);
+        }
+        return true;
+    }
+
+    int64 GetDecodedNumBytes(TArrayView64<const uint8> FileData, const bool bGenerateMips)
+    {
+        // 헤더만 읽는다 (실패는 이어지는 DecodeImage 가 로그로 남김)
+        IImageWrapperModule& ImageWrapperModule = GetImageWrapperModule();
+        const EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(FileData.GetData(), FileData.Num());
+        if (ImageFormat != EImageFormat::PNG && ImageFormat != EImageFormat::JPEG && ImageFormat != EImageFormat::BMP && ImageFormat != EImageFormat::EXR)
+        {
+            return 0;
+        }
+        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+        if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
+        {
+            return 0;
+        }
+
+        // DecodeImage 와 같은 픽셀 형식, GenerateMips 와 같은 밉 크기
+        const int64 BytesPerTexel = ImageFormat == EImageFormat::EXR ? sizeof(FFloat16Color) : sizeof(FColor);
+        int64 Width = ImageWrapper->GetWidth();
+        int64 Height = ImageWrapper->GetHeight();
+        int64 NumBytes = Width * Height * BytesPerTexel;
+        while (bGenerateMips && (Width > 1 || Height > 1))
+        {
+            Width = FMath::Max<int64>(1, Width >> 1);
+            Height = FMath::Max<int64>(1, Height >> 1);
+            NumBytes += Width * Height * BytesPerTexel;
+        }
+        return NumBytes;
+    }
+
+    bool DecodeImageFile(const FString& FilePath, const bool bGenerateMips, FDecodedImage& OutImage)
+    {
+        TArray64<uint8> FileData;
+        if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to load file data from %s"), *FilePath);
+            return false;
+        }
+        return DecodeImage(FileData, bGenerateMips, OutImage, *FilePath);
+    }
+
+    void GenerateMips(FDecodedImage& Image)
+    {
+        if (!Image.IsValid() || Image.Mips.Num() != 1)
+        {
+            return;
+        }
+
+        int32 Width = Image.Width;
+        int32 Height = Image.Height;
+        while (Width > 1 || Height > 1)
+        {
+            TArray64<uint8> Mip;
+            if (Image.PixelFormat == PF_FloatRGBA)
+            {
+                DownsampleMip<FFloat16Color>(Image.Mips.Last(), Width, Height, Mip,
+                    [](const FFloat16Color& A, const FFloat16Color& B, const FFloat16Color& C, const FFloat16Color& D)
+                    {
+                        return FFloat16Color((FLinearColor(A) + FLinearColor(B) + FLinearColor(C) + FLinearColor(D)) * 0.25f);
+                    });
+            }
+            else
+            {
+                // sRGB 값을 그대로 평균 (UI 용 축소에는 충분하고 변환 비용이 없음)
+                DownsampleMip<FColor>(Image.Mips.Last(), Width, Height, Mip,
+                    [](const FColor& A, const FColor& B, const FColor& C, const FColor& D)
+                    {
+                        return FColor(
+                            static_cast<uint8>((A.R + B.R + C.R + D.R + 2) >> 2),
+                            static_cast<uint8>((A.G + B.G + C.G + D.G + 2) >> 2),
+                            static_cast<uint8>((A.B + B.B + C.B + D.B + 2) >> 2),
+                            static_cast<uint8>((A.A + B.A + C.A + D.A + 2) >> 2));
+                    });
+            }
+            Image.Mips.Add(MoveTemp(Mip));
+            Width = FMath::Max(1, Width >> 1);
+            Height = FMath::Max(1, Height >> 1);
+        }
+    }
+
+    UTexture2D* CreateTexture(const FDecodedImage& Image)
+    {
+        check(IsInGameThread());
+
+        if (!Image.IsValid())
+        {
+            return nullptr;
+        }
+
+        UTexture2D* Texture = UTexture2D::CreateTransient(Image.Width, Image.Height, Image.PixelFormat);
+        if (!Texture)
+        {
+            return nullptr;
+        }
+        Texture->SRGB = Image.bSRGB;
+        Texture->NeverStream = true;
+        if (Image.PixelFormat == PF_FloatRGBA)
+        {
+            Texture->CompressionSettings = TC_HDR;
+        }
+
+        // 밉마다 BulkData 에 복사 (CreateTransient 는 Mips[0] 만 만든다)
+        FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+        int32 Width = Image.Width;
+        int32 Height = Image.Height;
+        for (int32 MipIndex = 0; MipIndex < Image.Mips.Num(); ++MipIndex)
+        {
+            if (MipIndex > 0)
+            {
+                Width = FMath::Max(1, Width >> 1);
+                Height = FMath::Max(1, Height >> 1);
+                PlatformData->Mips.Add(new FTexture2DMipMap(Width, Height));
+            }
+
+            const TArray64<uint8>& MipData = Image.Mips[MipIndex];
+            FByteBulkData& BulkData = PlatformData->Mips[MipIndex].BulkData;
+            BulkData.Lock(LOCK_READ_WRITE);
+            void* TextureData = BulkData.Realloc(MipData.Num());
+            FMemory::Memcpy(TextureData, MipData.GetData(), MipData.Num());
+            BulkData.Unlock();
+        }
+
+        Texture->UpdateResource();
+        return Texture;
+    }
+
+    void LoadTextureAsync(const FString& FilePath, const bool bGenerateMips, TUniqueFunction<void(UTexture2D*)>&& OnLoaded)
+    {
+        LoadImageWrapperModule();
+
+        Async(EAsyncExecution::ThreadPool, [FilePath, bGenerateMips, OnLoaded = MoveTemp(OnLoaded)]() mutable
+            {
+                TSharedRef<FDecodedImage, ESPMode::ThreadSafe> Image = MakeShared<FDecodedImage, ESPMode::ThreadSafe>();
+                DecodeImageFile(FilePath, bGenerateMips, *Image);
+
+                AsyncTask(ENamedThreads::GameThread, [Image, OnLoaded = MoveTemp(OnLoaded)]() mutable
+                    {
+                        OnLoaded(CreateTexture(*Image));
+                    });
+            });
+    }
+}
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+class UTexture2D;
+
+// 워커에서 디코드한 이미지. 게임 스레드에서 CreateTexture 로 업로드합니다.
+struct FDecodedImage
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	EPixelFormat PixelFormat = PF_Unknown;	// PF_B8G8R8A8 또는 PF_FloatRGBA (EXR)
+	bool bSRGB = true;
+	TArray<TArray64<uint8>> Mips;			// Mips[0] 이 원본 크기
+
+	bool IsValid() const { return Width > 0 && Height > 0 && Mips.Num() > 0; }
+	int64 GetNumBytes() const;
+};
+
+/**
+ * 이미지 파일 읽기와 디코드는 아무 스레드에서나, 텍스처 생성과 업로드는 게임 스레드에서 하도록 나눈 로더.
+ * 형식은 확장자가 아니라 파일 헤더로 판별합니다 (PNG / JPEG / BMP / EXR).
+ */
+namespace LIB_ImageLoader
+{
+	// ImageWrapper 모듈을 로드합니다. 워커에서 디코드하기 전에 게임 스레드에서 한 번 호출해야 합니다.
+	void LoadImageWrapperModule();
+
+	// 아무 스레드. 실패하면 로그를 남기고 false
+	bool DecodeImage(TArrayView64<const uint8> FileData, bool bGenerateMips, FDecodedImage& OutImage, const TCHAR* DebugName = TEXT(""));
+	bool DecodeImageFile(const FString& FilePath, bool bGenerateMips, FDecodedImage& OutImage);
+
+	// 아무 스레드. 헤더만 읽어 DecodeImage 결과(밉 포함)의 바이트 수를 계산합니다. 읽을 수 없는 파일이면 0
+	int64 GetDecodedNumBytes(TArrayView64<const uint8> FileData, bool bGenerateMips);
+
+	// 2x2 박스 필터로 1x1 까지의 밉 체인을 만듭니다 (Mips[0] 만 있어야 함)
+	void GenerateMips(FDecodedImage& Image);
+
+	// 게임 스레드 전용. 모든 밉을 담은 트랜지언트 텍스처
+	UTexture2D* CreateTexture(const FDecodedImage& Image);
+
+	// 파일 읽기와 디코드(및 밉 생성)는 스레드 풀에서, 텍스처 생성은 게임 스레드에서 하고 OnLoaded 를 호출합니다. (게임 스레드 전용)
+	void LoadTextureAsync(const FString& FilePath, bool bGenerateMips, TUniqueFunction<void(UTexture2D*)>&& OnLoaded);
+}
@@ -0,0 +1,587 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_IncrementalConvert.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /**
+     * Triangles 중 인덱스가 유효한 삼각형과 그 정점만 모아 번호를 새로 매긴 메시를 만든다. (있는 속성만 복사)
+     * OutVertices 는 원래 정점 번호 오름차순이며, 삼각형은 Triangles 순서를 유지한다.
+     */
+    void GatherSubmesh(const FProcMeshData& MeshData, TConstArrayView<int32> Triangles, TArray<int32>& OutVertices, FProcMeshData& OutMesh)
+    {
+        const int32 NumVertices = MeshData.Vertices.Num();
+
+        // 1. 쓰는 정점을 모아 정렬 후 중복 제거 (잘못된 인덱스를 쓰는 삼각형은 뺀다)
+        TArray<int32> ValidTriangles;
+        ValidTriangles.Reserve(Triangles.Num());
+        OutVertices.Reset(Triangles.Num() * 3);
+        for (const int32 Triangle : Triangles)
+        {
+            const int32* Corners = &MeshData.Triangles[Triangle * 3];
+            if (Corners[0] >= 0 && Corners[0] < NumVertices && Corners[1] >= 0 && Corners[1] < NumVertices && Corners[2] >= 0 && Corners[2] < NumVertices)
+            {
+                ValidTriangles.Add(Triangle);
+                OutVertices.Append(Corners, 3);
+            }
+        }
+        OutVertices.Sort();
+        int32 NumUnique = 0;
+        for (int32 i = 0; i < OutVertices.Num(); ++i)
+        {
+            if (i == 0 || OutVertices[i] != OutVertices[NumUnique - 1])
+            {
+                OutVertices[NumUnique++] = OutVertices[i];
+            }
+        }
+        OutVertices.SetNum(NumUnique, false);
+
+        // 2. 속성과 새 번호의 인덱스
+        auto GatherAttribute = [&OutVertices, NumVertices](const auto& Source, auto& Dest)
+        {
+            if (Source.Num() == NumVertices)
+            {
+                Dest.SetNumUninitialized(OutVertices.Num());
+                for (int32 i = 0; i < OutVertices.Num(); ++i)
+                {
+                    Dest[i] = Source[OutVertices[i]];
+                }
+            }
+        };
+        GatherAttribute(MeshData.Vertices, OutMesh.Vertices);
+        GatherAttribute(MeshData.Normals, OutMesh.Normals);
+        GatherAttribute(MeshData.UV0, OutMesh.UV0);
+        GatherAttribute(MeshData.VertexColors, OutMesh.VertexColors);
+        GatherAttribute(MeshData.Tangents, OutMesh.Tangents);
+
+        OutMesh.Triangles.SetNumUninitialized(ValidTriangles.Num() * 3);
+        for (int32 i = 0; i < ValidTriangles.Num(); ++i)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                OutMesh.Triangles[i * 3 + Corner] = Algo::LowerBound(OutVertices, MeshData.Triangles[ValidTriangles[i] * 3 + Corner]);
+            }
+        }
+    }
+}
+
+bool FProcMeshIncrementalState::Initialize(FProcMeshData&& InMeshData, const FProcMeshConvertOptions& InOptions)
+{
+    if (!LIB_MeshProcessing::IsValidMeshData(InMeshData))
+    {
+        return false;
+    }
+
+    // 1. 구간 빌드 옵션: 정점 배열을 바꾸거나 메시 전체 단위로만 의미 있는 단계는 끈다
+    //    법선, UV 투영, 탄젠트는 구간 안에서 만들면 경계 정점마다 값이 달라지므로 이 상태가 메시 전체 기준으로 만든다
+    if (InOptions.bRepairMesh || (InOptions.bRecalculateNormal && InOptions.bUseCreaseAngle) || InOptions.NumLODs > 1 || InOptions.bUseCache)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FProcMeshIncrementalState: bRepairMesh, crease angle, LODs and the convert cache are ignored in incremental mode (normals, generated UVs and tangents are computed on the whole mesh)."));
+    }
+    SectionOptions = InOptions;
+    SectionOptions.bRepairMesh = false;
+    SectionOptions.bRecalculateNormal = false;
+    SectionOptions.bUseCreaseAngle = false;
+    SectionOptions.NumLODs = 1;
+    SectionOptions.bSplitSections = false;
+    SectionOptions.bUseCache = false;
+    SectionOptions.bUseDiskCache = false;
+    SectionOptions.bGenerateTangents = false;
+    NormalWeighting = InOptions.NormalWeighting;
+    bMaintainNormals = InOptions.bRecalculateNormal;
+    bMaintainUVs = InMeshData.UV0.Num() == 0;
+    bMaintainTangents = InOptions.bGenerateTangents;
+    // 박스 투영은 정점 법선을 쓰므로, 법선이 없으면 GenerateUVs 처럼 면적 가중 법선을 따로 들고 갱신한다
+    bProjectionNormals = bMaintainUVs && InOptions.UVProjection == EProcUVProjection::Box && !bMaintainNormals
+        && InMeshData.Normals.Num() != InMeshData.Vertices.Num();
+    if (bProjectionNormals)
+    {
+        NormalWeighting = EProcNormalWeighting::Area;
+    }
+
+    MeshData = MoveTemp(InMeshData);
+    NumVertices = MeshData.Vertices.Num();
+    NumTriangles = MeshData.Triangles.Num() / 3;
+
+    // 2. 역참조와 법선, UV, 탄젠트
+    AdjacencyIndices = MeshData.Triangles;
+    PatchedSlots.Init(INDEX_NONE, NumVertices);
+    PatchedVertices.Reset();
+    RebuildAdjacency();
+    RecomputeAllAttributes();
+
+    // 3. 공간적으로 가까운 삼각형끼리 구간을 나눈다 (이후 삼각형의 구간은 바뀌지 않음)
+    LIB_MeshProcessing::PartitionTriangles(MeshData, SectionOptions.MaxSectionVertices, SectionTriangles);
+    TriangleSections.SetNumUninitialized(NumTriangles);
+    for (int32 Section = 0; Section < SectionTriangles.Num(); ++Section)
+    {
+        for (const int32 Triangle : SectionTriangles[Section])
+        {
+            TriangleSections[Triangle] = Section;
+        }
+    }
+
+    DirtyVertices.Reset();
+    DirtyTriangles.Reset();
+    bVertexDirty.Init(false, NumVertices);
+    bTriangleDirty.Init(false, NumTriangles);
+    bFaceScratch.Init(false, NumTriangles);
+    bVertexScratch.Init(false, NumVertices);
+    bRebuildAll = true;
+    bRecomputeAll = false;
+    return true;
+}
+
+void FProcMeshIncrementalState::MarkVerticesDirty(int32 FirstVertex, int32 NumDirtyVertices)
+{
+    const int32 Begin = FMath::Max(FirstVertex, 0);
+    const int32 End = FMath::Min(FirstVertex + FMath::Max(NumDirtyVertices, 0), NumVertices);
+    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+    {
+        AddDirtyVertex(Vertex);
+    }
+}
+
+void FProcMeshIncrementalState::MarkTrianglesDirty(int32 FirstTriangle, int32 NumDirtyTriangles)
+{
+    const int32 Begin = FMath::Max(FirstTriangle, 0);
+    const int32 End = FMath::Min(FirstTriangle + FMath::Max(NumDirtyTriangles, 0), NumTriangles);
+    for (int32 Triangle = Begin; Triangle < End; ++Triangle)
+    {
+        if (!bTriangleDirty[Triangle])
+        {
+            bTriangleDirty[Triangle] = true;
+            DirtyTriangles.Add(Triangle);
+        }
+    }
+}
+
+void FProcMeshIncrementalState::MarkAllDirty()
+{
+    bRebuildAll = true;
+    bRecomputeAll = true;
+}
+
+void FProcMeshIncrementalState::AddDirtyVertex(int32 Vertex)
+{
+    if (Vertex >= 0 && Vertex < NumVertices && !bVertexDirty[Vertex])
+    {
+        bVertexDirty[Vertex] = true;
+        DirtyVertices.Add(Vertex);
+    }
+}
+
+TConstArrayView<int32> FProcMeshIncrementalState::GetCorners(int32 Vertex) const
+{
+    const int32 Slot = PatchedSlots[Vertex];
+    return Slot == INDEX_NONE ? Adjacency.GetCorners(Vertex) : TConstArrayView<int32>(PatchedCorners[Slot]);
+}
+
+void FProcMeshIncrementalState::MoveCorner(int32 Corner, int32 OldIndex, int32 NewIndex)
+{
+    // 처음 바뀌는 정점은 CSR 목록을 복사해 패치를 만든다
+    auto GetPatch = [this](const int32 Vertex) -> TArray<int32>&
+    {
+        int32& Slot = PatchedSlots[Vertex];
+        if (Slot == INDEX_NONE)
+        {
+            const TConstArrayView<int32> Corners = Adjacency.GetCorners(Vertex);
+            Slot = PatchedCorners.Num();
+            PatchedVertices.Add(Vertex);
+            PatchedCorners.Emplace(Corners.GetData(), Corners.Num());
+        }
+        return PatchedCorners[Slot];
+    };
+
+    // Build 와 같은 오름차순을 유지해야 법선 합산 순서가 전체 재계산과 같다
+    if (OldIndex >= 0 && OldIndex < NumVertices)
+    {
+        TArray<int32>& Corners = GetPatch(OldIndex);
+        const int32 Position = Algo::BinarySearch(Corners, Corner);
+        if (Position != INDEX_NONE)
+        {
+            Corners.RemoveAt(Position, 1, false);
+        }
+    }
+    if (NewIndex >= 0 && NewIndex < NumVertices)
+    {
+        TArray<int32>& Corners = GetPatch(NewIndex);
+        Corners.Insert(Corner, Algo::LowerBound(Corners, Corner));
+    }
+}
+
+void FProcMeshIncrementalState::RebuildAdjacency()
+{
+    Adjacency.Build(NumVertices, AdjacencyIndices);
+    for (const int32 Vertex : PatchedVertices)
+    {
+        PatchedSlots[Vertex] = INDEX_NONE;
+    }
+    PatchedVertices.Reset();
+    PatchedCorners.Reset();
+}
+
+void FProcMeshIncrementalState::RecomputeAllAttributes()
+{
+    // 박스 투영이 갱신된 법선을, 탄젠트가 갱신된 UV/법선을 쓰도록 PrepareMeshData 와 같은 순서로 계산
+    if (ComputesNormals())
+    {
+        RecomputeAllNormals();
+    }
+    if (bMaintainUVs)
+    {
+        FProcMeshDataView View(MeshData);
+        if (bProjectionNormals)
+        {
+            View.Normals = ProjectionNormals;
+        }
+        LIB_MeshProcessing::GenerateUVs(View, SectionOptions, MeshData.UV0);
+    }
+    if (bMaintainTangents)
+    {
+        LIB_MeshProcessing::GenerateTangents(MeshData, MeshData.Tangents);
+    }
+}
+
+void FProcMeshIncrementalState::RecomputeAllNormals()
+{
+    LIB_MeshProcessing::ComputeFaceNormals(TConstArrayView<FVector>(MeshData.Vertices), AdjacencyIndices, NormalWeighting, Faces);
+
+    TArray<FVector3f> Normals;
+    Normals.SetNumUninitialized(NumVertices);
+    LIB_MeshProcessing::ComputeVertexNormals(Faces, Adjacency, Normals);
+
+    TArray<FVector>& OutNormals = GetComputedNormals();
+    OutNormals.SetNumUninitialized(NumVertices);
+    LIB_MeshProcessing::ParallelForRange(NumVertices, [&OutNormals, &Normals](int32 Begin, int32 End)
+        {
+            for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+            {
+                OutNormals[Vertex] = FVector(Normals[Vertex]);
+            }
+        });
+}
+
+void FProcMeshIncrementalState::RecomputeLocalNormals(TArray<int32>& OutNormalVertices)
+{
+    // 1. 바뀐 삼각형과 바뀐 정점에 닿는 삼각형
+    TArray<int32> AffectedFaces;
+    auto AddFace = [this, &AffectedFaces](const int32 Triangle)
+    {
+        if (!bFaceScratch[Triangle])
+        {
+            bFaceScratch[Triangle] = true;
+            AffectedFaces.Add(Triangle);
+        }
+    };
+    for (const int32 Triangle : DirtyTriangles)
+    {
+        AddFace(Triangle);
+    }
+    for (const int32 Vertex : DirtyVertices)
+    {
+        for (const int32 Corner : GetCorners(Vertex))
+        {
+            AddFace(Corner / 3);
+        }
+    }
+
+    // 2. 그 삼각형들의 면 법선만 모아서 계산한 뒤 제자리에 돌려놓는다
+    TArray<int32> FaceIndices;
+    FaceIndices.SetNumUninitialized(AffectedFaces.Num() * 3);
+    for (int32 i = 0; i < AffectedFaces.Num(); ++i)
+    {
+        FMemory::Memcpy(&FaceIndices[i * 3], &AdjacencyIndices[AffectedFaces[i] * 3], 3 * sizeof(int32));
+    }
+    LIB_MeshProcessing::FFaceNormals LocalFaces;
+    LIB_MeshProcessing::ComputeFaceNormals(TConstArrayView<FVector>(MeshData.Vertices), FaceIndices, NormalWeighting, LocalFaces);
+    for (int32 i = 0; i < AffectedFaces.Num(); ++i)
+    {
+        const int32 Triangle = AffectedFaces[i];
+        Faces.Normals[Triangle] = LocalFaces.Normals[i];
+        FMemory::Memcpy(&Faces.CornerWeights[Triangle * 3], &LocalFaces.CornerWeights[i * 3], 3 * sizeof(float));
+    }
+
+    // 3. 법선이 바뀌는 정점: 그 삼각형들의 정점과 (삼각형이 떨어져 나간) 표시된 정점
+    OutNormalVertices.Reset();
+    auto AddVertex = [this, &OutNormalVertices](const int32 Vertex)
+    {
+        if (Vertex >= 0 && Vertex < NumVertices && !bVertexScratch[Vertex])
+        {
+            bVertexScratch[Vertex] = true;
+            OutNormalVertices.Add(Vertex);
+        }
+    };
+    for (const int32 Index : FaceIndices)
+    {
+        AddVertex(Index);
+    }
+    for (const int32 Vertex : DirtyVertices)
+    {
+        AddVertex(Vertex);
+    }
+
+    TArray<FVector>& Normals = GetComputedNormals();
+    LIB_MeshProcessing::ParallelForRange(OutNormalVertices.Num(), [this, &OutNormalVertices, &Normals](int32 Begin, int32 End)
+        {
+            for (int32 i = Begin; i < End; ++i)
+            {
+                const int32 Vertex = OutNormalVertices[i];
+                FVector3f Sum = FVector3f::ZeroVector;
+                for (const int32 Corner : GetCorners(Vertex))
+                {
+                    Sum += Faces.Normals[Corner / 3] * Faces.CornerWeights[Corner];
+                }
+                Normals[Vertex] = FVector(Sum.GetSafeNormal());
+            }
+        });
+
+    for (const int32 Triangle : AffectedFaces)
+    {
+        bFaceScratch[Triangle] = false;
+    }
+    for (const int32 Vertex : OutNormalVertices)
+    {
+        bVertexScratch[Vertex] = false;
+    }
+}
+
+void FProcMeshIncrementalState::ProjectLocalUVs(TConstArrayView<int32> Vertices)
+{
+    // 바뀐 정점만 모은 삼각형 없는 메시로 투영한다 (박스 투영이면 그 정점들의 법선도 함께)
+    if (Vertices.Num() == 0)
+    {
+        return;
+    }
+    const TArray<FVector>& Normals = bProjectionNormals ? ProjectionNormals : MeshData.Normals;
+    const bool bHasNormals = Normals.Num() == NumVertices;
+    FProcMeshData Subset;
+    Subset.Vertices.SetNumUninitialized(Vertices.Num());
+    if (bHasNormals)
+    {
+        Subset.Normals.SetNumUninitialized(Vertices.Num());
+    }
+    for (int32 i = 0; i < Vertices.Num(); ++i)
+    {
+        Subset.Vertices[i] = MeshData.Vertices[Vertices[i]];
+        if (bHasNormals)
+        {
+            Subset.Normals[i] = Normals[Vertices[i]];
+        }
+    }
+
+    TArray<FVector2D> UVs;
+    LIB_MeshProcessing::GenerateUVs(Subset, SectionOptions, UVs);
+    for (int32 i = 0; i < Vertices.Num(); ++i)
+    {
+        MeshData.UV0[Vertices[i]] = UVs[i];
+    }
+}
+
+void FProcMeshIncrementalState::RecomputeLocalTangents(TConstArrayView<int32> ChangedVertices, TArray<int32>& OutTangentVertices)
+{
+    // 1. 코너 탄젠트는 삼각형 세 정점의 위치/UV/법선으로 정해지므로 바뀐 정점에 닿는 삼각형의 정점은 모두 다시 계산한다
+    OutTangentVertices.Reset();
+    auto AddVertex = [this, &OutTangentVertices](const int32 Vertex)
+    {
+        if (Vertex >= 0 && Vertex < NumVertices && !bVertexScratch[Vertex])
+        {
+            bVertexScratch[Vertex] = true;
+            OutTangentVertices.Add(Vertex);
+        }
+    };
+    for (const int32 Vertex : ChangedVertices)
+    {
+        AddVertex(Vertex);
+        for (const int32 Corner : GetCorners(Vertex))
+        {
+            const int32 First = Corner - Corner % 3;
+            AddVertex(AdjacencyIndices[First]);
+            AddVertex(AdjacencyIndices[First + 1]);
+            AddVertex(AdjacencyIndices[First + 2]);
+        }
+    }
+
+    // 2. 그 정점들의 삼각형을 모두 모아 작은 메시로 계산한다
+    // 삼각형을 번호순으로 두면 정점별 합산 순서가 전체 계산과 같으므로 결과도 같다
+    TArray<int32> LocalFaces;
+    for (const int32 Vertex : OutTangentVertices)
+    {
+        for (const int32 Corner : GetCorners(Vertex))
+        {
+            const int32 Triangle = Corner / 3;
+            if (!bFaceScratch[Triangle])
+            {
+                bFaceScratch[Triangle] = true;
+                LocalFaces.Add(Triangle);
+            }
+        }
+    }
+    LocalFaces.Sort();
+
+    TArray<int32> LocalVertices;
+    FProcMeshData LocalMesh;
+    GatherSubmesh(MeshData, LocalFaces, LocalVertices, LocalMesh);
+    TArray<FProcMeshTangent> LocalTangents;
+    LIB_MeshProcessing::GenerateTangents(LocalMesh, LocalTangents);
+
+    // 3. 한 링이 모두 들어 있는 정점만 돌려놓는다 (삼각형이 없는 정점은 어느 구간에도 쓰이지 않음)
+    for (const int32 Vertex : OutTangentVertices)
+    {
+        const int32 Local = Algo::BinarySearch(LocalVertices, Vertex);
+        if (Local != INDEX_NONE)
+        {
+            MeshData.Tangents[Vertex] = LocalTangents[Local];
+        }
+    }
+
+    for (const int32 Triangle : LocalFaces)
+    {
+        bFaceScratch[Triangle] = false;
+    }
+    for (const int32 Vertex : OutTangentVertices)
+    {
+        bVertexScratch[Vertex] = false;
+    }
+}
+
+bool FProcMeshIncrementalState::BuildDirtySections(TArray<int32>& OutSections, TArray<FMeshDescription>& OutMeshDescs)
+{
+    OutSections.Reset();
+    OutMeshDescs.Reset();
+
+    if (MeshData.Vertices.Num() != NumVertices || MeshData.Triangles.Num() != NumTriangles * 3
+        || (bMaintainNormals && MeshData.Normals.Num() != NumVertices)
+        || (bMaintainUVs && MeshData.UV0.Num() != NumVertices)
+        || (bMaintainTangents && MeshData.Tangents.Num() != NumVertices))
+    {
+        UE_LOG(LogTemp, Error, TEXT("FProcMeshIncrementalState: vertex or triangle count changed since Initialize."));
+        return false;
+    }
+
+    TBitArray<> bSectionDirty(bRebuildAll, SectionTriangles.Num());
+
+    // 1. 인덱스가 바뀐 삼각형의 이전/새 정점은 모두 법선이 바뀔 수 있다 (역참조는 그 정점들의 코너 목록만 고친다)
+    for (const int32 Triangle : DirtyTriangles)
+    {
+        bSectionDirty[TriangleSections[Triangle]] = true;
+        for (int32 Corner = Triangle * 3; Corner < Triangle * 3 + 3; ++Corner)
+        {
+            const int32 OldIndex = AdjacencyIndices[Corner];
+            const int32 NewIndex = MeshData.Triangles[Corner];
+            if (OldIndex != NewIndex)
+            {
+                AddDirtyVertex(OldIndex);
+                AddDirtyVertex(NewIndex);
+                AdjacencyIndices[Corner] = NewIndex;
+                if (!bRecomputeAll)
+                {
+                    MoveCorner(Corner, OldIndex, NewIndex);
+                }
+            }
+        }
+    }
+    if (bRecomputeAll)
+    {
+        AdjacencyIndices = MeshData.Triangles;
+        RebuildAdjacency();
+    }
+    else if (PatchedVertices.Num() > NumVertices / 4)
+    {
+        // 패치가 많이 쌓이면 CSR 로 합친다 (전체 재빌드 비용을 여러 번의 편집에 나눠 갚음)
+        RebuildAdjacency();
+    }
+
+    // 2. 법선, UV, 탄젠트 갱신 후, 그 중 하나나 위치가 바뀐 정점을 쓰는 삼각형의 구간을 표시
+    TArray<int32> ChangedVertices;
+    if (bRecomputeAll)
+    {
+        RecomputeAllAttributes();
+    }
+    else
+    {
+        if (ComputesNormals())
+        {
+            RecomputeLocalNormals(ChangedVertices);
+        }
+        else
+        {
+            ChangedVertices = DirtyVertices;
+        }
+        if (bMaintainUVs)
+        {
+            ProjectLocalUVs(ChangedVertices);
+        }
+        if (bMaintainTangents)
+        {
+            TArray<int32> TangentVertices;
+            RecomputeLocalTangents(ChangedVertices, TangentVertices);
+            ChangedVertices = MoveTemp(TangentVertices);
+        }
+    }
+    if (!bRebuildAll)
+    {
+        for (const int32 Vertex : ChangedVertices)
+        {
+            for (const int32 Corner : GetCorners(Vertex))
+            {
+                bSectionDirty[TriangleSections[Corner / 3]] = true;
+            }
+        }
+    }
+
+    // 3. 표시 해제 (비트는 목록에 있는 것만 지운다)
+    for (const int32 Vertex : DirtyVertices)
+    {
+        bVertexDirty[Vertex] = false;
+    }
+    for (const int32 Triangle : DirtyTriangles)
+    {
+        bTriangleDirty[Triangle] = false;
+    }
+    DirtyVertices.Reset();
+    DirtyTriangles.Reset();
+    bRebuildAll = false;
+    bRecomputeAll = false;
+
+    // 4. 표시된 구간만 병렬로 MeshDescription 생성
+    for (TConstSetBitIterator<> It(bSectionDirty); It; ++It)
+    {
+        OutSections.Add(It.GetIndex());
+    }
+    OutMeshDescs.SetNum(OutSections.Num());
+    ParallelFor(OutSections.Num(), [this, &OutSections, &OutMeshDescs](int32 i)
+        {
+            BuildSection(OutSections[i], OutMeshDescs[i]);
+        });
+    return true;
+}
+
+void FProcMeshIncrementalState::BuildSection(int32 Section, FMeshDescription& OutMeshDesc) const
+{
+    // 1. 구간이 쓰는 정점과 삼각형만 모은 구간 메시 (잘못된 인덱스를 쓰는 삼각형은 뺀다)
+    TArray<int32> Vertices;
+    FProcMeshData SectionMesh;
+    GatherSubmesh(MeshData, SectionTriangles[Section], Vertices, SectionMesh);
+    if (SectionMesh.Triangles.Num() == 0)
+    {
+        return;
+    }
+
+    // 2. 정점 캐시 정렬은 구간 안에서 (법선, UV, 탄젠트는 전체 메시 기준으로 이미 계산되어 모아 왔음)
+    // 전처리에 실패한 구간은 전체 변환처럼 만들지 않는다 (빈 MeshDescription -> 구간 메시 nullptr)
+    if (!LIB_MeshProcessing::PrepareMeshData(SectionMesh, SectionOptions))
+    {
+        UE_LOG(LogTemp, Error, TEXT("FProcMeshIncrementalState: failed to prepare section %d."), Section);
+        return;
+    }
+    TArray<FMeshDescription> MeshDescs;
+    LIB_MeshProcessing::BuildLODMeshDescriptions(SectionMesh, SectionOptions, MeshDescs);
+    if (MeshDescs.Num() > 0)
+    {
+        OutMeshDesc = MoveTemp(MeshDescs[0]);
+    }
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MeshDescription.h"
+#include "LIB_Export.h"
+#include "LIB_MeshProcessing.h"
+
+/**
+ * 점진 변환 상태. 이전 변환의 정점 법선, 면 법선, 정점 -> 코너 역참조와 구간 분할을 들고 있다가
+ * 표시된 정점/삼각형 범위 주변의 법선만 다시 계산하고, 영향을 받은 구간의 MeshDescription 만 다시 만듭니다.
+ * 자동 생성하는 UV 와 탄젠트도 메시 전체 기준으로 들고 있다가 바뀐 정점 주변만 다시 계산하므로 구간 경계에서 값이 이어집니다.
+ * 구간마다 별도의 스태틱 메시가 되므로 갱신 비용은 메시 전체가 아니라 편집 크기(와 닿은 구간 크기)에 비례합니다.
+ * 정점 수와 삼각형 수는 Initialize 이후 바뀌면 안 됩니다. UObject 에 접근하지 않으므로 워커에서 써도 되지만 동시에 두 스레드에서 쓰면 안 됩니다.
+ */
+class FProcMeshIncrementalState
+{
+public:
+	/**
+	 * 전체 전처리를 하고 모든 구간을 빌드 대상으로 표시합니다. 구간은 Options.MaxSectionVertices 기준으로 항상 나눕니다.
+	 * 정점 배열을 바꾸는 옵션(bRepairMesh, 크리즈 분할)과 LOD, 변환 캐시는 점진 변환에서 쓰지 않습니다.
+	 * 입력에 UV0 가 없으면 UV 투영을, bGenerateTangents 면 탄젠트를 메시 전체에서 계산해 MeshData 에 채웁니다.
+	 * @return 입력이 유효하지 않으면 false
+	 */
+	bool Initialize(FProcMeshData&& InMeshData, const FProcMeshConvertOptions& InOptions);
+
+	// 직접 고친 뒤 MarkVerticesDirty / MarkTrianglesDirty 로 알려야 합니다. (배열 크기는 바꾸지 말 것)
+	// 이 상태가 만드는 법선(bRecalculateNormal), UV0(입력에 없었을 때), 탄젠트(bGenerateTangents)는 갱신 때 덮어씁니다.
+	FProcMeshData& GetMutableMeshData() { return MeshData; }
+	const FProcMeshData& GetMeshData() const { return MeshData; }
+
+	// 구간 빌드에 쓰는 옵션 (점진 변환에서 쓰지 않는 옵션은 꺼져 있음)
+	const FProcMeshConvertOptions& GetSectionOptions() const { return SectionOptions; }
+	int32 NumSections() const { return SectionTriangles.Num(); }
+
+	// 위치나 속성이 바뀐 정점 범위. 정점 범위를 벗어나는 부분은 무시합니다.
+	void MarkVerticesDirty(int32 FirstVertex, int32 NumDirtyVertices);
+	// 인덱스가 바뀐 삼각형 범위 (삼각형 단위)
+	void MarkTrianglesDirty(int32 FirstTriangle, int32 NumDirtyTriangles);
+	// 전체가 바뀐 경우. 법선과 역참조를 모두 다시 계산하고 모든 구간을 다시 만듭니다.
+	void MarkAllDirty();
+	bool IsDirty() const { return bRebuildAll || DirtyVertices.Num() > 0 || DirtyTriangles.Num() > 0; }
+
+	/**
+	 * 표시된 범위 주변의 법선을 갱신하고, 영향을 받은 구간의 MeshDescription 을 병렬로 만든 뒤 표시를 지웁니다.
+	 * 정리 후 삼각형이 없거나 전처리에 실패한 구간은 빈 MeshDescription 입니다.
+	 * @param OutSections 다시 만든 구간 번호 (오름차순)
+	 * @param OutMeshDescs OutSections 와 같은 순서의 MeshDescription
+	 * @return 정점 수나 삼각형 수가 Initialize 때와 다르면 false
+	 */
+	bool BuildDirtySections(TArray<int32>& OutSections, TArray<FMeshDescription>& OutMeshDescs);
+
+private:
+	void AddDirtyVertex(int32 Vertex);
+	// 패치된 목록이 있으면 그것을, 없으면 Adjacency 의 코너 목록 (코너 번호 오름차순)
+	TConstArrayView<int32> GetCorners(int32 Vertex) const;
+	// Corner 의 정점이 OldIndex 에서 NewIndex 로 바뀐 것을 두 정점의 코너 목록에만 반영
+	void MoveCorner(int32 Corner, int32 OldIndex, int32 NewIndex);
+	// AdjacencyIndices 로 CSR 역참조를 다시 만들고 패치를 비운다
+	void RebuildAdjacency();
+	// 이 상태가 계산하는 법선 (bRecalculateNormal 이면 MeshData.Normals, 박스 투영용이면 ProjectionNormals)
+	bool ComputesNormals() const { return bMaintainNormals || bProjectionNormals; }
+	TArray<FVector>& GetComputedNormals() { return bMaintainNormals ? MeshData.Normals : ProjectionNormals; }
+	// 이 상태가 관리하는 법선, UV, 탄젠트를 처음부터 다시 계산
+	void RecomputeAllAttributes();
+	// 면 법선과 정점 법선을 처음부터 다시 계산
+	void RecomputeAllNormals();
+	// 바뀐 정점에 닿는 삼각형의 면 법선과 그 삼각형들의 정점 법선만 다시 계산하고, 법선이 바뀐 정점을 돌려준다
+	void RecomputeLocalNormals(TArray<int32>& OutNormalVertices);
+	// 정점마다 독립인 UV 투영을 주어진 정점에만 다시 한다
+	void ProjectLocalUVs(TConstArrayView<int32> Vertices);
+	// 바뀐 정점에 닿는 삼각형의 정점 탄젠트를 다시 계산하고, 탄젠트를 다시 계산한 정점(ChangedVertices 포함)을 돌려준다
+	void RecomputeLocalTangents(TConstArrayView<int32> ChangedVertices, TArray<int32>& OutTangentVertices);
+	void BuildSection(int32 Section, FMeshDescription& OutMeshDesc) const;
+
+	FProcMeshData MeshData;
+	FProcMeshConvertOptions SectionOptions;
+	EProcNormalWeighting NormalWeighting = EProcNormalWeighting::Angle;
+	bool bMaintainNormals = false;	// Options.bRecalculateNormal 이면 법선을 이 상태가 관리한다
+	bool bMaintainUVs = false;		// 입력에 UV0 가 없으면 투영 UV 를 이 상태가 관리한다
+	bool bMaintainTangents = false;	// Options.bGenerateTangents 이면 탄젠트를 이 상태가 관리한다
+	bool bProjectionNormals = false;	// 법선 없이 박스 투영할 때 UV 에만 쓰는 면적 가중 법선을 관리한다
+	TArray<FVector> ProjectionNormals;
+	int32 NumVertices = 0;
+	int32 NumTriangles = 0;
+
+	// Adjacency 를 만든 시점의 인덱스 버퍼 (삼각형이 바뀌었을 때 이전 정점을 찾기 위함)
+	TArray<int32> AdjacencyIndices;
+	LIB_MeshProcessing::FVertexCornerAdjacency Adjacency;
+	// 마지막 RebuildAdjacency 이후 코너 목록이 바뀐 정점만 따로 들고 있는다 (삼각형 편집이 메시 크기가 아니라 편집 크기에 비례하도록)
+	TArray<int32> PatchedSlots;		// 정점 -> PatchedCorners 번호, 패치가 없으면 INDEX_NONE
+	TArray<int32> PatchedVertices;
+	TArray<TArray<int32>> PatchedCorners;
+	LIB_MeshProcessing::FFaceNormals Faces;
+
+	TArray<TArray<int32>> SectionTriangles;
+	TArray<int32> TriangleSections;
+
+	// 표시된 정점/삼각형. 비트 배열은 크기를 유지하고 목록에 있는 것만 지워 편집 크기에 비례하게 한다
+	TArray<int32> DirtyVertices;
+	TArray<int32> DirtyTriangles;
+	TBitArray<> bVertexDirty;
+	TBitArray<> bTriangleDirty;
+	TBitArray<> bFaceScratch;
+	TBitArray<> bVertexScratch;
+	bool bRebuildAll = false;		// 모든 구간 빌드
+	bool bRecomputeAll = false;		// 법선과 역참조 전체 재계산
+};
@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_MeshBuffer.h"
+#include "LIB_MeshProcessing.h"
+
+namespace
+{
+    // 일부만 채워진 속성은 정점 수만큼 늘리고 나머지를 기본값으로 채운다
+    template<typename SourceType, typename WriteFunc>
+    void ConvertAttribute(TConstArrayView<SourceType> Source, const int32 NumVertices, WriteFunc&& Write)
+    {
+        if (Source.Num() == 0)
+        {
+            return;
+        }
+
+        LIB_MeshProcessing::ParallelForRange(NumVertices, [&Source, &Write](int32 Begin, int32 End)
+            {
+                for (int32 i = Begin; i < End; ++i)
+                {
+                    Write(i, Source.IsValidIndex(i) ? &Source[i] : nullptr);
+                }
+            });
+    }
+
+    void SetComponents(const int32 Num, const bool bEnabled, std::initializer_list<TArray<float>*> Components)
+    {
+        for (TArray<float>* Component : Components)
+        {
+            Component->SetNumUninitialized(bEnabled ? Num : 0);
+        }
+    }
+}
+
+
+// -- FProcMeshBuffer implementation --
+FProcMeshBuffer FProcMeshBuffer::FromMeshData(const FProcMeshDataView& MeshData)
+{
+    const int32 NumVertices = MeshData.Vertices.Num();
+
+    FProcMeshBuffer Buffer;
+    SetComponents(NumVertices, true, { &Buffer.PositionX, &Buffer.PositionY, &Buffer.PositionZ });
+    SetComponents(NumVertices, MeshData.Normals.Num() > 0, { &Buffer.NormalX, &Buffer.NormalY, &Buffer.NormalZ });
+    SetComponents(NumVertices, MeshData.UV0.Num() > 0, { &Buffer.U, &Buffer.V });
+    SetComponents(NumVertices, MeshData.Tangents.Num() > 0, { &Buffer.TangentX, &Buffer.TangentY, &Buffer.TangentZ, &Buffer.BinormalSign });
+    Buffer.Colors.SetNumUninitialized(MeshData.VertexColors.Num() > 0 ? NumVertices : 0);
+    Buffer.Triangles = MeshData.Triangles;
+
+    ConvertAttribute(MeshData.Vertices, NumVertices, [&Buffer](int32 i, const FVector* Position)
+        {
+            Buffer.PositionX[i] = static_cast<float>(Position->X);
+            Buffer.PositionY[i] = static_cast<float>(Position->Y);
+            Buffer.PositionZ[i] = static_cast<float>(Position->Z);
+        });
+    ConvertAttribute(MeshData.Normals, NumVertices, [&Buffer](int32 i, const FVector* Normal)
+        {
+            const FVector3f Value = Normal ? FVector3f(*Normal) : FVector3f::ZeroVector;
+            Buffer.NormalX[i] = Value.X;
+            Buffer.NormalY[i] = Value.Y;
+            Buffer.NormalZ[i] = Value.Z;
+        });
+    ConvertAttribute(MeshData.UV0, NumVertices, [&Buffer](int32 i, const FVector2D* UV)
+        {
+            const FVector2f Value = UV ? FVector2f(*UV) : FVector2f::ZeroVector;
+            Buffer.U[i] = Value.X;
+            Buffer.V[i] = Value.Y;
+        });
+    ConvertAttribute(MeshData.VertexColors, NumVertices, [&Buffer](int32 i, const FLinearColor* Color)
+        {
+            Buffer.Colors[i] = Color ? *Color : FLinearColor::White;
+        });
+    ConvertAttribute(MeshData.Tangents, NumVertices, [&Buffer](int32 i, const FProcMeshTangent* Tangent)
+        {
+            const FVector3f Value = Tangent ? FVector3f(Tangent->TangentX) : FVector3f::ZeroVector;
+            Buffer.TangentX[i] = Value.X;
+            Buffer.TangentY[i] = Value.Y;
+            Buffer.TangentZ[i] = Value.Z;
+            Buffer.BinormalSign[i] = (Tangent && Tangent->bFlipTangentY) ? -1.0f : 1.0f;
+        });
+    return Buffer;
+}
+
+FProcMeshData FProcMeshBuffer::ToMeshData() const
+{
+    const FProcMeshBufferView View(*this);
+    const int32 NumVertices = View.NumVertices();
+
+    FProcMeshData MeshData;
+    MeshData.Vertices.SetNumUninitialized(NumVertices);
+    MeshData.Normals.SetNumUninitialized(View.HasNormals() ? NumVertices : 0);
+    MeshData.UV0.SetNumUninitialized(View.HasUVs() ? NumVertices : 0);
+    MeshData.Tangents.SetNum(View.HasTangents() ? NumVertices : 0);
+    MeshData.VertexColors = Colors;
+    MeshData.Triangles = Triangles;
+
+    LIB_MeshProcessing::ParallelForRange(NumVertices, [&View, &MeshData](int32 Begin, int32 End)
+        {
+            for (int32 i = Begin; i < End; ++i)
+            {
+                MeshData.Vertices[i] = FVector(View.PositionX[i], View.PositionY[i], View.PositionZ[i]);
+                if (View.HasNormals())
+                {
+                    MeshData.Normals[i] = FVector(View.NormalX[i], View.NormalY[i], View.NormalZ[i]);
+                }
+                if (View.HasUVs())
+                {
+                    MeshData.UV0[i] = FVector2D(View.U[i], View.V[i]);
+                }
+                if (View.HasTangents())
+                {
+                    MeshData.Tangents[i] = FProcMeshTangent(FVector(View.TangentX[i], View.TangentY[i], View.TangentZ[i]), View.BinormalSign[i] < 0.0f);
+                }
+            }
+        });
+    return MeshData;
+}
+
+void FProcMeshBuffer::CopyFrom(const FProcMeshBufferView& Source)
+{
+    PositionX = Source.PositionX;
+    PositionY = Source.PositionY;
+    PositionZ = Source.PositionZ;
+    Triangles = Source.Triangles;
+    NormalX = Source.NormalX;
+    NormalY = Source.NormalY;
+    NormalZ = Source.NormalZ;
+    U = Source.U;
+    V = Source.V;
+    Colors = Source.Colors;
+    TangentX = Source.TangentX;
+    TangentY = Source.TangentY;
+    TangentZ = Source.TangentZ;
+    BinormalSign = Source.BinormalSign;
+}
+
+
+// -- FProcMeshBufferView implementation --
+FProcMeshBufferView::FProcMeshBufferView(const FProcMeshBuffer& Buffer)
+    : PositionX(Buffer.PositionX)
+    , PositionY(Buffer.PositionY)
+    , PositionZ(Buffer.PositionZ)
+    , Triangles(Buffer.Triangles)
+    , NormalX(Buffer.NormalX)
+    , NormalY(Buffer.NormalY)
+    , NormalZ(Buffer.NormalZ)
+    , U(Buffer.U)
+    , V(Buffer.V)
+    , Colors(Buffer.Colors)
+    , TangentX(Buffer.TangentX)
+    , TangentY(Buffer.TangentY)
+    , TangentZ(Buffer.TangentZ)
+    , BinormalSign(Buffer.BinormalSign)
+{
+}
+
+bool FProcMeshBufferView::IsValid() const
+{
+    const int32 NumVerts = NumVertices();
+    if (NumVerts == 0 || Triangles.Num() % 3 != 0)
+    {
+        return false;
+    }
+
+    auto IsEmptyOrFull = [NumVerts](const int32 Num)
+    {
+        return Num == 0 || Num == NumVerts;
+    };
+    return PositionY.Num() == NumVerts && PositionZ.Num() == NumVerts
+        && IsEmptyOrFull(NormalX.Num()) && NormalY.Num() == NormalX.Num() && NormalZ.Num() == NormalX.Num()
+        && IsEmptyOrFull(U.Num()) && V.Num() == U.Num()
+        && IsEmptyOrFull(Colors.Num())
+        && IsEmptyOrFull(TangentX.Num()) && TangentY.Num() == TangentX.Num() && TangentZ.Num() == TangentX.Num() && BinormalSign.Num() == TangentX.Num();
+}
+
+FBox3f FProcMeshBufferView::ComputeBounds() const
+{
+    const int32 NumVerts = NumVertices();
+    if (NumVerts == 0)
+    {
+        return FBox3f(ForceInit);
+    }
+
+    // 블록별 최소/최대를 구한 뒤 합친다. 성분별 연속 배열이라 내부 루프가 벡터화된다.
+    const int32 NumBlocks = FMath::DivideAndRoundUp(NumVerts, LIB_MeshProcessing::ParallelBlockSize);
+    TArray<FBox3f> BlockBounds;
+    BlockBounds.SetNumUninitialized(NumBlocks);
+    LIB_MeshProcessing::ParallelForRange(NumVerts, [this, &BlockBounds](int32 Begin, int32 End)
+        {
+            FVector3f Min(PositionX[Begin], PositionY[Begin], PositionZ[Begin]);
+            FVector3f Max = Min;
+            for (int32 i = Begin; i < End; ++i)
+            {
+                Min.X = FMath::Min(Min.X, PositionX[i]);
+                Min.Y = FMath::Min(Min.Y, PositionY[i]);
+                Min.Z = FMath::Min(Min.Z, PositionZ[i]);
+                Max.X = FMath::Max(Max.X, PositionX[i]);
+                Max.Y = FMath::Max(Max.Y, PositionY[i]);
+                Max.Z = FMath::Max(Max.Z, PositionZ[i]);
+            }
+            BlockBounds[Begin / LIB_MeshProcessing::ParallelBlockSize] = FBox3f(Min, Max);
+        });
+
+    FBox3f Bounds(ForceInit);
+    for (const FBox3f& Block : BlockBounds)
+    {
+        Bounds += Block;
+    }
+    return Bounds;
+}
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LIB_Export.h"
+
+// SoA 위치 배열을 FVector3f 배열처럼 읽기 위한 접근자
+struct FProcMeshBufferPositions
+{
+	const float* X = nullptr;
+	const float* Y = nullptr;
+	const float* Z = nullptr;
+	int32 Num = 0;
+
+	bool IsValidIndex(const int32 Index) const { return Index >= 0 && Index < Num; }
+	FVector3f operator[](const int32 Index) const { return FVector3f(X[Index], Y[Index], Z[Index]); }
+};
+
+struct FProcMeshBufferView;
+
+/**
+ * 단정밀도 SoA(성분별 배열) 메시 버퍼 (C++ 전용).
+ * FProcMeshData 의 절반 정도 메모리로 프로시저럴 메시를 보관할 수 있고, 성분별로 연속된 float 배열이라
+ * 정점 단위 커널(UV 생성, 법선, 바운드)이 벡터화되기 쉽습니다.
+ * 정점 속성 배열은 비어 있거나 정점 수와 같은 길이여야 합니다.
+ */
+struct FProcMeshBuffer
+{
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+
+	TArray<int32> Triangles;
+
+	TArray<float> NormalX;
+	TArray<float> NormalY;
+	TArray<float> NormalZ;
+
+	TArray<float> U;
+	TArray<float> V;
+
+	TArray<FLinearColor> Colors;
+
+	TArray<float> TangentX;
+	TArray<float> TangentY;
+	TArray<float> TangentZ;
+	TArray<float> BinormalSign;	// bFlipTangentY 이면 -1
+
+	int32 NumVertices() const { return PositionX.Num(); }
+
+	/**
+	 * FProcMeshData 에서 변환합니다. 위치/법선/UV 는 float 로 반올림되며, 일부만 채워진 속성 배열은 기본값으로 채웁니다.
+	 * 반대 방향(ToMeshData)은 무손실이므로, 한 번 변환한 버퍼는 몇 번을 왕복해도 같은 값을 유지합니다.
+	 */
+	static FProcMeshBuffer FromMeshData(const FProcMeshDataView& MeshData);
+	FProcMeshData ToMeshData() const;
+
+	// 두 버퍼를 성분별로 복사합니다 (크리즈 분할처럼 정점 수가 바뀌는 경우에만 사용)
+	void CopyFrom(const FProcMeshBufferView& Source);
+};
+
+// FProcMeshBuffer 의 읽기 전용 뷰. 원본 버퍼와 전처리에서 새로 만든 버퍼를 섞어 가리킬 수 있습니다.
+struct FProcMeshBufferView
+{
+	TConstArrayView<float> PositionX;
+	TConstArrayView<float> PositionY;
+	TConstArrayView<float> PositionZ;
+	TConstArrayView<int32> Triangles;
+	TConstArrayView<float> NormalX;
+	TConstArrayView<float> NormalY;
+	TConstArrayView<float> NormalZ;
+	TConstArrayView<float> U;
+	TConstArrayView<float> V;
+	TConstArrayView<FLinearColor> Colors;
+	TConstArrayView<float> TangentX;
+	TConstArrayView<float> TangentY;
+	TConstArrayView<float> TangentZ;
+	TConstArrayView<float> BinormalSign;
+
+	FProcMeshBufferView() = default;
+	FProcMeshBufferView(const FProcMeshBuffer& Buffer);
+
+	int32 NumVertices() const { return PositionX.Num(); }
+	bool HasNormals() const { return NormalX.Num() > 0; }
+	bool HasUVs() const { return U.Num() > 0; }
+	bool HasColors() const { return Colors.Num() > 0; }
+	bool HasTangents() const { return TangentX.Num() > 0; }
+
+	FProcMeshBufferPositions GetPositions() const
+	{
+		return FProcMeshBufferPositions{ PositionX.GetData(), PositionY.GetData(), PositionZ.GetData(), PositionX.Num() };
+	}
+
+	// 정점이 있고, 인덱스 수가 3의 배수이며, 모든 속성 배열이 비어 있거나 정점 수와 같은지 검사
+	bool IsValid() const;
+
+	// 성분별 최소/최대를 병렬로 계산
+	FBox3f ComputeBounds() const;
+};
@@ -0,0 +1,633 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_MeshExport.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "StaticMeshResources.h"
+
+namespace
+{
+    static_assert(PLATFORM_LITTLE_ENDIAN, "PLY and GLB payloads are written as little-endian");
+
+    // 포맷 단위 (ParallelFor 작업 하나) 와 디스크에 한 번에 쓰는 블록당 청크 수
+    constexpr int32 ItemsPerChunk = 16 * 1024;
+    constexpr int32 ChunksPerBlock = 64;
+
+    // glTF 는 미터 단위
+    constexpr float GltfScale = 0.01f;
+
+    // 블록을 워커 스레드에서 기록. 쓰기가 진행되는 동안 호출 스레드는 다음 블록을 포맷한다.
+    class FBlockFileWriter
+    {
+    public:
+        explicit FBlockFileWriter(const FString& InFilePath)
+            : FilePath(InFilePath)
+        {
+        }
+
+        ~FBlockFileWriter()
+        {
+            // 핸들보다 먼저 쓰기 작업이 끝나야 한다
+            WaitForPendingWrite();
+        }
+
+        bool Open()
+        {
+            IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+            PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+            FileHandle.Reset(PlatformFile.OpenWrite(*FilePath));
+            bOk = FileHandle.IsValid();
+            return bOk;
+        }
+
+        bool IsOk() const { return bOk; }
+
+        // 이전 블록 쓰기가 끝날 때까지 기다린 뒤 이 블록의 쓰기를 시작한다
+        void Write(TArray64<uint8>&& Block)
+        {
+            WaitForPendingWrite();
+            if (!bOk || Block.Num() == 0)
+            {
+                return;
+            }
+
+            IFileHandle* Handle = FileHandle.Get();
+            PendingWrite = Async(EAsyncExecution::ThreadPool, [Handle, Data = MoveTemp(Block)]()
+                {
+                    return Handle->Write(Data.GetData(), Data.Num());
+                });
+        }
+
+        // 실패하면 쓰다 만 파일을 지운다
+        bool Close()
+        {
+            WaitForPendingWrite();
+            bOk = bOk && FileHandle.IsValid() && FileHandle->Flush();
+            FileHandle.Reset();
+            if (!bOk)
+            {
+                FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
+            }
+            return bOk;
+        }
+
+    private:
+        void WaitForPendingWrite()
+        {
+            if (PendingWrite.IsValid())
+            {
+                bOk = PendingWrite.Get() && bOk;
+                PendingWrite.Reset();
+            }
+        }
+
+        FString FilePath;
+        TUniquePtr<IFileHandle> FileHandle;
+        TFuture<bool> PendingWrite;
+        bool bOk = false;
+    };
+
+    TArray64<uint8> ToBlock(const FString& Text)
+    {
+        const FTCHARToUTF8 Utf8(*Text);
+        TArray64<uint8> Block;
+        Block.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        return Block;
+    }
+
+    template <typename FmtType, typename... ArgTypes>
+    void AppendFormat(TArray64<uint8>& Out, const FmtType& Format, ArgTypes... Args)
+    {
+        ANSICHAR Line[256];
+        const int32 Length = FCStringAnsi::Snprintf(Line, UE_ARRAY_COUNT(Line), Format, Args...);
+        if (Length > 0)
+        {
+            Out.Append(reinterpret_cast<const uint8*>(Line), FMath::Min<int32>(Length, UE_ARRAY_COUNT(Line) - 1));
+        }
+    }
+
+    template <typename ValueType>
+    void AppendValue(TArray64<uint8>& Out, const ValueType& Value)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(ValueType));
+    }
+
+    /**
+     * [0, NumItems) 를 ItemsPerChunk 단위로 병렬 포맷하고, ChunksPerBlock 개씩 이어 붙여 기록한다.
+     * FormatChunk(Begin, End, Out) 은 Out 뒤에 항목을 덧붙인다.
+     */
+    template <typename FormatFunctionType>
+    void WriteChunked(FBlockFileWriter& Writer, const int32 NumItems, const FormatFunctionType& FormatChunk)
+    {
+        const int32 NumChunks = FMath::DivideAndRoundUp(NumItems, ItemsPerChunk);
+        for (int32 FirstChunk = 0; FirstChunk < NumChunks && Writer.IsOk(); FirstChunk += ChunksPerBlock)
+        {
+            const int32 NumBlockChunks = FMath::Min(ChunksPerBlock, NumChunks - FirstChunk);
+            TArray<TArray64<uint8>> Chunks;
+            Chunks.SetNum(NumBlockChunks);
+            ParallelFor(NumBlockChunks, [&](int32 ChunkIndex)
+                {
+                    const int32 Begin = (FirstChunk + ChunkIndex) * ItemsPerChunk;
+                    const int32 End = FMath::Min(Begin + ItemsPerChunk, NumItems);
+                    FormatChunk(Begin, End, Chunks[ChunkIndex]);
+                });
+
+            int64 BlockSize = 0;
+            for (const TArray64<uint8>& Chunk : Chunks)
+            {
+                BlockSize += Chunk.Num();
+            }
+            TArray64<uint8> Block;
+            Block.Reserve(BlockSize);
+            for (const TArray64<uint8>& Chunk : Chunks)
+            {
+                Block.Append(Chunk);
+            }
+            Writer.Write(MoveTemp(Block));
+        }
+    }
+
+    // 스태틱 메시 LOD 렌더 데이터 접근자
+    struct FStaticMeshLODSource
+    {
+        const FPositionVertexBuffer& Positions;
+        const FStaticMeshVertexBuffer& Attributes;
+        const FColorVertexBuffer& ColorBuffer;
+
+        explicit FStaticMeshLODSource(const FStaticMeshLODResources& LOD)
+            : Positions(LOD.VertexBuffers.PositionVertexBuffer)
+            , Attributes(LOD.VertexBuffers.StaticMeshVertexBuffer)
+            , ColorBuffer(LOD.VertexBuffers.ColorVertexBuffer)
+        {
+        }
+
+        int32 NumVertices() const { return static_cast<int32>(Positions.GetNumVertices()); }
+        bool HasNormals() const { return Attributes.GetNumVertices() == Positions.GetNumVertices() && Attributes.GetTangentData() != nullptr; }
+        bool HasUVs() const { return HasNormals() && Attributes.GetNumTexCoords() > 0 && Attributes.GetTexCoordData() != nullptr; }
+        bool HasColors() const { return ColorBuffer.GetNumVertices() == Positions.GetNumVertices() && ColorBuffer.GetVertexData() != nullptr; }
+
+        FVector3f Position(const int32 Index) const { return Positions.VertexPosition(Index); }
+        FVector3f Normal(const int32 Index) const { return FVector3f(Attributes.VertexTangentZ(Index)); }
+        FVector2f UV(const int32 Index) const { return Attributes.GetVertexUV(Index, 0); }
+        FLinearColor Color(const int32 Index) const { return FLinearColor(ColorBuffer.VertexColor(Index)); }
+    };
+
+    // FProcMeshData 접근자. 길이가 정점 수와 다른 속성 배열은 없는 것으로 취급한다.
+    struct FMeshDataSource
+    {
+        const FProcMeshDataView& MeshData;
+
+        int32 NumVertices() const { return MeshData.Vertices.Num(); }
+        bool HasNormals() const { return MeshData.Normals.Num() == NumVertices(); }
+        bool HasUVs() const { return MeshData.UV0.Num() == NumVertices(); }
+        bool HasColors() const { return MeshData.VertexColors.Num() == NumVertices(); }
+
+        FVector3f Position(const int32 Index) const { return FVector3f(MeshData.Vertices[Index]); }
+        FVector3f Normal(const int32 Index) const { return FVector3f(MeshData.Normals[Index]); }
+        FVector2f UV(const int32 Index) const { return FVector2f(MeshData.UV0[Index]); }
+        FLinearColor Color(const int32 Index) const { return MeshData.VertexColors[Index]; }
+    };
+
+    // UE 좌표계(왼손)를 OBJ/PLY 관례(오른손)로: STL 내보내기와 같이 Y축 반전
+    FVector3f ToRightHanded(const FVector3f& V)
+    {
+        return FVector3f(V.X, -V.Y, V.Z);
+    }
+
+    // UE 좌표계(왼손, Z 위, cm)를 glTF(오른손, Y 위, m)로
+    FVector3f ToGltf(const FVector3f& V, const float Scale)
+    {
+        return FVector3f(V.X, V.Z, V.Y) * Scale;
+    }
+
+    template <typename SourceType>
+    void WriteObj(const SourceType& Source, TConstArrayView<uint32> Indices, FBlockFileWriter& Writer)
+    {
+        const bool bHasNormals = Source.HasNormals();
+        const bool bHasUVs = Source.HasUVs();
+        const bool bHasColors = Source.HasColors();
+        const int32 NumVertices = Source.NumVertices();
+        const int32 NumTriangles = Indices.Num() / 3;
+
+        Writer.Write(ToBlock(FString::Printf(TEXT("# Exported by LIB_Export\n# %d vertices, %d triangles\no Mesh\n"), NumVertices, NumTriangles)));
+
+        // 1. 정점 (정점 색은 v 뒤에 sRGB 0~1 로 붙이는 확장 형식)
+        WriteChunked(Writer, NumVertices, [&Source, bHasColors](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Reserve(static_cast<int64>(End - Begin) * (bHasColors ? 80 : 48));
+                for (int32 Index = Begin; Index < End; ++Index)
+                {
+                    const FVector3f P = ToRightHanded(Source.Position(Index));
+                    if (bHasColors)
+                    {
+                        const FColor C = Source.Color(Index).ToFColor(true);
+                        AppendFormat(Out, "v %.9g %.9g %.9g %.4g %.4g %.4g\n", P.X, P.Y, P.Z, C.R / 255.0f, C.G / 255.0f, C.B / 255.0f);
+                    }
+                    else
+                    {
+                        AppendFormat(Out, "v %.9g %.9g %.9g\n", P.X, P.Y, P.Z);
+                    }
+                }
+            });
+
+        // 2. 텍스처 좌표 (OBJ 는 왼쪽 아래 원점이므로 V 반전)
+        if (bHasUVs)
+        {
+            WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+                {
+                    Out.Reserve(static_cast<int64>(End - Begin) * 32);
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        const FVector2f UV = Source.UV(Index);
+                        AppendFormat(Out, "vt %.7g %.7g\n", UV.X, 1.0f - UV.Y);
+                    }
+                });
+        }
+
+        // 3. 법선
+        if (bHasNormals)
+        {
+            WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+                {
+                    Out.Reserve(static_cast<int64>(End - Begin) * 40);
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        const FVector3f N = ToRightHanded(Source.Normal(Index));
+                        AppendFormat(Out, "vn %.6g %.6g %.6g\n", N.X, N.Y, N.Z);
+                    }
+                });
+        }
+
+        // 4. 면 (1 부터 시작하는 인덱스, 위치/UV/법선이 같은 번호를 공유)
+        WriteChunked(Writer, NumTriangles, [Indices, bHasNormals, bHasUVs](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Reserve(static_cast<int64>(End - Begin) * 64);
+                for (int32 Tri = Begin; Tri < End; ++Tri)
+                {
+                    const uint32 A = Indices[Tri * 3 + 0] + 1;
+                    const uint32 B = Indices[Tri * 3 + 1] + 1;
+                    const uint32 C = Indices[Tri * 3 + 2] + 1;
+                    if (bHasUVs && bHasNormals)
+                    {
+                        AppendFormat(Out, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", A, A, A, B, B, B, C, C, C);
+                    }
+                    else if (bHasNormals)
+                    {
+                        AppendFormat(Out, "f %u//%u %u//%u %u//%u\n", A, A, B, B, C, C);
+                    }
+                    else if (bHasUVs)
+                    {
+                        AppendFormat(Out, "f %u/%u %u/%u %u/%u\n", A, A, B, B, C, C);
+                    }
+                    else
+                    {
+                        AppendFormat(Out, "f %u %u %u\n", A, B, C);
+                    }
+                }
+            });
+    }
+
+    template <typename SourceType>
+    void WritePly(const SourceType& Source, TConstArrayView<uint32> Indices, FBlockFileWriter& Writer)
+    {
+        const bool bHasNormals = Source.HasNormals();
+        const bool bHasUVs = Source.HasUVs();
+        const bool bHasColors = Source.HasColors();
+        const int32 NumVertices = Source.NumVertices();
+        const int32 NumTriangles = Indices.Num() / 3;
+
+        // 1. 헤더
+        FString Header = FString::Printf(TEXT("ply\nformat binary_little_endian 1.0\ncomment Exported by LIB_Export\nelement vertex %d\nproperty float x\nproperty float y\nproperty float z\n"), NumVertices);
+        if (bHasNormals)
+        {
+            Header += TEXT("property float nx\nproperty float ny\nproperty float nz\n");
+        }
+        if (bHasUVs)
+        {
+            Header += TEXT("property float s\nproperty float t\n");
+        }
+        if (bHasColors)
+        {
+            Header += TEXT("property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n");
+        }
+        Header += FString::Printf(TEXT("element face %d\nproperty list uchar uint vertex_indices\nend_header\n"), NumTriangles);
+        Writer.Write(ToBlock(Header));
+
+        // 2. 정점 레코드
+        const int64 VertexSize = sizeof(FVector3f) + (bHasNormals ? sizeof(FVector3f) : 0) + (bHasUVs ? sizeof(FVector2f) : 0) + (bHasColors ? sizeof(FColor) : 0);
+        WriteChunked(Writer, NumVertices, [&Source, VertexSize, bHasNormals, bHasUVs, bHasColors](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Reserve(static_cast<int64>(End - Begin) * VertexSize);
+                for (int32 Index = Begin; Index < End; ++Index)
+                {
+                    AppendValue(Out, ToRightHanded(Source.Position(Index)));
+                    if (bHasNormals)
+                    {
+                        AppendValue(Out, ToRightHanded(Source.Normal(Index)));
+                    }
+                    if (bHasUVs)
+                    {
+                        const FVector2f UV = Source.UV(Index);
+                        AppendValue(Out, FVector2f(UV.X, 1.0f - UV.Y));
+                    }
+                    if (bHasColors)
+                    {
+                        const FColor C = Source.Color(Index).ToFColor(true);
+                        const uint8 RGBA[4] = { C.R, C.G, C.B, C.A };
+                        AppendValue(Out, RGBA);
+                    }
+                }
+            });
+
+        // 3. 면 레코드: 꼭짓점 수(uchar) + 인덱스 3개(uint)
+        WriteChunked(Writer, NumTriangles, [Indices](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Reserve(static_cast<int64>(End - Begin) * 13);
+                for (int32 Tri = Begin; Tri < End; ++Tri)
+                {
+                    Out.Add(3);
+                    Out.Append(reinterpret_cast<const uint8*>(&Indices[Tri * 3]), sizeof(uint32) * 3);
+                }
+            });
+    }
+
+    template <typename SourceType>
+    bool WriteGlb(const SourceType& Source, TConstArrayView<uint32> Indices, FBlockFileWriter& Writer)
+    {
+        constexpr uint32 GlbMagic = 0x46546C67;     // 'glTF'
+        constexpr uint32 GlbChunkJson = 0x4E4F534A; // 'JSON'
+        constexpr uint32 GlbChunkBin = 0x004E4942;  // 'BIN\0'
+
+        const bool bHasNormals = Source.HasNormals();
+        const bool bHasUVs = Source.HasUVs();
+        const bool bHasColors = Source.HasColors();
+        const int32 NumVertices = Source.NumVertices();
+
+        // 1. POSITION 접근자에 필요한 최소/최대 (기록할 값 그대로)
+        const int32 NumBoundsChunks = FMath::DivideAndRoundUp(NumVertices, ItemsPerChunk);
+        TArray<FBox3f> ChunkBounds;
+        ChunkBounds.Init(FBox3f(ForceInit), NumBoundsChunks);
+        ParallelFor(NumBoundsChunks, [&Source, &ChunkBounds, NumVertices](int32 ChunkIndex)
+            {
+                const int32 Begin = ChunkIndex * ItemsPerChunk;
+                const int32 End = FMath::Min(Begin + ItemsPerChunk, NumVertices);
+                for (int32 Index = Begin; Index < End; ++Index)
+                {
+                    ChunkBounds[ChunkIndex] += ToGltf(Source.Position(Index), GltfScale);
+                }
+            });
+        FBox3f Bounds(ForceInit);
+        for (const FBox3f& Box : ChunkBounds)
+        {
+            Bounds += Box;
+        }
+
+        // 2. BIN 청크 배치. 모든 요소가 4바이트 배수라 정렬이 자동으로 맞는다.
+        struct FGltfStream
+        {
+            const TCHAR* Attribute;    // nullptr 이면 인덱스
+            const TCHAR* Type;
+            int32 ComponentType;
+            bool bNormalized;
+            int32 Count;
+            int64 ElementSize;
+            int64 Offset;
+        };
+        TArray<FGltfStream> Streams;
+        Streams.Add({ TEXT("POSITION"), TEXT("VEC3"), 5126, false, NumVertices, sizeof(FVector3f), 0 });
+        if (bHasNormals)
+        {
+            Streams.Add({ TEXT("NORMAL"), TEXT("VEC3"), 5126, false, NumVertices, sizeof(FVector3f), 0 });
+        }
+        if (bHasUVs)
+        {
+            Streams.Add({ TEXT("TEXCOORD_0"), TEXT("VEC2"), 5126, false, NumVertices, sizeof(FVector2f), 0 });
+        }
+        if (bHasColors)
+        {
+            Streams.Add({ TEXT("COLOR_0"), TEXT("VEC4"), 5121, true, NumVertices, sizeof(FColor), 0 });
+        }
+        Streams.Add({ nullptr, TEXT("SCALAR"), 5125, false, Indices.Num(), sizeof(uint32), 0 });
+
+        int64 BinSize = 0;
+        for (FGltfStream& Stream : Streams)
+        {
+            Stream.Offset = BinSize;
+            BinSize += Stream.ElementSize * Stream.Count;
+        }
+
+        // 3. JSON 청크
+        FString Attributes;
+        FString BufferViews;
+        FString Accessors;
+        for (int32 StreamIndex = 0; StreamIndex < Streams.Num(); ++StreamIndex)
+        {
+            const FGltfStream& Stream = Streams[StreamIndex];
+            const TCHAR* Separator = StreamIndex > 0 ? TEXT(",") : TEXT("");
+            BufferViews += FString::Printf(TEXT("%s{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%lld,\"target\":%d}"),
+                Separator, Stream.Offset, Stream.ElementSize * Stream.Count, Stream.Attribute ? 34962 : 34963);
+
+            FString Accessor = FString::Printf(TEXT("%s{\"bufferView\":%d,\"componentType\":%d,\"count\":%d,\"type\":\"%s\""),
+                Separator, StreamIndex, Stream.ComponentType, Stream.Count, Stream.Type);
+            if (Stream.bNormalized)
+            {
+                Accessor += TEXT(",\"normalized\":true");
+            }
+            if (StreamIndex == 0)
+            {
+                Accessor += FString::Printf(TEXT(",\"min\":[%.9g,%.9g,%.9g],\"max\":[%.9g,%.9g,%.9g]"),
+                    Bounds.Min.X, Bounds.Min.Y, Bounds.Min.Z, Bounds.Max.X, Bounds.Max.Y, Bounds.Max.Z);
+            }
+            Accessors += Accessor + TEXT("}");
+
+            if (Stream.Attribute)
+            {
+                Attributes += FString::Printf(TEXT("%s\"%s\":%d"), Separator, Stream.Attribute, StreamIndex);
+            }
+        }
+        const FString Json = FString::Printf(TEXT("{\"asset\":{\"version\":\"2.0\",\"generator\":\"LIB_Export\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],")
+            TEXT("\"meshes\":[{\"primitives\":[{\"attributes\":{%s},\"indices\":%d,\"mode\":4}]}],\"buffers\":[{\"byteLength\":%lld}],\"bufferViews\":[%s],\"accessors\":[%s]}"),
+            *Attributes, Streams.Num() - 1, BinSize, *BufferViews, *Accessors);
+
+        TArray64<uint8> JsonBytes = ToBlock(Json);
+        while (JsonBytes.Num() % 4 != 0)
+        {
+            JsonBytes.Add(' ');
+        }
+
+        const int64 TotalSize = 12 + 8 + JsonBytes.Num() + 8 + BinSize;
+        if (TotalSize > MAX_uint32)
+        {
+            UE_LOG(LogTemp, Error, TEXT("ExportMesh: mesh is too large for a GLB file (%lld bytes)."), TotalSize);
+            return false;
+        }
+
+        // 4. GLB 헤더 + JSON 청크 + BIN 청크 헤더
+        TArray64<uint8> Head;
+        Head.Reserve(28 + JsonBytes.Num());
+        AppendValue(Head, GlbMagic);
+        AppendValue(Head, static_cast<uint32>(2));
+        AppendValue(Head, static_cast<uint32>(TotalSize));
+        AppendValue(Head, static_cast<uint32>(JsonBytes.Num()));
+        AppendValue(Head, GlbChunkJson);
+        Head.Append(JsonBytes);
+        AppendValue(Head, static_cast<uint32>(BinSize));
+        AppendValue(Head, GlbChunkBin);
+        Writer.Write(MoveTemp(Head));
+
+        // 5. BIN 스트림 (감김은 STL/OBJ 와 같이 유지)
+        WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Reserve(static_cast<int64>(End - Begin) * sizeof(FVector3f));
+                for (int32 Index = Begin; Index < End; ++Index)
+                {
+                    AppendValue(Out, ToGltf(Source.Position(Index), GltfScale));
+                }
+            });
+        if (bHasNormals)
+        {
+            // glTF 법선은 단위 길이여야 한다
+            WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+                {
+                    Out.Reserve(static_cast<int64>(End - Begin) * sizeof(FVector3f));
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        AppendValue(Out, ToGltf(Source.Normal(Index).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector), 1.0f));
+                    }
+                });
+        }
+        if (bHasUVs)
+        {
+            WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+                {
+                    Out.Reserve(static_cast<int64>(End - Begin) * sizeof(FVector2f));
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        AppendValue(Out, Source.UV(Index));
+                    }
+                });
+        }
+        if (bHasColors)
+        {
+            // glTF 정점 색은 선형 공간
+            WriteChunked(Writer, NumVertices, [&Source](int32 Begin, int32 End, TArray64<uint8>& Out)
+                {
+                    Out.Reserve(static_cast<int64>(End - Begin) * sizeof(FColor));
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        const FColor C = Source.Color(Index).QuantizeRound();
+                        const uint8 RGBA[4] = { C.R, C.G, C.B, C.A };
+                        AppendValue(Out, RGBA);
+                    }
+                });
+        }
+        WriteChunked(Writer, Indices.Num(), [Indices](int32 Begin, int32 End, TArray64<uint8>& Out)
+            {
+                Out.Append(reinterpret_cast<const uint8*>(&Indices[Begin]), static_cast<int64>(End - Begin) * sizeof(uint32));
+            });
+        return true;
+    }
+
+    template <typename SourceType>
+    bool ExportMesh(const SourceType& Source, TConstArrayView<uint32> Indices, const FString& FilePath, const EProcMeshExportFormat Format)
+    {
+        if (Source.NumVertices() == 0 || Indices.Num() < 3)
+        {
+            UE_LOG(LogTemp, Error, TEXT("ExportMesh: nothing to export to %s."), *FilePath);
+            return false;
+        }
+
+        FBlockFileWriter Writer(FilePath);
+        if (!Writer.Open())
+        {
+            UE_LOG(LogTemp, Error, TEXT("ExportMesh: failed to open %s for writing."), *FilePath);
+            return false;
+        }
+
+        bool bFormatted = true;
+        switch (Format)
+        {
+        case EProcMeshExportFormat::Obj:
+            WriteObj(Source, Indices, Writer);
+            break;
+        case EProcMeshExportFormat::Ply:
+            WritePly(Source, Indices, Writer);
+            break;
+        case EProcMeshExportFormat::Glb:
+            bFormatted = WriteGlb(Source, Indices, Writer);
+            break;
+        default:
+            bFormatted = false;
+            break;
+        }
+
+        if (!Writer.Close() || !bFormatted)
+        {
+            // Close 가 성공했더라도 포맷 단계에서 실패했다면 파일을 남기지 않는다
+            FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
+            UE_LOG(LogTemp, Error, TEXT("ExportMesh: failed while writing %s."), *FilePath);
+            return false;
+        }
+        return true;
+    }
+}
+
+namespace LIB_MeshExport
+{
+    bool ExportStaticMeshLOD(const FStaticMeshLODResources& LOD, const FString& FilePath, const EProcMeshExportFormat Format)
+    {
+        const FStaticMeshLODSource Source(LOD);
+        const FIndexArrayView IndexView = LOD.IndexBuffer.GetArrayView();
+        if (Source.NumVertices() == 0 || Source.Positions.GetVertexData() == nullptr || IndexView.Num() == 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("ExportMesh: LOD has no CPU-accessible geometry (bAllowCPUAccess?)."));
+            return false;
+        }
+
+        // 섹션 범위의 인덱스만 모은다 (16/32비트 인덱스 버퍼를 하나의 형식으로)
+        TArray<uint32> Indices;
+        for (const FStaticMeshSection& Section : LOD.Sections)
+        {
+            const uint32 MaxTriangles = (static_cast<uint32>(IndexView.Num()) - FMath::Min<uint32>(Section.FirstIndex, IndexView.Num())) / 3;
+            const uint32 NumTriangles = FMath::Min(Section.NumTriangles, MaxTriangles);
+            const int32 First = Indices.AddUninitialized(NumTriangles * 3);
+            ParallelFor(FMath::DivideAndRoundUp<int32>(NumTriangles * 3, ItemsPerChunk), [&Indices, &IndexView, &Section, First, NumTriangles](int32 ChunkIndex)
+                {
+                    const int32 Begin = ChunkIndex * ItemsPerChunk;
+                    const int32 End = FMath::Min<int32>(Begin + ItemsPerChunk, NumTriangles * 3);
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        Indices[First + Index] = IndexView[Section.FirstIndex + Index];
+                    }
+                });
+        }
+
+        return ExportMesh(Source, Indices, FilePath, Format);
+    }
+
+    bool ExportMeshData(const FProcMeshDataView& MeshData, const FString& FilePath, const EProcMeshExportFormat Format)
+    {
+        // 범위를 벗어난 인덱스를 쓰는 삼각형은 제외
+        const int32 NumVertices = MeshData.Vertices.Num();
+        const int32 NumTriangles = MeshData.Triangles.Num() / 3;
+        TArray<uint32> Indices;
+        Indices.Reserve(NumTriangles * 3);
+        for (int32 Tri = 0; Tri < NumTriangles; ++Tri)
+        {
+            const int32 A = MeshData.Triangles[Tri * 3 + 0];
+            const int32 B = MeshData.Triangles[Tri * 3 + 1];
+            const int32 C = MeshData.Triangles[Tri * 3 + 2];
+            if (A >= 0 && A < NumVertices && B >= 0 && B < NumVertices && C >= 0 && C < NumVertices)
+            {
+                Indices.Add(A);
+                Indices.Add(B);
+                Indices.Add(C);
+            }
+        }
+
+        return ExportMesh(FMeshDataSource{ MeshData }, Indices, FilePath, Format);
+    }
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LIB_Export.h"
+
+struct FStaticMeshLODResources;
+
+/**
+ * 스태틱 메시 LOD 또는 FProcMeshData 를 OBJ / 바이너리 PLY / glTF 2.0 바이너리(.glb) 로 내보냅니다.
+ * 정점과 삼각형을 청크로 나누어 병렬로 포맷하고, 모은 큰 블록을 워커에서 기록하는 동안 다음 블록을 포맷합니다.
+ * 좌표는 STL 내보내기와 같이 오른손 좌표계로 바꾸며 (OBJ/PLY: Y 반전, glTF: Y 위 + 미터 단위) 삼각형 감김은 유지됩니다.
+ * 게임 스레드가 아니어도 호출할 수 있지만, 스태틱 메시는 내보내는 동안 렌더 데이터가 바뀌지 않아야 합니다.
+ */
+namespace LIB_MeshExport
+{
+	// bAllowCPUAccess 로 유지된 렌더 데이터를 읽습니다. 실제 그려지는 섹션의 삼각형만 기록합니다.
+	bool ExportStaticMeshLOD(const FStaticMeshLODResources& LOD, const FString& FilePath, EProcMeshExportFormat Format);
+
+	// 범위를 벗어난 인덱스를 쓰는 삼각형은 건너뜁니다. 정점 수와 길이가 다른 속성 배열은 내보내지 않습니다.
+	bool ExportMeshData(const FProcMeshDataView& MeshData, const FString& FilePath, EProcMeshExportFormat Format);
+}
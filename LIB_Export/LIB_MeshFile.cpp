@@ -0,0 +1,540 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_MeshFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include <atomic>
+
+namespace
+{
+    static_assert(PLATFORM_LITTLE_ENDIAN, "Proc mesh files are little-endian");
+
+    constexpr uint32 MeshFileMagic = 0x464D4250; // 'PBMF'
+    constexpr uint32 MeshFileVersion = 1;
+
+    // 스트림 시작 위치 정렬 (캐시 라인, SIMD 로드 모두 만족)
+    constexpr uint64 StreamAlignment = 64;
+
+    // LZ4 블록 크기. 블록마다 독립적으로 압축하므로 병렬로 압축/해제할 수 있다.
+    constexpr int32 CompressionBlockSize = 1 << 20;
+
+    // LZ4 는 원래 크기의 1/255 보다 작게 줄이지 못하므로, 해제 크기가 이보다 크면 손상된 표다
+    constexpr uint64 MaxCompressionRatio = 255;
+
+    enum class EMeshFileLayout : uint32
+    {
+        MeshData,   // FProcMeshData (AoS, double)
+        MeshBuffer  // FProcMeshBuffer (SoA, float)
+    };
+
+    enum class EMeshFileCompression : uint32
+    {
+        None,
+        LZ4Blocks   // 블록별 저장 크기 표(uint32) 뒤에 블록들. 저장 크기가 원래 크기와 같은 블록은 압축하지 않은 것
+    };
+
+    // 스트림 종류. 파일에 기록되므로 순서를 바꾸지 말고 뒤에만 추가할 것
+    enum class EMeshFileStream : uint32
+    {
+        Vertices, Triangles, Normals, UV0, VertexColors, Tangents,
+        PositionX, PositionY, PositionZ, BufferTriangles, NormalX, NormalY, NormalZ, U, V, Colors,
+        TangentX, TangentY, TangentZ, BinormalSign,
+        Num
+    };
+
+    static_assert(static_cast<uint32>(EMeshFileStream::Num) <= 32, "Stream types are tracked in a uint32 mask");
+
+    // 레이아웃에 속한 스트림이면 저장 원소 크기, 다른 레이아웃의 스트림이거나 알 수 없는 종류면 0
+    uint32 GetExpectedElementSize(const EMeshFileLayout Layout, const EMeshFileStream Type)
+    {
+        if (Layout == EMeshFileLayout::MeshData)
+        {
+            switch (Type)
+            {
+            case EMeshFileStream::Vertices:
+            case EMeshFileStream::Normals:      return sizeof(FVector);
+            case EMeshFileStream::Triangles:    return sizeof(int32);
+            case EMeshFileStream::UV0:          return sizeof(FVector2D);
+            case EMeshFileStream::VertexColors: return sizeof(FLinearColor);
+            case EMeshFileStream::Tangents:     return sizeof(FProcMeshTangent);
+            default:                            return 0;
+            }
+        }
+
+        switch (Type)
+        {
+        case EMeshFileStream::PositionX:
+        case EMeshFileStream::PositionY:
+        case EMeshFileStream::PositionZ:
+        case EMeshFileStream::NormalX:
+        case EMeshFileStream::NormalY:
+        case EMeshFileStream::NormalZ:
+        case EMeshFileStream::U:
+        case EMeshFileStream::V:
+        case EMeshFileStream::TangentX:
+        case EMeshFileStream::TangentY:
+        case EMeshFileStream::TangentZ:
+        case EMeshFileStream::BinormalSign:    return sizeof(float);
+        case EMeshFileStream::BufferTriangles: return sizeof(int32);
+        case EMeshFileStream::Colors:          return sizeof(FLinearColor);
+        default:                               return 0;
+        }
+    }
+
+    struct FMeshFileHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 Layout;
+        uint32 NumStreams;
+        uint64 FileSize;
+        uint64 Checksum;    // Checksum 을 0 으로 둔 헤더와 스트림 표의 해시
+        uint8 Reserved[32];
+    };
+    static_assert(sizeof(FMeshFileHeader) == 64, "Header layout is part of the file format");
+
+    struct FMeshFileStreamEntry
+    {
+        uint32 Type;
+        uint32 ElementSize; // 저장한 빌드의 sizeof(원소). 다르면 메모리 표현이 달라 읽지 않는다.
+        uint32 Compression;
+        uint32 Reserved;
+        uint64 NumElements;
+        uint64 Offset;      // 파일 시작 기준, StreamAlignment 정렬
+        uint64 StoredSize;
+        uint64 Checksum;    // 저장된 바이트의 해시
+    };
+    static_assert(sizeof(FMeshFileStreamEntry) == 48, "Stream entry layout is part of the file format");
+
+    // 저장할 스트림 하나. 압축하면 Compressed 에, 아니면 원본을 그대로 쓴다.
+    struct FStreamSource
+    {
+        EMeshFileStream Type;
+        uint32 ElementSize;
+        uint64 NumElements;
+        const uint8* Data;
+        TArray64<uint8> Compressed;
+
+        uint64 GetRawSize() const { return NumElements * ElementSize; }
+    };
+
+    template<typename T>
+    void AddStream(TArray<FStreamSource>& Streams, const EMeshFileStream Type, TConstArrayView<T> Array)
+    {
+        if (Array.Num() > 0)
+        {
+            Streams.Add({ Type, static_cast<uint32>(sizeof(T)), static_cast<uint64>(Array.Num()), reinterpret_cast<const uint8*>(Array.GetData()) });
+        }
+    }
+
+    // 블록별로 병렬 압축한다. 압축해도 작아지지 않으면 false (그대로 저장)
+    bool CompressStream(FStreamSource& Stream)
+    {
+        const uint64 RawSize = Stream.GetRawSize();
+        const int32 NumBlocks = static_cast<int32>(FMath::DivideAndRoundUp<uint64>(RawSize, CompressionBlockSize));
+        const int32 BlockBound = FCompression::CompressMemoryBound(NAME_LZ4, CompressionBlockSize);
+
+        TArray64<uint8> Blocks;
+        Blocks.SetNumUninitialized(static_cast<int64>(NumBlocks) * BlockBound);
+        TArray<uint32> BlockSizes;
+        BlockSizes.SetNumUninitialized(NumBlocks);
+        ParallelFor(NumBlocks, [&](int32 BlockIndex)
+            {
+                const uint64 BlockOffset = static_cast<uint64>(BlockIndex) * CompressionBlockSize;
+                const int32 RawBlockSize = static_cast<int32>(FMath::Min<uint64>(CompressionBlockSize, RawSize - BlockOffset));
+                uint8* Dest = Blocks.GetData() + static_cast<int64>(BlockIndex) * BlockBound;
+                int32 CompressedSize = BlockBound;
+                if (!FCompression::CompressMemory(NAME_LZ4, Dest, CompressedSize, Stream.Data + BlockOffset, RawBlockSize) || CompressedSize >= RawBlockSize)
+                {
+                    FMemory::Memcpy(Dest, Stream.Data + BlockOffset, RawBlockSize);
+                    CompressedSize = RawBlockSize;
+                }
+                BlockSizes[BlockIndex] = static_cast<uint32>(CompressedSize);
+            });
+
+        // 블록 크기 표 + 블록들을 앞으로 모은다
+        Stream.Compressed.Reset();
+        Stream.Compressed.Append(reinterpret_cast<const uint8*>(BlockSizes.GetData()), NumBlocks * sizeof(uint32));
+        for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+        {
+            Stream.Compressed.Append(Blocks.GetData() + static_cast<int64>(BlockIndex) * BlockBound, BlockSizes[BlockIndex]);
+        }
+        if (static_cast<uint64>(Stream.Compressed.Num()) >= RawSize)
+        {
+            Stream.Compressed.Empty();
+            return false;
+        }
+        return true;
+    }
+
+    bool DecompressStream(const uint8* Stored, const uint64 StoredSize, uint8* Dest, const uint64 RawSize)
+    {
+        const int32 NumBlocks = static_cast<int32>(FMath::DivideAndRoundUp<uint64>(RawSize, CompressionBlockSize));
+        const uint64 TableSize = static_cast<uint64>(NumBlocks) * sizeof(uint32);
+        if (StoredSize < TableSize)
+        {
+            return false;
+        }
+
+        // 블록 시작 위치를 먼저 구하고 범위를 확인한 뒤 병렬로 해제
+        TArray<uint64> BlockOffsets;
+        BlockOffsets.SetNumUninitialized(NumBlocks + 1);
+        BlockOffsets[0] = TableSize;
+        for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+        {
+            uint32 BlockSize;
+            FMemory::Memcpy(&BlockSize, Stored + BlockIndex * sizeof(uint32), sizeof(uint32));
+            BlockOffsets[BlockIndex + 1] = BlockOffsets[BlockIndex] + BlockSize;
+        }
+        if (BlockOffsets[NumBlocks] != StoredSize)
+        {
+            return false;
+        }
+
+        std::atomic<bool> bFailed(false);
+        ParallelFor(NumBlocks, [&](int32 BlockIndex)
+            {
+                const uint64 RawOffset = static_cast<uint64>(BlockIndex) * CompressionBlockSize;
+                const int32 RawBlockSize = static_cast<int32>(FMath::Min<uint64>(CompressionBlockSize, RawSize - RawOffset));
+                const int32 StoredBlockSize = static_cast<int32>(BlockOffsets[BlockIndex + 1] - BlockOffsets[BlockIndex]);
+                const uint8* Source = Stored + BlockOffsets[BlockIndex];
+                if (StoredBlockSize == RawBlockSize)
+                {
+                    FMemory::Memcpy(Dest + RawOffset, Source, RawBlockSize);
+                }
+                else if (StoredBlockSize > RawBlockSize || !FCompression::UncompressMemory(NAME_LZ4, Dest + RawOffset, RawBlockSize, Source, StoredBlockSize))
+                {
+                    bFailed = true;
+                }
+            });
+        return !bFailed;
+    }
+
+    uint64 HashHeaderAndTable(FMeshFileHeader Header, TConstArrayView<FMeshFileStreamEntry> Entries)
+    {
+        Header.Checksum = 0;
+        FXxHash64Builder Builder;
+        Builder.Update(&Header, sizeof(Header));
+        Builder.Update(Entries.GetData(), Entries.Num() * sizeof(FMeshFileStreamEntry));
+        return Builder.Finalize().Hash;
+    }
+
+    bool WriteStreams(const FString& FilePath, const EMeshFileLayout Layout, TArray<FStreamSource>& Streams, const bool bCompress)
+    {
+        // 1. 압축 (스트림 사이도 병렬)
+        TArray<FMeshFileStreamEntry> Entries;
+        Entries.SetNumZeroed(Streams.Num());
+        ParallelFor(Streams.Num(), [&Streams, &Entries, bCompress](int32 StreamIndex)
+            {
+                FStreamSource& Stream = Streams[StreamIndex];
+                FMeshFileStreamEntry& Entry = Entries[StreamIndex];
+                const bool bCompressed = bCompress && CompressStream(Stream);
+                const uint8* Stored = bCompressed ? Stream.Compressed.GetData() : Stream.Data;
+                Entry.Type = static_cast<uint32>(Stream.Type);
+                Entry.ElementSize = Stream.ElementSize;
+                Entry.Compression = static_cast<uint32>(bCompressed ? EMeshFileCompression::LZ4Blocks : EMeshFileCompression::None);
+                Entry.NumElements = Stream.NumElements;
+                Entry.StoredSize = bCompressed ? Stream.Compressed.Num() : Stream.GetRawSize();
+                Entry.Checksum = FXxHash64::HashBuffer(Stored, Entry.StoredSize).Hash;
+            });
+
+        // 2. 정렬된 위치 배정
+        uint64 Offset = Align(sizeof(FMeshFileHeader) + Entries.Num() * sizeof(FMeshFileStreamEntry), StreamAlignment);
+        for (FMeshFileStreamEntry& Entry : Entries)
+        {
+            Entry.Offset = Offset;
+            Offset = Align(Offset + Entry.StoredSize, StreamAlignment);
+        }
+
+        FMeshFileHeader Header;
+        FMemory::Memzero(Header);
+        Header.Magic = MeshFileMagic;
+        Header.Version = MeshFileVersion;
+        Header.Layout = static_cast<uint32>(Layout);
+        Header.NumStreams = Entries.Num();
+        Header.FileSize = Offset;
+        Header.Checksum = HashHeaderAndTable(Header, Entries);
+
+        // 3. 임시 파일에 쓴 뒤 교체
+        const FString TempPath = FilePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+        TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempPath));
+        if (!FileWriter)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to open mesh file: %s"), *TempPath);
+            return false;
+        }
+
+        static const uint8 Padding[StreamAlignment] = {};
+        auto WritePadding = [&FileWriter](const uint64 Target)
+        {
+            const int64 PaddingSize = static_cast<int64>(Target) - FileWriter->Tell();
+            check(PaddingSize >= 0 && PaddingSize < static_cast<int64>(StreamAlignment));
+            FileWriter->Serialize(const_cast<uint8*>(Padding), PaddingSize);
+        };
+
+        FileWriter->Serialize(&Header, sizeof(Header));
+        FileWriter->Serialize(Entries.GetData(), Entries.Num() * sizeof(FMeshFileStreamEntry));
+        for (int32 StreamIndex = 0; StreamIndex < Streams.Num(); ++StreamIndex)
+        {
+            const FMeshFileStreamEntry& Entry = Entries[StreamIndex];
+            const uint8* Stored = Entry.Compression != static_cast<uint32>(EMeshFileCompression::None) ? Streams[StreamIndex].Compressed.GetData() : Streams[StreamIndex].Data;
+            WritePadding(Entry.Offset);
+            FileWriter->Serialize(const_cast<uint8*>(Stored), Entry.StoredSize);
+        }
+        WritePadding(Header.FileSize);
+
+        const bool bWritten = FileWriter->Close() && !FileWriter->IsError();
+        FileWriter.Reset();
+        if (!bWritten || !IFileManager::Get().Move(*FilePath, *TempPath, true))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to write mesh file: %s"), *FilePath);
+            IFileManager::Get().Delete(*TempPath);
+            return false;
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool BindStream(TConstArrayView<T>& OutView, const FMeshFileStreamEntry& Entry, const uint8* Data)
+    {
+        if (Entry.ElementSize != sizeof(T) || Entry.NumElements > static_cast<uint64>(MAX_int32))
+        {
+            return false;
+        }
+        OutView = MakeArrayView(reinterpret_cast<const T*>(Data), static_cast<int32>(Entry.NumElements));
+        return true;
+    }
+
+    bool BindMeshDataStream(FProcMeshDataView& View, const FMeshFileStreamEntry& Entry, const uint8* Data)
+    {
+        switch (static_cast<EMeshFileStream>(Entry.Type))
+        {
+        case EMeshFileStream::Vertices:     return BindStream(View.Vertices, Entry, Data);
+        case EMeshFileStream::Triangles:    return BindStream(View.Triangles, Entry, Data);
+        case EMeshFileStream::Normals:      return BindStream(View.Normals, Entry, Data);
+        case EMeshFileStream::UV0:          return BindStream(View.UV0, Entry, Data);
+        case EMeshFileStream::VertexColors: return BindStream(View.VertexColors, Entry, Data);
+        case EMeshFileStream::Tangents:     return BindStream(View.Tangents, Entry, Data);
+        default:                            return false;
+        }
+    }
+
+    bool BindMeshBufferStream(FProcMeshBufferView& View, const FMeshFileStreamEntry& Entry, const uint8* Data)
+    {
+        switch (static_cast<EMeshFileStream>(Entry.Type))
+        {
+        case EMeshFileStream::PositionX:       return BindStream(View.PositionX, Entry, Data);
+        case EMeshFileStream::PositionY:       return BindStream(View.PositionY, Entry, Data);
+        case EMeshFileStream::PositionZ:       return BindStream(View.PositionZ, Entry, Data);
+        case EMeshFileStream::BufferTriangles: return BindStream(View.Triangles, Entry, Data);
+        case EMeshFileStream::NormalX:         return BindStream(View.NormalX, Entry, Data);
+        case EMeshFileStream::NormalY:         return BindStream(View.NormalY, Entry, Data);
+        case EMeshFileStream::NormalZ:         return BindStream(View.NormalZ, Entry, Data);
+        case EMeshFileStream::U:               return BindStream(View.U, Entry, Data);
+        case EMeshFileStream::V:               return BindStream(View.V, Entry, Data);
+        case EMeshFileStream::Colors:          return BindStream(View.Colors, Entry, Data);
+        case EMeshFileStream::TangentX:        return BindStream(View.TangentX, Entry, Data);
+        case EMeshFileStream::TangentY:        return BindStream(View.TangentY, Entry, Data);
+        case EMeshFileStream::TangentZ:        return BindStream(View.TangentZ, Entry, Data);
+        case EMeshFileStream::BinormalSign:    return BindStream(View.BinormalSign, Entry, Data);
+        default:                               return false;
+        }
+    }
+}
+
+
+// -- FProcMeshFile implementation --
+FProcMeshFile::~FProcMeshFile()
+{
+    // 영역을 먼저 해제한 뒤 파일 핸들을 닫는다
+    MappedRegion.Reset();
+    MappedFile.Reset();
+}
+
+bool FProcMeshFile::Save(const FString& FilePath, const FProcMeshDataView& MeshData, bool bCompress)
+{
+    TArray<FStreamSource> Streams;
+    AddStream(Streams, EMeshFileStream::Vertices, MeshData.Vertices);
+    AddStream(Streams, EMeshFileStream::Triangles, MeshData.Triangles);
+    AddStream(Streams, EMeshFileStream::Normals, MeshData.Normals);
+    AddStream(Streams, EMeshFileStream::UV0, MeshData.UV0);
+    AddStream(Streams, EMeshFileStream::VertexColors, MeshData.VertexColors);
+    AddStream(Streams, EMeshFileStream::Tangents, MeshData.Tangents);
+    return WriteStreams(FilePath, EMeshFileLayout::MeshData, Streams, bCompress);
+}
+
+bool FProcMeshFile::Save(const FString& FilePath, const FProcMeshBufferView& MeshBuffer, bool bCompress)
+{
+    TArray<FStreamSource> Streams;
+    AddStream(Streams, EMeshFileStream::PositionX, MeshBuffer.PositionX);
+    AddStream(Streams, EMeshFileStream::PositionY, MeshBuffer.PositionY);
+    AddStream(Streams, EMeshFileStream::PositionZ, MeshBuffer.PositionZ);
+    AddStream(Streams, EMeshFileStream::BufferTriangles, MeshBuffer.Triangles);
+    AddStream(Streams, EMeshFileStream::NormalX, MeshBuffer.NormalX);
+    AddStream(Streams, EMeshFileStream::NormalY, MeshBuffer.NormalY);
+    AddStream(Streams, EMeshFileStream::NormalZ, MeshBuffer.NormalZ);
+    AddStream(Streams, EMeshFileStream::U, MeshBuffer.U);
+    AddStream(Streams, EMeshFileStream::V, MeshBuffer.V);
+    AddStream(Streams, EMeshFileStream::Colors, MeshBuffer.Colors);
+    AddStream(Streams, EMeshFileStream::TangentX, MeshBuffer.TangentX);
+    AddStream(Streams, EMeshFileStream::TangentY, MeshBuffer.TangentY);
+    AddStream(Streams, EMeshFileStream::TangentZ, MeshBuffer.TangentZ);
+    AddStream(Streams, EMeshFileStream::BinormalSign, MeshBuffer.BinormalSign);
+    return WriteStreams(FilePath, EMeshFileLayout::MeshBuffer, Streams, bCompress);
+}
+
+TSharedPtr<const FProcMeshFile, ESPMode::ThreadSafe> FProcMeshFile::Load(const FString& FilePath, bool bVerifyChecksum)
+{
+    TSharedPtr<FProcMeshFile, ESPMode::ThreadSafe> File = MakeShareable(new FProcMeshFile());
+
+    // 1. 파일 전체를 매핑하고, 지원하지 않으면 한 번에 읽는다
+    const uint8* FileBase = nullptr;
+    uint64 FileSize = 0;
+    File->MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (File->MappedFile.IsValid() && File->MappedFile->GetFileSize() >= static_cast<int64>(sizeof(FMeshFileHeader)))
+    {
+        File->MappedRegion.Reset(File->MappedFile->MapRegion(0, File->MappedFile->GetFileSize()));
+    }
+    if (File->MappedRegion.IsValid())
+    {
+        FileBase = File->MappedRegion->GetMappedPtr();
+        FileSize = File->MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        File->MappedFile.Reset();
+        if (!FFileHelper::LoadFileToArray(File->FileData, *FilePath, FILEREAD_Silent))
+        {
+            return nullptr;
+        }
+        FileBase = File->FileData.GetData();
+        FileSize = File->FileData.Num();
+    }
+
+    // 2. 헤더와 스트림 표 확인
+    auto Corrupted = [&FilePath]()
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Corrupted or incompatible mesh file: %s"), *FilePath);
+        return nullptr;
+    };
+
+    FMeshFileHeader Header;
+    if (FileSize < sizeof(Header))
+    {
+        return Corrupted();
+    }
+    FMemory::Memcpy(&Header, FileBase, sizeof(Header));
+    const uint64 TableEnd = sizeof(Header) + static_cast<uint64>(Header.NumStreams) * sizeof(FMeshFileStreamEntry);
+    if (Header.Magic != MeshFileMagic || Header.Version != MeshFileVersion || Header.FileSize != FileSize
+        || Header.Layout > static_cast<uint32>(EMeshFileLayout::MeshBuffer)
+        || Header.NumStreams > static_cast<uint32>(EMeshFileStream::Num) || TableEnd > FileSize)
+    {
+        return Corrupted();
+    }
+    const EMeshFileLayout Layout = static_cast<EMeshFileLayout>(Header.Layout);
+
+    TArray<FMeshFileStreamEntry> Entries;
+    Entries.SetNumUninitialized(Header.NumStreams);
+    FMemory::Memcpy(Entries.GetData(), FileBase + sizeof(Header), Header.NumStreams * sizeof(FMeshFileStreamEntry));
+    if (HashHeaderAndTable(Header, Entries) != Header.Checksum)
+    {
+        return Corrupted();
+    }
+    // 할당 전에 스트림 종류와 원소 크기를 레이아웃과 맞춰 보고, 해제 크기가 저장 크기로 가능한 범위인지 확인한다
+    uint32 SeenTypes = 0;
+    for (const FMeshFileStreamEntry& Entry : Entries)
+    {
+        if (Entry.Type >= static_cast<uint32>(EMeshFileStream::Num) || (SeenTypes & (1u << Entry.Type)) != 0
+            || Entry.ElementSize != GetExpectedElementSize(Layout, static_cast<EMeshFileStream>(Entry.Type)))
+        {
+            return Corrupted();
+        }
+        SeenTypes |= 1u << Entry.Type;
+
+        const uint64 RawSize = Entry.NumElements * Entry.ElementSize;
+        const bool bAligned = Entry.Offset % StreamAlignment == 0;
+        const bool bInFile = Entry.Offset >= TableEnd && Entry.StoredSize <= FileSize && Entry.Offset <= FileSize - Entry.StoredSize;
+        bool bSizeValid = Entry.NumElements <= static_cast<uint64>(MAX_int32);
+        if (Entry.Compression == static_cast<uint32>(EMeshFileCompression::None))
+        {
+            bSizeValid = bSizeValid && Entry.StoredSize == RawSize;
+        }
+        else if (Entry.Compression == static_cast<uint32>(EMeshFileCompression::LZ4Blocks))
+        {
+            const uint64 TableSize = FMath::DivideAndRoundUp<uint64>(RawSize, CompressionBlockSize) * sizeof(uint32);
+            bSizeValid = bSizeValid && TableSize <= Entry.StoredSize && RawSize <= Entry.StoredSize * MaxCompressionRatio;
+        }
+        else
+        {
+            bSizeValid = false;
+        }
+        if (!bAligned || !bInFile || !bSizeValid)
+        {
+            return Corrupted();
+        }
+    }
+
+    // 3. 스트림 체크섬 확인과 압축 해제 (스트림별 병렬)
+    File->DecompressedStreams.SetNum(Entries.Num());
+    std::atomic<bool> bFailed(false);
+    ParallelFor(Entries.Num(), [&](int32 StreamIndex)
+        {
+            const FMeshFileStreamEntry& Entry = Entries[StreamIndex];
+            const uint8* Stored = FileBase + Entry.Offset;
+            if (bVerifyChecksum && FXxHash64::HashBuffer(Stored, Entry.StoredSize).Hash != Entry.Checksum)
+            {
+                bFailed = true;
+                return;
+            }
+            if (Entry.Compression == static_cast<uint32>(EMeshFileCompression::LZ4Blocks))
+            {
+                TArray64<uint8>& Decompressed = File->DecompressedStreams[StreamIndex];
+                Decompressed.SetNumUninitialized(Entry.NumElements * Entry.ElementSize);
+                if (!DecompressStream(Stored, Entry.StoredSize, Decompressed.GetData(), Decompressed.Num()))
+                {
+                    bFailed = true;
+                }
+            }
+        });
+    if (bFailed)
+    {
+        return Corrupted();
+    }
+
+    // 4. 뷰 연결. 압축하지 않은 스트림은 매핑된 파일을 그대로 가리킨다.
+    File->bIsBuffer = Layout == EMeshFileLayout::MeshBuffer;
+    for (int32 StreamIndex = 0; StreamIndex < Entries.Num(); ++StreamIndex)
+    {
+        const FMeshFileStreamEntry& Entry = Entries[StreamIndex];
+        const uint8* Data = Entry.Compression == static_cast<uint32>(EMeshFileCompression::None)
+            ? FileBase + Entry.Offset
+            : File->DecompressedStreams[StreamIndex].GetData();
+        const bool bBound = File->bIsBuffer
+            ? BindMeshBufferStream(File->MeshBuffer, Entry, Data)
+            : BindMeshDataStream(File->MeshData, Entry, Data);
+        if (!bBound)
+        {
+            return Corrupted();
+        }
+    }
+
+    // 압축 스트림만 있으면 매핑은 더 필요 없다
+    const bool bUsesFile = Entries.ContainsByPredicate([](const FMeshFileStreamEntry& Entry)
+        {
+            return Entry.Compression == static_cast<uint32>(EMeshFileCompression::None);
+        });
+    if (!bUsesFile)
+    {
+        File->MappedRegion.Reset();
+        File->MappedFile.Reset();
+        File->FileData.Empty();
+    }
+    return File;
+}
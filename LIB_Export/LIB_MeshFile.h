@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LIB_Export.h"
+#include "LIB_MeshBuffer.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * FProcMeshData / FProcMeshBuffer 를 저장하는 버전 있는 바이너리 파일.
+ * 속성 배열(스트림)마다 64바이트 정렬된 구간에 메모리 표현 그대로 저장하므로, 압축하지 않은 파일은
+ * 메모리 매핑한 영역을 그대로 뷰로 넘겨 원소 단위 역직렬화 없이 변환할 수 있습니다.
+ * 압축을 켜면 스트림을 LZ4 블록으로 나누어 병렬로 압축/해제합니다.
+ * 헤더와 스트림 표, 스트림마다 XxHash64 체크섬을 둡니다.
+ */
+class FProcMeshFile
+{
+public:
+	~FProcMeshFile();
+
+	// 임시 파일에 쓴 뒤 교체합니다. 아무 스레드에서나 호출할 수 있습니다.
+	static bool Save(const FString& FilePath, const FProcMeshDataView& MeshData, bool bCompress = false);
+	static bool Save(const FString& FilePath, const FProcMeshBufferView& MeshBuffer, bool bCompress = false);
+
+	/**
+	 * 파일을 메모리 매핑하고 (지원하지 않는 플랫폼은 한 번에 읽고) 스트림을 뷰로 묶습니다.
+	 * 압축된 스트림만 새 버퍼로 해제합니다. 반환된 객체가 살아 있는 동안 뷰가 유효합니다.
+	 * @param bVerifyChecksum 스트림 체크섬까지 확인 (파일 전체를 한 번 읽게 됨). 헤더와 스트림 표는 항상 확인합니다.
+	 * @return 형식이 다르거나 손상된 파일이면 nullptr
+	 */
+	static TSharedPtr<const FProcMeshFile, ESPMode::ThreadSafe> Load(const FString& FilePath, bool bVerifyChecksum = true);
+
+	// FProcMeshBuffer 로 저장한 파일이면 true (GetMeshBuffer), 아니면 GetMeshData 를 사용
+	bool IsBuffer() const { return bIsBuffer; }
+	// 압축하지 않은 스트림이 매핑된 파일을 직접 가리키는지
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+	const FProcMeshDataView& GetMeshData() const { return MeshData; }
+	const FProcMeshBufferView& GetMeshBuffer() const { return MeshBuffer; }
+
+private:
+	FProcMeshFile() = default;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> FileData;					// 매핑을 쓸 수 없을 때 읽은 파일 전체
+	TArray<TArray64<uint8>> DecompressedStreams;
+
+	bool bIsBuffer = false;
+	FProcMeshDataView MeshData;
+	FProcMeshBufferView MeshBuffer;
+};
@@ -0,0 +1,3227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_MeshProcessing.h"
+#include "LIB_MeshBuffer.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "EngineDefines.h"
+#include "Hash/CityHash.h"
+
+namespace LIB_MeshProcessing
+{
+    namespace
+    {
+        // A 에서 B, C 로 향하는 두 변 사이의 각도 (라디안)
+        float CornerAngle(const FVector3f& A, const FVector3f& B, const FVector3f& C)
+        {
+            const FVector3f AB = (B - A).GetSafeNormal();
+            const FVector3f AC = (C - A).GetSafeNormal();
+            return FMath::Acos(FMath::Clamp(FVector3f::DotProduct(AB, AC), -1.0f, 1.0f));
+        }
+
+        // 분할된 정점에 원본 정점의 속성을 복사한다. 속성이 일부만 있는 경우 기본값으로 채운다.
+        template<typename T>
+        void AppendSplitAttribute(TArray<T>& Attribute, const int32 NumVertices, TConstArrayView<int32> SourceVertices, const T& DefaultValue)
+        {
+            if (Attribute.Num() == 0)
+            {
+                return;
+            }
+
+            if (Attribute.Num() != NumVertices)
+            {
+                const int32 OldNum = Attribute.Num();
+                Attribute.SetNum(NumVertices);
+                for (int32 i = OldNum; i < NumVertices; ++i)
+                {
+                    Attribute[i] = DefaultValue;
+                }
+            }
+
+            Attribute.AddUninitialized(SourceVertices.Num());
+            T* Data = Attribute.GetData();
+            ParallelForRange(SourceVertices.Num(), [Data, NumVertices, SourceVertices](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        Data[NumVertices + i] = Data[SourceVertices[i]];
+                    }
+                });
+        }
+
+        // BuildMeshDescription 이 입력 형식(FProcMeshData / FProcMeshBuffer)과 무관하게 정점 속성을 읽기 위한 접근자
+        struct FMeshDataAccessor
+        {
+            const FProcMeshDataView& Mesh;
+
+            int32 NumVertices() const { return Mesh.Vertices.Num(); }
+            TConstArrayView<int32> Triangles() const { return Mesh.Triangles; }
+            FVector3f Position(const int32 i) const { return FVector3f(Mesh.Vertices[i]); }
+
+            bool HasNormal(const int32 i) const { return Mesh.Normals.IsValidIndex(i); }
+            bool HasUV(const int32 i) const { return Mesh.UV0.IsValidIndex(i); }
+            bool HasColor(const int32 i) const { return Mesh.VertexColors.IsValidIndex(i); }
+            bool HasTangent(const int32 i) const { return Mesh.Tangents.IsValidIndex(i); }
+
+            FVector3f Normal(const int32 i) const { return FVector3f(Mesh.Normals[i]); }
+            FVector2f UV(const int32 i) const { return FVector2f(Mesh.UV0[i]); }
+            const FLinearColor& Color(const int32 i) const { return Mesh.VertexColors[i]; }
+            FVector3f Tangent(const int32 i) const { return FVector3f(Mesh.Tangents[i].TangentX); }
+            float BinormalSign(const int32 i) const { return Mesh.Tangents[i].bFlipTangentY ? -1.0f : 1.0f; }
+        };
+
+        struct FMeshBufferAccessor
+        {
+            const FProcMeshBufferView& Mesh;
+
+            int32 NumVertices() const { return Mesh.NumVertices(); }
+            TConstArrayView<int32> Triangles() const { return Mesh.Triangles; }
+            FVector3f Position(const int32 i) const { return FVector3f(Mesh.PositionX[i], Mesh.PositionY[i], Mesh.PositionZ[i]); }
+
+            bool HasNormal(const int32 i) const { return Mesh.NormalX.IsValidIndex(i); }
+            bool HasUV(const int32 i) const { return Mesh.U.IsValidIndex(i); }
+            bool HasColor(const int32 i) const { return Mesh.Colors.IsValidIndex(i); }
+            bool HasTangent(const int32 i) const { return Mesh.TangentX.IsValidIndex(i); }
+
+            FVector3f Normal(const int32 i) const { return FVector3f(Mesh.NormalX[i], Mesh.NormalY[i], Mesh.NormalZ[i]); }
+            FVector2f UV(const int32 i) const { return FVector2f(Mesh.U[i], Mesh.V[i]); }
+            const FLinearColor& Color(const int32 i) const { return Mesh.Colors[i]; }
+            FVector3f Tangent(const int32 i) const { return FVector3f(Mesh.TangentX[i], Mesh.TangentY[i], Mesh.TangentZ[i]); }
+            float BinormalSign(const int32 i) const { return Mesh.BinormalSign[i]; }
+        };
+
+        // 정점 인스턴스 중복 제거용 키. 비트 단위로 비교/해시하므로 패딩까지 0으로 초기화한다.
+        struct FProcVertexInstanceKey
+        {
+            int32 VertexSlot;
+            FVector3f Normal;
+            FVector2f UV;
+            FLinearColor Color;
+            FVector3f Tangent;
+            float BinormalSign;
+
+            template<typename AccessorType>
+            FProcVertexInstanceKey(const AccessorType& Mesh, const int32 VertIndex, const int32 InVertexSlot)
+            {
+                FMemory::Memzero(this, sizeof(*this));
+                VertexSlot = InVertexSlot;
+                Normal = Mesh.HasNormal(VertIndex) ? Mesh.Normal(VertIndex) : FVector3f::ZeroVector;
+                UV = Mesh.HasUV(VertIndex) ? Mesh.UV(VertIndex) : FVector2f::ZeroVector;
+                Color = Mesh.HasColor(VertIndex) ? Mesh.Color(VertIndex) : FLinearColor::White;
+                Tangent = Mesh.HasTangent(VertIndex) ? Mesh.Tangent(VertIndex) : FVector3f::ZeroVector;
+                BinormalSign = Mesh.HasTangent(VertIndex) ? Mesh.BinormalSign(VertIndex) : 1.0f;
+            }
+
+            bool operator==(const FProcVertexInstanceKey& Other) const
+            {
+                return FMemory::Memcmp(this, &Other, sizeof(*this)) == 0;
+            }
+
+            friend uint32 GetTypeHash(const FProcVertexInstanceKey& Key)
+            {
+                return CityHash32(reinterpret_cast<const char*>(&Key), sizeof(Key));
+            }
+        };
+
+        // MeshDescription 을 만들기 전에 필요한 모든 원소 수와 매핑을 미리 계산한 결과
+        struct FProcMeshBuildPlan
+        {
+            TArray<int32> VertexSources;        // 고유 정점 -> 원본 정점 인덱스
+            TArray<int32> InstanceSources;      // 고유 인스턴스 -> 원본 정점 인덱스
+            TArray<int32> InstanceVertices;     // 고유 인스턴스 -> 고유 정점
+            TArray<int32> TriangleInstances;    // 유효한 삼각형의 인스턴스 인덱스 (3개씩)
+            TArray<int32> SectionNumTriangles;  // 폴리곤 그룹별 유효한 삼각형 수 (TriangleInstances 앞에서부터 연속)
+        };
+
+        // 구간 하나의 인스턴스 구성. 인스턴스 번호는 구간 안에서 0 부터 매긴다.
+        struct FProcMeshSectionPlan
+        {
+            TArray<int32> InstanceSources;
+            TArray<int32> InstanceVertices;
+            TArray<int32> TriangleInstances;
+        };
+
+        // 정점 -> 인스턴스 캐시. 구간이 하나면 전체 정점 크기의 배열, 여러 개면 구간에서 쓰는 정점만 담는 맵을 쓴다.
+        int32& FindCachedInstance(TArray<int32>& Cache, const int32 VertIndex)
+        {
+            return Cache[VertIndex];
+        }
+
+        int32& FindCachedInstance(TMap<int32, int32>& Cache, const int32 VertIndex)
+        {
+            return Cache.FindOrAdd(VertIndex, INDEX_NONE);
+        }
+
+        // (vertex, normal, UV, color, tangent) 조합이 같으면 하나의 정점 인스턴스를 공유한다.
+        // 삼각형마다 인스턴스를 3개씩 새로 만들면 BuildFromMeshDescriptions 가 다시 용접하느라 시간을 쓴다.
+        template<typename AccessorType, typename InstanceCacheType>
+        void MakeProcMeshSectionPlan(const AccessorType& Mesh, TConstArrayView<int32> VertexSlots, TConstArrayView<int32> Triangles,
+            InstanceCacheType& InstanceForVertex, FProcMeshSectionPlan& Section)
+        {
+            const int32 MaxInstances = FMath::Min(Triangles.Num(), VertexSlots.Num());
+            TMap<FProcVertexInstanceKey, int32> InstanceTable;
+            InstanceTable.Reserve(MaxInstances);
+            Section.InstanceSources.Reset(MaxInstances);
+            Section.InstanceVertices.Reset(MaxInstances);
+
+            auto FindOrAddInstance = [&](const int32 VertIndex) -> int32
+            {
+                // FProcMeshData 의 속성은 정점 인덱스 단위이므로 정점마다 한 번만 조회하면 된다
+                int32& Cached = FindCachedInstance(InstanceForVertex, VertIndex);
+                if (Cached == INDEX_NONE)
+                {
+                    const FProcVertexInstanceKey Key(Mesh, VertIndex, VertexSlots[VertIndex]);
+                    if (const int32* Existing = InstanceTable.Find(Key))
+                    {
+                        Cached = *Existing;
+                    }
+                    else
+                    {
+                        Cached = Section.InstanceSources.Add(VertIndex);
+                        Section.InstanceVertices.Add(VertexSlots[VertIndex]);
+                        InstanceTable.Add(Key, Cached);
+                    }
+                }
+                return Cached;
+            };
+
+            // 유효한 삼각형 수집
+            Section.TriangleInstances.Reset(Triangles.Num());
+            for (int32 i = 0; i < Triangles.Num(); i += 3)
+            {
+                const int32 Index0 = Triangles[i];
+                const int32 Index1 = Triangles[i + 1];
+                const int32 Index2 = Triangles[i + 2];
+
+                // 유효하지 않은 인덱스가 있으면 해당 삼각형 전체를 건너뛰기
+                if (!VertexSlots.IsValidIndex(Index0) || !VertexSlots.IsValidIndex(Index1) || !VertexSlots.IsValidIndex(Index2))
+                {
+                    continue;
+                }
+
+                // 위치 용접으로 한 점으로 붕괴된 삼각형은 만들지 않는다
+                if (VertexSlots[Index0] == VertexSlots[Index1] || VertexSlots[Index1] == VertexSlots[Index2] || VertexSlots[Index0] == VertexSlots[Index2])
+                {
+                    continue;
+                }
+
+                Section.TriangleInstances.Add(FindOrAddInstance(Index0));
+                Section.TriangleInstances.Add(FindOrAddInstance(Index1));
+                Section.TriangleInstances.Add(FindOrAddInstance(Index2));
+            }
+        }
+
+        template<typename AccessorType>
+        void MakeProcMeshBuildPlan(const AccessorType& Mesh, TConstArrayView<int32> SectionNumTriangles, FProcMeshBuildPlan& Plan)
+        {
+            const int32 NumVertices = Mesh.NumVertices();
+            const TConstArrayView<int32> Triangles = Mesh.Triangles();
+
+            // 1. 같은 위치의 정점은 하나의 FVertexID를 공유
+            // LOD 인덱스 버퍼처럼 일부 정점만 참조하는 경우를 위해 참조되지 않는 정점은 만들지 않는다
+            TBitArray<> Referenced(false, NumVertices);
+            for (const int32 Index : Triangles)
+            {
+                if (Index >= 0 && Index < NumVertices)
+                {
+                    Referenced[Index] = true;
+                }
+            }
+
+            TArray<int32> VertexSlots;
+            VertexSlots.SetNumUninitialized(NumVertices);
+            Plan.VertexSources.Reset(NumVertices);
+            {
+                TMap<FVector3f, int32> PositionToSlot;
+                PositionToSlot.Reserve(NumVertices);
+                for (int32 i = 0; i < NumVertices; i++)
+                {
+                    if (!Referenced[i])
+                    {
+                        VertexSlots[i] = INDEX_NONE;
+                        continue;
+                    }
+
+                    const FVector3f Position = Mesh.Position(i);
+                    if (const int32* Existing = PositionToSlot.Find(Position))
+                    {
+                        VertexSlots[i] = *Existing;
+                        continue;
+                    }
+                    VertexSlots[i] = Plan.VertexSources.Add(i);
+                    PositionToSlot.Add(Position, VertexSlots[i]);
+                }
+            }
+
+            // 2. 구간(폴리곤 그룹)마다 정점 인스턴스와 삼각형을 만든다
+            Plan.SectionNumTriangles.Reset();
+            if (SectionNumTriangles.Num() <= 1)
+            {
+                TArray<int32> InstanceForVertex;
+                InstanceForVertex.Init(INDEX_NONE, NumVertices);
+                FProcMeshSectionPlan Section;
+                MakeProcMeshSectionPlan(Mesh, VertexSlots, Triangles, InstanceForVertex, Section);
+                Plan.InstanceSources = MoveTemp(Section.InstanceSources);
+                Plan.InstanceVertices = MoveTemp(Section.InstanceVertices);
+                Plan.TriangleInstances = MoveTemp(Section.TriangleInstances);
+                Plan.SectionNumTriangles.Add(Plan.TriangleInstances.Num() / 3);
+                return;
+            }
+
+            // 구간끼리는 인스턴스를 공유하지 않으므로 (섹션마다 정점 범위가 따로 잡히도록) 병렬로 만든다
+            TArray<int32> SectionFirstIndex;
+            SectionFirstIndex.SetNumUninitialized(SectionNumTriangles.Num());
+            int32 FirstIndex = 0;
+            for (int32 SectionIndex = 0; SectionIndex < SectionNumTriangles.Num(); ++SectionIndex)
+            {
+                SectionFirstIndex[SectionIndex] = FirstIndex;
+                FirstIndex += SectionNumTriangles[SectionIndex] * 3;
+            }
+            check(FirstIndex == Triangles.Num());
+
+            TArray<FProcMeshSectionPlan> Sections;
+            Sections.SetNum(SectionNumTriangles.Num());
+            ParallelFor(Sections.Num(), [&](int32 SectionIndex)
+                {
+                    const TConstArrayView<int32> SectionTriangles = Triangles.Slice(SectionFirstIndex[SectionIndex], SectionNumTriangles[SectionIndex] * 3);
+                    TMap<int32, int32> InstanceForVertex;
+                    InstanceForVertex.Reserve(FMath::Min(SectionTriangles.Num(), NumVertices));
+                    MakeProcMeshSectionPlan(Mesh, VertexSlots, SectionTriangles, InstanceForVertex, Sections[SectionIndex]);
+                });
+
+            // 3. 구간별 인스턴스 번호를 앞 구간의 인스턴스 수만큼 밀어 합친다
+            Plan.TriangleInstances.Reset(Triangles.Num());
+            for (const FProcMeshSectionPlan& Section : Sections)
+            {
+                // 용접으로 삼각형이 모두 붕괴된 구간은 빈 섹션이 되지 않도록 뺀다
+                if (Section.TriangleInstances.Num() == 0)
+                {
+                    continue;
+                }
+
+                const int32 BaseInstance = Plan.InstanceSources.Num();
+                Plan.InstanceSources.Append(Section.InstanceSources);
+                Plan.InstanceVertices.Append(Section.InstanceVertices);
+                for (const int32 Instance : Section.TriangleInstances)
+                {
+                    Plan.TriangleInstances.Add(BaseInstance + Instance);
+                }
+                Plan.SectionNumTriangles.Add(Section.TriangleInstances.Num() / 3);
+            }
+            if (Plan.SectionNumTriangles.Num() == 0)
+            {
+                Plan.SectionNumTriangles.Add(0);
+            }
+        }
+
+        // UV 투영 커널이 한 번에 처리하는 정점 수 (스택에 성분별 배열로 모은다)
+        constexpr int32 UVBatchSize = 256;
+
+        struct FUVProjectionBatch
+        {
+            alignas(16) float X[UVBatchSize];
+            alignas(16) float Y[UVBatchSize];
+            alignas(16) float Z[UVBatchSize];
+            alignas(16) float NX[UVBatchSize];
+            alignas(16) float NY[UVBatchSize];
+            alignas(16) float NZ[UVBatchSize];
+            alignas(16) float U[UVBatchSize];
+            alignas(16) float V[UVBatchSize];
+        };
+
+        /**
+         * UV 자동 생성 투영.
+         * 위치(와 박스 모드의 법선)를 투영축 기준 좌표계 (AxisU, AxisV, AxisW) 로 옮긴 뒤 모드별 UV 를 4개씩 SIMD 로 계산한다.
+         * 투영축이 +Z 이고 배율 1, 오프셋 0 인 평면 투영은 기존 XY 투영과 같은 결과를 낸다.
+         */
+        struct FUVProjector
+        {
+            EProcUVProjection Mode;
+            FVector3f AxisU;
+            FVector3f AxisV;
+            FVector3f AxisW;
+            FVector3f Center;
+            FVector2f Scale;
+            FVector2f Offset;
+
+            explicit FUVProjector(const FProcMeshConvertOptions& Options)
+                : Mode(Options.UVProjection)
+                , Center(Options.UVProjectionCenter)
+                , Scale(Options.UVScale)
+                , Offset(Options.UVOffset)
+            {
+                // +Z 를 투영축으로 돌리는 회전으로 나머지 두 축을 정한다 (+Z 이면 X, Y 그대로)
+                AxisW = FVector3f(Options.UVProjectionAxis).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UnitZ());
+                const FQuat4f Rotation = FQuat4f::FindBetweenNormals(FVector3f::UnitZ(), AxisW);
+                AxisU = Rotation.RotateVector(FVector3f::UnitX());
+                AxisV = Rotation.RotateVector(FVector3f::UnitY());
+            }
+
+            bool NeedsNormals() const { return Mode == EProcUVProjection::Box; }
+
+            // 위치 성분 배열을 그대로 UV 로 쓸 수 있는 경우 (기존 XY 투영)
+            bool IsIdentity() const
+            {
+                return Mode == EProcUVProjection::Planar && AxisW == FVector3f::UnitZ() && Center.IsZero()
+                    && Scale == FVector2f::UnitVector && Offset.IsZero();
+            }
+
+            // Num 은 4의 배수여야 한다
+            void Project(FUVProjectionBatch& Batch, const int32 Num) const
+            {
+                switch (Mode)
+                {
+                case EProcUVProjection::Box:         ProjectBatch<EProcUVProjection::Box>(Batch, Num); break;
+                case EProcUVProjection::Cylindrical: ProjectBatch<EProcUVProjection::Cylindrical>(Batch, Num); break;
+                case EProcUVProjection::Spherical:   ProjectBatch<EProcUVProjection::Spherical>(Batch, Num); break;
+                default:                             ProjectBatch<EProcUVProjection::Planar>(Batch, Num); break;
+                }
+            }
+
+        private:
+            static VectorRegister4Float Dot(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Float& Z, const FVector3f& Axis)
+            {
+                return VectorMultiplyAdd(Z, VectorSetFloat1(Axis.Z), VectorMultiplyAdd(Y, VectorSetFloat1(Axis.Y), VectorMultiply(X, VectorSetFloat1(Axis.X))));
+            }
+
+            // 음수면 -1, 아니면 1
+            static VectorRegister4Float Sign(const VectorRegister4Float& Value)
+            {
+                return VectorSelect(VectorCompareGE(Value, VectorZeroFloat()), VectorOneFloat(), VectorNegate(VectorOneFloat()));
+            }
+
+            // 축 둘레의 각도를 [0, 1] 로
+            static VectorRegister4Float Azimuth(const VectorRegister4Float& LocalU, const VectorRegister4Float& LocalV)
+            {
+                return VectorMultiplyAdd(VectorATan2(LocalV, LocalU), VectorSetFloat1(0.5f / UE_PI), VectorSetFloat1(0.5f));
+            }
+
+            template<EProcUVProjection ProjectionMode>
+            void ProjectBatch(FUVProjectionBatch& Batch, const int32 Num) const
+            {
+                const VectorRegister4Float CenterX = VectorSetFloat1(Center.X);
+                const VectorRegister4Float CenterY = VectorSetFloat1(Center.Y);
+                const VectorRegister4Float CenterZ = VectorSetFloat1(Center.Z);
+                const VectorRegister4Float ScaleU = VectorSetFloat1(Scale.X);
+                const VectorRegister4Float ScaleV = VectorSetFloat1(Scale.Y);
+                const VectorRegister4Float OffsetU = VectorSetFloat1(Offset.X);
+                const VectorRegister4Float OffsetV = VectorSetFloat1(Offset.Y);
+
+                for (int32 i = 0; i < Num; i += 4)
+                {
+                    // 1. 투영 좌표계로 변환
+                    const VectorRegister4Float PX = VectorSubtract(VectorLoadAligned(Batch.X + i), CenterX);
+                    const VectorRegister4Float PY = VectorSubtract(VectorLoadAligned(Batch.Y + i), CenterY);
+                    const VectorRegister4Float PZ = VectorSubtract(VectorLoadAligned(Batch.Z + i), CenterZ);
+                    const VectorRegister4Float LocalU = Dot(PX, PY, PZ, AxisU);
+                    const VectorRegister4Float LocalV = Dot(PX, PY, PZ, AxisV);
+                    const VectorRegister4Float LocalW = Dot(PX, PY, PZ, AxisW);
+
+                    // 2. 모드별 UV
+                    VectorRegister4Float OutU;
+                    VectorRegister4Float OutV;
+                    if constexpr (ProjectionMode == EProcUVProjection::Box)
+                    {
+                        // 법선의 가장 큰 성분 축에 수직인 평면으로 투영. 반대쪽 면이 뒤집혀 보이지 않도록 법선 부호로 U 를 뒤집는다.
+                        const VectorRegister4Float NX = VectorLoadAligned(Batch.NX + i);
+                        const VectorRegister4Float NY = VectorLoadAligned(Batch.NY + i);
+                        const VectorRegister4Float NZ = VectorLoadAligned(Batch.NZ + i);
+                        const VectorRegister4Float NormalU = Dot(NX, NY, NZ, AxisU);
+                        const VectorRegister4Float NormalV = Dot(NX, NY, NZ, AxisV);
+                        const VectorRegister4Float NormalW = Dot(NX, NY, NZ, AxisW);
+                        const VectorRegister4Float AbsU = VectorAbs(NormalU);
+                        const VectorRegister4Float AbsV = VectorAbs(NormalV);
+                        const VectorRegister4Float AbsW = VectorAbs(NormalW);
+
+                        const VectorRegister4Float FacingU = VectorBitwiseAnd(VectorCompareGE(AbsU, AbsV), VectorCompareGE(AbsU, AbsW));
+                        const VectorRegister4Float FacingV = VectorCompareGE(AbsV, AbsW);
+                        OutU = VectorSelect(FacingU, VectorMultiply(LocalV, Sign(NormalU)),
+                            VectorSelect(FacingV, VectorNegate(VectorMultiply(LocalU, Sign(NormalV))), VectorMultiply(LocalU, Sign(NormalW))));
+                        OutV = VectorSelect(FacingU, LocalW, VectorSelect(FacingV, LocalW, LocalV));
+                    }
+                    else if constexpr (ProjectionMode == EProcUVProjection::Cylindrical)
+                    {
+                        // U: 축 둘레 각도 [0, 1], V: 축 방향 거리
+                        OutU = Azimuth(LocalU, LocalV);
+                        OutV = LocalW;
+                    }
+                    else if constexpr (ProjectionMode == EProcUVProjection::Spherical)
+                    {
+                        // U: 축 둘레 각도 [0, 1], V: 축에서 잰 극각 [0, 1]. 중심과 겹친 정점은 적도로 보낸다.
+                        const VectorRegister4Float LengthSquared = VectorMultiplyAdd(LocalW, LocalW, VectorMultiplyAdd(LocalV, LocalV, VectorMultiply(LocalU, LocalU)));
+                        const VectorRegister4Float InvLength = VectorSelect(VectorCompareGT(LengthSquared, VectorSetFloat1(UE_SMALL_NUMBER)), VectorReciprocalSqrt(LengthSquared), VectorZeroFloat());
+                        const VectorRegister4Float CosPolar = VectorMin(VectorMax(VectorMultiply(LocalW, InvLength), VectorNegate(VectorOneFloat())), VectorOneFloat());
+                        OutU = Azimuth(LocalU, LocalV);
+                        OutV = VectorMultiply(VectorACos(CosPolar), VectorSetFloat1(1.0f / UE_PI));
+                    }
+                    else
+                    {
+                        OutU = LocalU;
+                        OutV = LocalV;
+                    }
+
+                    // 3. 배율과 오프셋
+                    VectorStoreAligned(VectorMultiplyAdd(OutU, ScaleU, OffsetU), Batch.U + i);
+                    VectorStoreAligned(VectorMultiplyAdd(OutV, ScaleV, OffsetV), Batch.V + i);
+                }
+            }
+        };
+
+        /**
+         * 정점 범위를 병렬로 나누고, 각 범위를 UVBatchSize 단위로 모아(Gather) 투영한 뒤 결과를 내보낸다(Scatter).
+         * 배치 끝의 4의 배수를 채우는 부분은 0 으로 채워 같은 SIMD 커널로 처리한다.
+         */
+        template<typename GatherFunc, typename ScatterFunc>
+        void RunUVProjection(const FUVProjector& Projector, const int32 NumVertices, GatherFunc&& Gather, ScatterFunc&& Scatter)
+        {
+            ParallelForRange(NumVertices, [&Projector, &Gather, &Scatter](int32 Begin, int32 End)
+                {
+                    FUVProjectionBatch Batch;
+                    for (int32 BatchBegin = Begin; BatchBegin < End; BatchBegin += UVBatchSize)
+                    {
+                        const int32 Num = FMath::Min(UVBatchSize, End - BatchBegin);
+                        const int32 NumPadded = Align(Num, 4);
+                        Gather(BatchBegin, Num, Batch);
+                        for (int32 i = Num; i < NumPadded; ++i)
+                        {
+                            Batch.X[i] = Batch.Y[i] = Batch.Z[i] = 0.0f;
+                            Batch.NX[i] = Batch.NY[i] = 0.0f;
+                            Batch.NZ[i] = 1.0f;
+                        }
+                        Projector.Project(Batch, NumPadded);
+                        Scatter(BatchBegin, Num, Batch);
+                    }
+                });
+        }
+
+        // 정점당 법선 하나 (크리즈 없음)
+        template<typename PositionArray>
+        void ComputeSmoothNormals(const PositionArray& Positions, const int32 NumVertices, TConstArrayView<int32> Triangles, EProcNormalWeighting Weighting, TArray<FVector3f>& OutNormals)
+        {
+            FFaceNormals Faces;
+            ComputeFaceNormals(Positions, Triangles, Weighting, Faces);
+
+            FVertexCornerAdjacency Adjacency;
+            Adjacency.Build(NumVertices, Triangles);
+
+            OutNormals.SetNumUninitialized(NumVertices);
+            ComputeVertexNormals(Faces, Adjacency, OutNormals);
+        }
+
+        // RecalculateNormals 에 넘길 크리즈 각도. 크리즈를 쓰지 않으면 음수 (0 은 완전히 각진 법선)
+        float GetCreaseAngle(const FProcMeshConvertOptions& Options)
+        {
+            return Options.bUseCreaseAngle ? FMath::Max(Options.CreaseAngle, 0.0f) : -1.0f;
+        }
+
+        /**
+         * 크리즈 경계의 정점을 복제합니다.
+         * Triangles 를 복제된 정점 번호로 고치고, 복제 정점을 포함한 정점 법선과 복제 정점의 원본 번호를 돌려줍니다.
+         */
+        template<typename PositionArray>
+        void SplitCreaseVertices(const PositionArray& Positions, const int32 NumVertices, TArray<int32>& Triangles, EProcNormalWeighting Weighting, float CreaseAngleDegrees,
+            TArray<FVector3f>& OutNormals, TArray<int32>& OutSourceVertices)
+        {
+            FFaceNormals Faces;
+            ComputeFaceNormals(Positions, TConstArrayView<int32>(Triangles), Weighting, Faces);
+
+            FVertexCornerAdjacency Adjacency;
+            Adjacency.Build(NumVertices, Triangles);
+
+            // 1. 코너 법선과 스무딩 팬을 구한 뒤 팬마다 정점을 복제
+            TArray<FVector3f> CornerNormals;
+            CornerNormals.SetNumUninitialized(Triangles.Num());
+            TArray<int32> CornerGroup;
+            CornerGroup.SetNumZeroed(Triangles.Num());
+            ComputeCornerNormals(Faces, Adjacency, Triangles, CreaseAngleDegrees, CornerNormals, CornerGroup);
+
+            // 2. 정점별 추가 정점 수 (팬 0은 원본 정점을 그대로 사용)
+            TArray<int32> ExtraOffsets;
+            ExtraOffsets.SetNumZeroed(NumVertices + 1);
+            ParallelForRange(NumVertices, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                    {
+                        int32 NumGroups = 0;
+                        for (const int32 Corner : Adjacency.GetCorners(Vertex))
+                        {
+                            NumGroups = FMath::Max(NumGroups, CornerGroup[Corner] + 1);
+                        }
+                        ExtraOffsets[Vertex + 1] = FMath::Max(NumGroups - 1, 0);
+                    }
+                });
+
+            for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+            {
+                ExtraOffsets[Vertex + 1] += ExtraOffsets[Vertex];
+            }
+            const int32 NumExtra = ExtraOffsets[NumVertices];
+
+            // 3. 인덱스 재배치 및 새 정점의 원본/법선 기록
+            OutSourceVertices.SetNumUninitialized(NumExtra);
+            OutNormals.SetNumZeroed(NumVertices + NumExtra);
+            ParallelForRange(NumVertices, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                    {
+                        for (const int32 Corner : Adjacency.GetCorners(Vertex))
+                        {
+                            const int32 Group = CornerGroup[Corner];
+                            const int32 NewVertex = (Group == 0) ? Vertex : NumVertices + ExtraOffsets[Vertex] + Group - 1;
+                            if (Group > 0)
+                            {
+                                OutSourceVertices[NewVertex - NumVertices] = Vertex;
+                                Triangles[Corner] = NewVertex;
+                            }
+                            OutNormals[NewVertex] = CornerNormals[Corner];
+                        }
+                    }
+                });
+        }
+
+        // FProcMeshData 의 double 법선으로 복사
+        void CopyNormals(TConstArrayView<FVector3f> Normals, TArray<FVector>& OutNormals)
+        {
+            OutNormals.SetNumUninitialized(Normals.Num());
+            FVector* Out = OutNormals.GetData();
+            ParallelForRange(Normals.Num(), [Normals, Out](int32 Begin, int32 End)
+                {
+                    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                    {
+                        Out[Vertex] = FVector(Normals[Vertex]);
+                    }
+                });
+        }
+
+        // FProcMeshBuffer 의 성분별 법선 배열로 복사
+        void CopyNormals(TConstArrayView<FVector3f> Normals, FProcMeshBuffer& OutBuffer)
+        {
+            OutBuffer.NormalX.SetNumUninitialized(Normals.Num());
+            OutBuffer.NormalY.SetNumUninitialized(Normals.Num());
+            OutBuffer.NormalZ.SetNumUninitialized(Normals.Num());
+            float* X = OutBuffer.NormalX.GetData();
+            float* Y = OutBuffer.NormalY.GetData();
+            float* Z = OutBuffer.NormalZ.GetData();
+            ParallelForRange(Normals.Num(), [Normals, X, Y, Z](int32 Begin, int32 End)
+                {
+                    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                    {
+                        X[Vertex] = Normals[Vertex].X;
+                        Y[Vertex] = Normals[Vertex].Y;
+                        Z[Vertex] = Normals[Vertex].Z;
+                    }
+                });
+        }
+
+        /**
+         * MikkTSpace 와 같은 규칙으로 정점 탄젠트 프레임을 계산한다.
+         * 1) 삼각형마다 UV 기울기로 탄젠트/바이탄젠트를 구하고, 2) 코너의 정점 법선 평면에 투영해 코너 각도로 가중한 뒤,
+         * 3) 정점별로 합산하여 법선에 대해 직교화한다. 부호는 (N x T) . B 의 부호이다.
+         * 삼각형 병렬 패스 후 정점 병렬 패스에서 합산하므로 결과는 스레드 수와 무관하다.
+         */
+        template<typename AccessorType>
+        void ComputeTangentFrames(const AccessorType& Mesh, TArray<FVector3f>& OutTangents, TArray<float>& OutSigns)
+        {
+            const int32 NumVertices = Mesh.NumVertices();
+            const TConstArrayView<int32> Indices = Mesh.Triangles();
+            const int32 NumTriangles = Indices.Num() / 3;
+
+            // 1. 삼각형 병렬: 코너별 가중 탄젠트/바이탄젠트와 면 법선
+            TArray<FVector3f> CornerTangents;
+            TArray<FVector3f> CornerBitangents;
+            TArray<FVector3f> FaceNormals;
+            CornerTangents.SetNumUninitialized(NumTriangles * 3);
+            CornerBitangents.SetNumUninitialized(NumTriangles * 3);
+            FaceNormals.SetNumUninitialized(NumTriangles);
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Tri = Begin; Tri < End; ++Tri)
+                    {
+                        const int32 Corners[3] = { Indices[Tri * 3], Indices[Tri * 3 + 1], Indices[Tri * 3 + 2] };
+                        FVector3f* TriTangents = CornerTangents.GetData() + Tri * 3;
+                        FVector3f* TriBitangents = CornerBitangents.GetData() + Tri * 3;
+                        TriTangents[0] = TriTangents[1] = TriTangents[2] = FVector3f::ZeroVector;
+                        TriBitangents[0] = TriBitangents[1] = TriBitangents[2] = FVector3f::ZeroVector;
+                        FaceNormals[Tri] = FVector3f::ZeroVector;
+
+                        if (Corners[0] < 0 || Corners[0] >= NumVertices || Corners[1] < 0 || Corners[1] >= NumVertices || Corners[2] < 0 || Corners[2] >= NumVertices)
+                        {
+                            continue;
+                        }
+
+                        const FVector3f P[3] = { Mesh.Position(Corners[0]), Mesh.Position(Corners[1]), Mesh.Position(Corners[2]) };
+                        FaceNormals[Tri] = FVector3f::CrossProduct(P[2] - P[0], P[1] - P[0]).GetSafeNormal();
+                        if (!Mesh.HasUV(Corners[0]) || !Mesh.HasUV(Corners[1]) || !Mesh.HasUV(Corners[2]))
+                        {
+                            continue;
+                        }
+
+                        const FVector2f T[3] = { Mesh.UV(Corners[0]), Mesh.UV(Corners[1]), Mesh.UV(Corners[2]) };
+                        const FVector3f Edge1 = P[1] - P[0];
+                        const FVector3f Edge2 = P[2] - P[0];
+                        const FVector2f DeltaUV1 = T[1] - T[0];
+                        const FVector2f DeltaUV2 = T[2] - T[0];
+                        const float SignedAreaUV = DeltaUV1.X * DeltaUV2.Y - DeltaUV2.X * DeltaUV1.Y;
+
+                        // UV 가 한 점/선으로 붕괴된 삼각형은 탄젠트에 기여하지 않는다
+                        if (FMath::Abs(SignedAreaUV) <= UE_SMALL_NUMBER)
+                        {
+                            continue;
+                        }
+
+                        const FVector3f FaceTangent = ((Edge1 * DeltaUV2.Y - Edge2 * DeltaUV1.Y) / SignedAreaUV).GetSafeNormal();
+                        const FVector3f FaceBitangent = ((Edge2 * DeltaUV1.X - Edge1 * DeltaUV2.X) / SignedAreaUV).GetSafeNormal();
+                        for (int32 Corner = 0; Corner < 3; ++Corner)
+                        {
+                            const FVector3f N = Mesh.HasNormal(Corners[Corner]) ? Mesh.Normal(Corners[Corner]).GetSafeNormal() : FaceNormals[Tri];
+                            const float Weight = CornerAngle(P[Corner], P[(Corner + 1) % 3], P[(Corner + 2) % 3]);
+                            TriTangents[Corner] = (FaceTangent - N * FVector3f::DotProduct(N, FaceTangent)).GetSafeNormal() * Weight;
+                            TriBitangents[Corner] = (FaceBitangent - N * FVector3f::DotProduct(N, FaceBitangent)).GetSafeNormal() * Weight;
+                        }
+                    }
+                });
+
+            FVertexCornerAdjacency Adjacency;
+            Adjacency.Build(NumVertices, Indices);
+
+            // 2. 정점 병렬: 합산 후 법선에 대해 직교화하고 부호 결정
+            OutTangents.SetNumUninitialized(NumVertices);
+            OutSigns.SetNumUninitialized(NumVertices);
+            ParallelForRange(NumVertices, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                    {
+                        FVector3f TangentSum = FVector3f::ZeroVector;
+                        FVector3f BitangentSum = FVector3f::ZeroVector;
+                        FVector3f FaceNormalSum = FVector3f::ZeroVector;
+                        for (const int32 Corner : Adjacency.GetCorners(Vertex))
+                        {
+                            TangentSum += CornerTangents[Corner];
+                            BitangentSum += CornerBitangents[Corner];
+                            FaceNormalSum += FaceNormals[Corner / 3];
+                        }
+
+                        const FVector3f N = Mesh.HasNormal(Vertex) ? Mesh.Normal(Vertex).GetSafeNormal() : FaceNormalSum.GetSafeNormal();
+                        FVector3f Tangent = (TangentSum - N * FVector3f::DotProduct(N, TangentSum)).GetSafeNormal();
+                        if (Tangent.IsZero())
+                        {
+                            // UV 가 없거나 붕괴된 영역은 법선에 수직인 임의의 축을 쓴다
+                            FVector3f Unused;
+                            (N.IsZero() ? FVector3f::UpVector : N).FindBestAxisVectors(Tangent, Unused);
+                        }
+
+                        OutTangents[Vertex] = Tangent;
+                        OutSigns[Vertex] = FVector3f::DotProduct(FVector3f::CrossProduct(N, Tangent), BitangentSum) < 0.0f ? -1.0f : 1.0f;
+                    }
+                });
+        }
+    }
+
+    void GenerateUVs(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options, TArray<FVector2D>& OutUVs)
+    {
+        const FUVProjector Projector(Options);
+        const int32 NumVertices = MeshData.Vertices.Num();
+
+        // 박스 투영에 쓸 법선이 모자라면 면적 가중 평균 법선을 만든다
+        TArray<FVector3f> FallbackNormals;
+        if (Projector.NeedsNormals() && MeshData.Normals.Num() < NumVertices)
+        {
+            ComputeSmoothNormals(MeshData.Vertices, NumVertices, MeshData.Triangles, EProcNormalWeighting::Area, FallbackNormals);
+        }
+
+        OutUVs.SetNumUninitialized(NumVertices);
+        FVector2D* UVs = OutUVs.GetData();
+        RunUVProjection(Projector, NumVertices,
+            [&MeshData, &Projector, &FallbackNormals](int32 Begin, int32 Num, FUVProjectionBatch& Batch)
+            {
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    const FVector& Position = MeshData.Vertices[Begin + i];
+                    Batch.X[i] = static_cast<float>(Position.X);
+                    Batch.Y[i] = static_cast<float>(Position.Y);
+                    Batch.Z[i] = static_cast<float>(Position.Z);
+                }
+                if (Projector.NeedsNormals())
+                {
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        const FVector3f Normal = FallbackNormals.Num() > 0 ? FallbackNormals[Begin + i] : FVector3f(MeshData.Normals[Begin + i]);
+                        Batch.NX[i] = Normal.X;
+                        Batch.NY[i] = Normal.Y;
+                        Batch.NZ[i] = Normal.Z;
+                    }
+                }
+            },
+            [UVs](int32 Begin, int32 Num, const FUVProjectionBatch& Batch)
+            {
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    UVs[Begin + i] = FVector2D(Batch.U[i], Batch.V[i]);
+                }
+            });
+    }
+
+    void GenerateUVs(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options, FProcMeshBuffer& OutBuffer)
+    {
+        const FUVProjector Projector(Options);
+        const int32 NumVertices = MeshBuffer.NumVertices();
+
+        TArray<FVector3f> FallbackNormals;
+        if (Projector.NeedsNormals() && !MeshBuffer.HasNormals())
+        {
+            ComputeSmoothNormals(MeshBuffer.GetPositions(), NumVertices, MeshBuffer.Triangles, EProcNormalWeighting::Area, FallbackNormals);
+        }
+
+        // 성분별 배열이므로 배치로 모으는 것은 연속 복사
+        auto CopyComponent = [](TConstArrayView<float> Source, const int32 Begin, const int32 Num, float* Out)
+        {
+            FMemory::Memcpy(Out, Source.GetData() + Begin, Num * sizeof(float));
+        };
+
+        OutBuffer.U.SetNumUninitialized(NumVertices);
+        OutBuffer.V.SetNumUninitialized(NumVertices);
+        float* U = OutBuffer.U.GetData();
+        float* V = OutBuffer.V.GetData();
+        RunUVProjection(Projector, NumVertices,
+            [&MeshBuffer, &Projector, &FallbackNormals, &CopyComponent](int32 Begin, int32 Num, FUVProjectionBatch& Batch)
+            {
+                CopyComponent(MeshBuffer.PositionX, Begin, Num, Batch.X);
+                CopyComponent(MeshBuffer.PositionY, Begin, Num, Batch.Y);
+                CopyComponent(MeshBuffer.PositionZ, Begin, Num, Batch.Z);
+                if (!Projector.NeedsNormals())
+                {
+                    return;
+                }
+
+                if (FallbackNormals.Num() > 0)
+                {
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        Batch.NX[i] = FallbackNormals[Begin + i].X;
+                        Batch.NY[i] = FallbackNormals[Begin + i].Y;
+                        Batch.NZ[i] = FallbackNormals[Begin + i].Z;
+                    }
+                }
+                else
+                {
+                    CopyComponent(MeshBuffer.NormalX, Begin, Num, Batch.NX);
+                    CopyComponent(MeshBuffer.NormalY, Begin, Num, Batch.NY);
+                    CopyComponent(MeshBuffer.NormalZ, Begin, Num, Batch.NZ);
+                }
+            },
+            [U, V](int32 Begin, int32 Num, const FUVProjectionBatch& Batch)
+            {
+                FMemory::Memcpy(U + Begin, Batch.U, Num * sizeof(float));
+                FMemory::Memcpy(V + Begin, Batch.V, Num * sizeof(float));
+            });
+    }
+
+    void GenerateMissingUVs(FProcMeshData& MeshData, const FProcMeshConvertOptions& Options)
+    {
+        if (MeshData.UV0.Num() == 0)
+        {
+            GenerateUVs(MeshData, Options, MeshData.UV0);
+        }
+    }
+
+    bool PrepareMeshData(FProcMeshData& MeshData, const FProcMeshConvertOptions& Options, FProcMeshRepairStats* OutRepairStats)
+    {
+        if (!IsValidMeshData(MeshData))
+        {
+            return false;
+        }
+
+        // 잘못된 기하를 먼저 걸러내어 이후 단계가 처리할 양을 줄인다
+        if (Options.bRepairMesh)
+        {
+            const FProcMeshRepairStats RepairStats = RepairMesh(MeshData, Options.RepairWeldThreshold);
+            if (OutRepairStats)
+            {
+                *OutRepairStats = RepairStats;
+            }
+            if (MeshData.Triangles.Num() == 0)
+            {
+                return false;
+            }
+        }
+
+        // 박스 투영이 최종 법선(크리즈 분할 후)을 쓰도록 법선을 먼저 처리
+        if (Options.bRecalculateNormal)
+        {
+            RecalculateNormals(MeshData, Options.NormalWeighting, GetCreaseAngle(Options));
+        }
+
+        GenerateMissingUVs(MeshData, Options);
+
+        if (Options.bGenerateTangents)
+        {
+            GenerateTangents(MeshData, MeshData.Tangents);
+        }
+        return true;
+    }
+
+    bool PrepareMeshView(const FProcMeshDataView& Source, const FProcMeshConvertOptions& Options, FProcMeshData& Scratch, FProcMeshDataView& OutView, FProcMeshRepairStats* OutRepairStats)
+    {
+        if (!IsValidMeshData(Source))
+        {
+            return false;
+        }
+
+        // 1. 정리와 크리즈 분할은 정점 배열이 바뀌므로 복사본에서 처리
+        const float CreaseAngle = GetCreaseAngle(Options);
+        if (Options.bRepairMesh || (Options.bRecalculateNormal && CreaseAngle >= 0.0f))
+        {
+            Scratch = Source.ToMeshData();
+            const bool bPrepared = PrepareMeshData(Scratch, Options, OutRepairStats);
+            OutView = Scratch;
+            return bPrepared;
+        }
+
+        // 2. 나머지는 새로 만든 버퍼만 교체
+        OutView = Source;
+        if (Options.bRecalculateNormal)
+        {
+            TArray<FVector3f> Normals;
+            ComputeSmoothNormals(Source.Vertices, Source.Vertices.Num(), Source.Triangles, Options.NormalWeighting, Normals);
+            CopyNormals(Normals, Scratch.Normals);
+            OutView.Normals = Scratch.Normals;
+        }
+
+        if (Source.UV0.Num() == 0)
+        {
+            GenerateUVs(OutView, Options, Scratch.UV0);
+            OutView.UV0 = Scratch.UV0;
+        }
+
+        // 3. 탄젠트는 최종 UV/법선 기준으로 생성
+        if (Options.bGenerateTangents)
+        {
+            GenerateTangents(OutView, Scratch.Tangents);
+            OutView.Tangents = Scratch.Tangents;
+        }
+        return true;
+    }
+
+    bool PrepareMeshView(const FProcMeshBufferView& Source, const FProcMeshConvertOptions& Options, FProcMeshBuffer& Scratch, FProcMeshBufferView& OutView, FProcMeshRepairStats* OutRepairStats)
+    {
+        if (!Source.IsValid())
+        {
+            return false;
+        }
+
+        // 1. 정리와 크리즈 분할은 정점 배열이 바뀌므로 복사본에서 처리
+        const float CreaseAngle = GetCreaseAngle(Options);
+        if (Options.bRepairMesh || (Options.bRecalculateNormal && CreaseAngle >= 0.0f))
+        {
+            Scratch.CopyFrom(Source);
+            if (Options.bRepairMesh)
+            {
+                const FProcMeshRepairStats RepairStats = RepairMesh(Scratch, Options.RepairWeldThreshold);
+                if (OutRepairStats)
+                {
+                    *OutRepairStats = RepairStats;
+                }
+                if (Scratch.Triangles.Num() == 0)
+                {
+                    return false;
+                }
+            }
+            if (Options.bRecalculateNormal)
+            {
+                RecalculateNormals(Scratch, Options.NormalWeighting, CreaseAngle);
+            }
+            if (Scratch.U.Num() == 0)
+            {
+                GenerateUVs(FProcMeshBufferView(Scratch), Options, Scratch);
+            }
+            if (Options.bGenerateTangents)
+            {
+                GenerateTangents(FProcMeshBufferView(Scratch), Scratch);
+            }
+            OutView = Scratch;
+            return true;
+        }
+
+        // 2. 나머지는 새로 만든 버퍼만 교체
+        OutView = Source;
+        if (Options.bRecalculateNormal)
+        {
+            TArray<FVector3f> Normals;
+            ComputeSmoothNormals(Source.GetPositions(), Source.NumVertices(), Source.Triangles, Options.NormalWeighting, Normals);
+            CopyNormals(Normals, Scratch);
+            OutView.NormalX = Scratch.NormalX;
+            OutView.NormalY = Scratch.NormalY;
+            OutView.NormalZ = Scratch.NormalZ;
+        }
+
+        if (!Source.HasUVs())
+        {
+            // 기본 XY 평면 투영 UV 는 위치 성분 배열과 같으므로 원본을 그대로 가리킨다
+            if (FUVProjector(Options).IsIdentity())
+            {
+                OutView.U = Source.PositionX;
+                OutView.V = Source.PositionY;
+            }
+            else
+            {
+                GenerateUVs(OutView, Options, Scratch);
+                OutView.U = Scratch.U;
+                OutView.V = Scratch.V;
+            }
+        }
+
+        // 3. 탄젠트는 최종 UV/법선 기준으로 생성
+        if (Options.bGenerateTangents)
+        {
+            GenerateTangents(OutView, Scratch);
+            OutView.TangentX = Scratch.TangentX;
+            OutView.TangentY = Scratch.TangentY;
+            OutView.TangentZ = Scratch.TangentZ;
+            OutView.BinormalSign = Scratch.BinormalSign;
+        }
+        return true;
+    }
+
+    void GenerateTangents(const FProcMeshDataView& MeshData, TArray<FProcMeshTangent>& OutTangents)
+    {
+        TArray<FVector3f> Tangents;
+        TArray<float> Signs;
+        ComputeTangentFrames(FMeshDataAccessor{ MeshData }, Tangents, Signs);
+
+        OutTangents.SetNumUninitialized(Tangents.Num());
+        FProcMeshTangent* Out = OutTangents.GetData();
+        ParallelForRange(Tangents.Num(), [&Tangents, &Signs, Out](int32 Begin, int32 End)
+            {
+                for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                {
+                    Out[Vertex] = FProcMeshTangent(FVector(Tangents[Vertex]), Signs[Vertex] < 0.0f);
+                }
+            });
+    }
+
+    void GenerateTangents(const FProcMeshBufferView& MeshBuffer, FProcMeshBuffer& OutBuffer)
+    {
+        TArray<FVector3f> Tangents;
+        TArray<float> Signs;
+        ComputeTangentFrames(FMeshBufferAccessor{ MeshBuffer }, Tangents, Signs);
+
+        const int32 NumVertices = Tangents.Num();
+        OutBuffer.TangentX.SetNumUninitialized(NumVertices);
+        OutBuffer.TangentY.SetNumUninitialized(NumVertices);
+        OutBuffer.TangentZ.SetNumUninitialized(NumVertices);
+        OutBuffer.BinormalSign = MoveTemp(Signs);
+        float* X = OutBuffer.TangentX.GetData();
+        float* Y = OutBuffer.TangentY.GetData();
+        float* Z = OutBuffer.TangentZ.GetData();
+        ParallelForRange(NumVertices, [&Tangents, X, Y, Z](int32 Begin, int32 End)
+            {
+                for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                {
+                    X[Vertex] = Tangents[Vertex].X;
+                    Y[Vertex] = Tangents[Vertex].Y;
+                    Z[Vertex] = Tangents[Vertex].Z;
+                }
+            });
+    }
+
+    void FVertexCornerAdjacency::Build(const int32 NumVertices, TConstArrayView<int32> Indices)
+    {
+        Offsets.SetNumZeroed(NumVertices + 1);
+        for (const int32 Index : Indices)
+        {
+            if (Index >= 0 && Index < NumVertices)
+            {
+                ++Offsets[Index + 1];
+            }
+        }
+        for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+        {
+            Offsets[Vertex + 1] += Offsets[Vertex];
+        }
+
+        // 코너를 인덱스 순서대로 채워 결과가 항상 결정적이도록 한다
+        Corners.SetNumUninitialized(Offsets[NumVertices]);
+        TArray<int32> Cursor(Offsets.GetData(), NumVertices);
+        for (int32 Corner = 0; Corner < Indices.Num(); ++Corner)
+        {
+            const int32 Index = Indices[Corner];
+            if (Index >= 0 && Index < NumVertices)
+            {
+                Corners[Cursor[Index]++] = Corner;
+            }
+        }
+    }
+
+    template<typename PositionArray>
+    void ComputeFaceNormals(const PositionArray& Positions, TConstArrayView<int32> Indices, EProcNormalWeighting Weighting, FFaceNormals& OutFaces)
+    {
+        const int32 NumTriangles = Indices.Num() / 3;
+        OutFaces.Normals.SetNumUninitialized(NumTriangles);
+        OutFaces.CornerWeights.SetNumUninitialized(NumTriangles * 3);
+
+        FVector3f* Normals = OutFaces.Normals.GetData();
+        float* Weights = OutFaces.CornerWeights.GetData();
+        ParallelForRange(NumTriangles, [Positions, Indices, Weighting, Normals, Weights](int32 Begin, int32 End)
+            {
+                for (int32 Tri = Begin; Tri < End; ++Tri)
+                {
+                    const int32 Index0 = Indices[Tri * 3];
+                    const int32 Index1 = Indices[Tri * 3 + 1];
+                    const int32 Index2 = Indices[Tri * 3 + 2];
+                    float* TriWeights = Weights + Tri * 3;
+
+                    if (!Positions.IsValidIndex(Index0) || !Positions.IsValidIndex(Index1) || !Positions.IsValidIndex(Index2))
+                    {
+                        Normals[Tri] = FVector3f::ZeroVector;
+                        TriWeights[0] = TriWeights[1] = TriWeights[2] = 0.0f;
+                        continue;
+                    }
+
+                    const FVector3f P0(Positions[Index0]);
+                    const FVector3f P1(Positions[Index1]);
+                    const FVector3f P2(Positions[Index2]);
+                    const FVector3f Cross = FVector3f::CrossProduct(P2 - P0, P1 - P0);
+                    const float DoubleArea = Cross.Size();
+
+                    // 면적이 0인 삼각형은 어느 정점에도 기여하지 않는다
+                    if (DoubleArea <= UE_SMALL_NUMBER)
+                    {
+                        Normals[Tri] = FVector3f::ZeroVector;
+                        TriWeights[0] = TriWeights[1] = TriWeights[2] = 0.0f;
+                        continue;
+                    }
+
+                    Normals[Tri] = Cross / DoubleArea;
+                    switch (Weighting)
+                    {
+                    case EProcNormalWeighting::Area:
+                        TriWeights[0] = TriWeights[1] = TriWeights[2] = DoubleArea;
+                        break;
+                    case EProcNormalWeighting::Angle:
+                        TriWeights[0] = CornerAngle(P0, P1, P2);
+                        TriWeights[1] = CornerAngle(P1, P2, P0);
+                        TriWeights[2] = CornerAngle(P2, P0, P1);
+                        break;
+                    default:
+                        TriWeights[0] = TriWeights[1] = TriWeights[2] = 1.0f;
+                        break;
+                    }
+                }
+            });
+    }
+
+    template void ComputeFaceNormals<TConstArrayView<FVector>>(const TConstArrayView<FVector>&, TConstArrayView<int32>, EProcNormalWeighting, FFaceNormals&);
+    template void ComputeFaceNormals<TConstArrayView<FVector3f>>(const TConstArrayView<FVector3f>&, TConstArrayView<int32>, EProcNormalWeighting, FFaceNormals&);
+    template void ComputeFaceNormals<FProcMeshBufferPositions>(const FProcMeshBufferPositions&, TConstArrayView<int32>, EProcNormalWeighting, FFaceNormals&);
+
+    void ComputeVertexNormals(const FFaceNormals& Faces, const FVertexCornerAdjacency& Adjacency, TArrayView<FVector3f> OutNormals)
+    {
+        ParallelForRange(OutNormals.Num(), [&Faces, &Adjacency, OutNormals](int32 Begin, int32 End)
+            {
+                for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                {
+                    FVector3f Sum = FVector3f::ZeroVector;
+                    for (const int32 Corner : Adjacency.GetCorners(Vertex))
+                    {
+                        Sum += Faces.Normals[Corner / 3] * Faces.CornerWeights[Corner];
+                    }
+                    OutNormals[Vertex] = Sum.GetSafeNormal();
+                }
+            });
+    }
+
+    void ComputeCornerNormals(const FFaceNormals& Faces, const FVertexCornerAdjacency& Adjacency, TConstArrayView<int32> Indices, float CreaseAngleDegrees,
+        TArrayView<FVector3f> OutCornerNormals, TArrayView<int32> OutCornerGroups)
+    {
+        const float CosCrease = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(CreaseAngleDegrees, 0.0f, 180.0f)));
+        const int32 NumVertices = Adjacency.Offsets.Num() - 1;
+        const bool bOutputGroups = OutCornerGroups.Num() > 0;
+
+        // 어떤 정점에도 속하지 않는 코너(잘못된 인덱스)는 0으로 남는다
+        FMemory::Memzero(OutCornerNormals.GetData(), OutCornerNormals.Num() * sizeof(FVector3f));
+
+        ParallelForRange(NumVertices, [&Faces, &Adjacency, Indices, CosCrease, OutCornerNormals, OutCornerGroups, bOutputGroups](int32 Begin, int32 End)
+            {
+                // 코너의 변 하나: 변의 반대쪽 정점과 정점 안에서의 코너 번호
+                struct FCornerEdge
+                {
+                    int32 OtherVertex;
+                    int32 Local;
+                };
+                TArray<FCornerEdge, TInlineAllocator<32>> Edges;
+                TArray<int32, TInlineAllocator<16>> Parents;
+                TArray<FVector3f, TInlineAllocator<16>> Sums;
+                TArray<int32, TInlineAllocator<16>> Groups;
+
+                auto Find = [&Parents](int32 Local)
+                {
+                    while (Parents[Local] != Local)
+                    {
+                        Parents[Local] = Parents[Parents[Local]];
+                        Local = Parents[Local];
+                    }
+                    return Local;
+                };
+
+                for (int32 Vertex = Begin; Vertex < End; ++Vertex)
+                {
+                    const TConstArrayView<int32> Corners = Adjacency.GetCorners(Vertex);
+                    const int32 NumCorners = Corners.Num();
+                    if (NumCorners == 0)
+                    {
+                        continue;
+                    }
+
+                    // 1. 코너마다 정점에 닿는 두 변을 모아 반대쪽 정점으로 정렬하면 같은 변을 공유하는 코너가 붙는다
+                    Edges.Reset();
+                    for (int32 Local = 0; Local < NumCorners; ++Local)
+                    {
+                        const int32 Corner = Corners[Local];
+                        const int32 Base = Corner - Corner % 3;
+                        Edges.Add({ Indices[Base + (Corner + 1) % 3], Local });
+                        Edges.Add({ Indices[Base + (Corner + 2) % 3], Local });
+                    }
+                    Edges.Sort([](const FCornerEdge& A, const FCornerEdge& B)
+                        {
+                            return A.OtherVertex != B.OtherVertex ? A.OtherVertex < B.OtherVertex : A.Local < B.Local;
+                        });
+
+                    // 2. 변을 공유하고 크리즈 각도 이내인 코너끼리 합쳐 팬을 만든다 (퇴화 삼각형은 이웃 팬에 붙임)
+                    Parents.SetNumUninitialized(NumCorners, false);
+                    for (int32 Local = 0; Local < NumCorners; ++Local)
+                    {
+                        Parents[Local] = Local;
+                    }
+                    for (int32 RunBegin = 0; RunBegin < Edges.Num();)
+                    {
+                        int32 RunEnd = RunBegin + 1;
+                        while (RunEnd < Edges.Num() && Edges[RunEnd].OtherVertex == Edges[RunBegin].OtherVertex)
+                        {
+                            ++RunEnd;
+                        }
+                        // 보통 두 개, 비다양체 변에서만 더 많다
+                        for (int32 A = RunBegin; A < RunEnd; ++A)
+                        {
+                            for (int32 B = A + 1; B < RunEnd; ++B)
+                            {
+                                const FVector3f& NormalA = Faces.Normals[Corners[Edges[A].Local] / 3];
+                                const FVector3f& NormalB = Faces.Normals[Corners[Edges[B].Local] / 3];
+                                if (NormalA.IsZero() || NormalB.IsZero() || FVector3f::DotProduct(NormalA, NormalB) >= CosCrease)
+                                {
+                                    const int32 RootA = Find(Edges[A].Local);
+                                    const int32 RootB = Find(Edges[B].Local);
+                                    Parents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+                                }
+                            }
+                        }
+                        RunBegin = RunEnd;
+                    }
+
+                    // 3. 팬별 가중 합을 코너에 나눠 준다 (팬 번호는 첫 코너가 나오는 순서)
+                    Sums.Reset();
+                    Sums.AddZeroed(NumCorners);
+                    for (int32 Local = 0; Local < NumCorners; ++Local)
+                    {
+                        const int32 Corner = Corners[Local];
+                        Sums[Find(Local)] += Faces.Normals[Corner / 3] * Faces.CornerWeights[Corner];
+                    }
+                    Groups.Init(INDEX_NONE, NumCorners);
+                    int32 NumGroups = 0;
+                    for (int32 Local = 0; Local < NumCorners; ++Local)
+                    {
+                        const int32 Root = Find(Local);
+                        OutCornerNormals[Corners[Local]] = Sums[Root].GetSafeNormal();
+                        if (bOutputGroups)
+                        {
+                            if (Groups[Root] == INDEX_NONE)
+                            {
+                                Groups[Root] = NumGroups++;
+                            }
+                            OutCornerGroups[Corners[Local]] = Groups[Root];
+                        }
+                    }
+                }
+            });
+    }
+
+    void RecalculateNormals(FProcMeshData& MeshData, EProcNormalWeighting Weighting, float CreaseAngleDegrees)
+    {
+        const int32 NumVertices = MeshData.Vertices.Num();
+        const TConstArrayView<FVector> Positions = MeshData.Vertices;
+
+        // 1. 크리즈 없음: 정점당 법선 하나
+        if (CreaseAngleDegrees < 0.0f)
+        {
+            TArray<FVector3f> Normals;
+            ComputeSmoothNormals(Positions, NumVertices, MeshData.Triangles, Weighting, Normals);
+            CopyNormals(Normals, MeshData.Normals);
+            return;
+        }
+
+        // 2. 크리즈 있음: 정점 분할 후 복제된 정점에 나머지 속성 복사
+        TArray<FVector3f> Normals;
+        TArray<int32> SourceVertices;
+        SplitCreaseVertices(Positions, NumVertices, MeshData.Triangles, Weighting, CreaseAngleDegrees, Normals, SourceVertices);
+        CopyNormals(Normals, MeshData.Normals);
+
+        AppendSplitAttribute(MeshData.Vertices, NumVertices, SourceVertices, FVector::ZeroVector);
+        AppendSplitAttribute(MeshData.UV0, NumVertices, SourceVertices, FVector2D::ZeroVector);
+        AppendSplitAttribute(MeshData.VertexColors, NumVertices, SourceVertices, FLinearColor::White);
+        AppendSplitAttribute(MeshData.Tangents, NumVertices, SourceVertices, FProcMeshTangent());
+    }
+
+    void RecalculateNormals(FProcMeshBuffer& Buffer, EProcNormalWeighting Weighting, float CreaseAngleDegrees)
+    {
+        const int32 NumVertices = Buffer.NumVertices();
+        const FProcMeshBufferPositions Positions = FProcMeshBufferView(Buffer).GetPositions();
+
+        // 1. 크리즈 없음: 정점당 법선 하나
+        if (CreaseAngleDegrees < 0.0f)
+        {
+            TArray<FVector3f> Normals;
+            ComputeSmoothNormals(Positions, NumVertices, Buffer.Triangles, Weighting, Normals);
+            CopyNormals(Normals, Buffer);
+            return;
+        }
+
+        // 2. 크리즈 있음: 정점 분할 후 복제된 정점에 나머지 성분 복사
+        TArray<FVector3f> Normals;
+        TArray<int32> SourceVertices;
+        SplitCreaseVertices(Positions, NumVertices, Buffer.Triangles, Weighting, CreaseAngleDegrees, Normals, SourceVertices);
+        CopyNormals(Normals, Buffer);
+
+        for (TArray<float>* Component : { &Buffer.PositionX, &Buffer.PositionY, &Buffer.PositionZ, &Buffer.U, &Buffer.V,
+            &Buffer.TangentX, &Buffer.TangentY, &Buffer.TangentZ })
+        {
+            AppendSplitAttribute(*Component, NumVertices, SourceVertices, 0.0f);
+        }
+        AppendSplitAttribute(Buffer.BinormalSign, NumVertices, SourceVertices, 1.0f);
+        AppendSplitAttribute(Buffer.Colors, NumVertices, SourceVertices, FLinearColor::White);
+    }
+
+    namespace
+    {
+        // 모든 원소 수를 미리 예약한 뒤 속성 버퍼를 연속 구간 단위로 병렬 기록한다
+        template<typename AccessorType>
+        void BuildMeshDescriptionFrom(const AccessorType& Mesh, FMeshDescription& MeshDesc, TConstArrayView<int32> SectionNumTriangles)
+        {
+            FProcMeshBuildPlan Plan;
+            MakeProcMeshBuildPlan(Mesh, SectionNumTriangles, Plan);
+
+            const int32 NumVertices = Plan.VertexSources.Num();
+            const int32 NumInstances = Plan.InstanceSources.Num();
+            const int32 NumTriangles = Plan.TriangleInstances.Num() / 3;
+
+            FStaticMeshAttributes Attributes(MeshDesc);
+            Attributes.Register();
+
+            // 1. 원소 수 예약
+            MeshDesc.ReserveNewVertices(NumVertices);
+            MeshDesc.ReserveNewVertexInstances(NumInstances);
+            MeshDesc.ReserveNewTriangles(NumTriangles);
+            MeshDesc.ReserveNewPolygons(NumTriangles);
+            MeshDesc.ReserveNewEdges(NumTriangles * 3 / 2 + 1);
+            MeshDesc.ReserveNewPolygonGroups(Plan.SectionNumTriangles.Num());
+
+            // 2. 정점/인스턴스 생성. 새 MeshDescription 의 ID는 0부터 연속으로 발급된다.
+            TArray<FVertexID> VertexIDs;
+            VertexIDs.SetNumUninitialized(NumVertices);
+            for (int32 i = 0; i < NumVertices; i++)
+            {
+                VertexIDs[i] = MeshDesc.CreateVertex();
+            }
+
+            TArray<FVertexInstanceID> InstanceIDs;
+            InstanceIDs.SetNumUninitialized(NumInstances);
+            for (int32 i = 0; i < NumInstances; i++)
+            {
+                InstanceIDs[i] = MeshDesc.CreateVertexInstance(VertexIDs[Plan.InstanceVertices[i]]);
+            }
+
+            // 3. 폴리곤 그룹 및 UV 채널 설정 (모든 그룹이 같은 머티리얼 슬롯을 쓴다)
+            const TPolygonGroupAttributesRef<FName> MaterialSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+            TArray<FPolygonGroupID> PolygonGroupIDs;
+            PolygonGroupIDs.SetNumUninitialized(Plan.SectionNumTriangles.Num());
+            for (int32 SectionIndex = 0; SectionIndex < PolygonGroupIDs.Num(); ++SectionIndex)
+            {
+                PolygonGroupIDs[SectionIndex] = MeshDesc.CreatePolygonGroup();
+                MaterialSlotNames[PolygonGroupIDs[SectionIndex]] = GetMaterialSlotName();
+            }
+            const int32 NumUvChannels = 1;
+            Attributes.GetVertexInstanceUVs().SetNumChannels(NumUvChannels);
+
+            // 4. 속성 버퍼를 한 번만 조회해서 원소 범위별로 병렬 기록
+            const TArrayView<FVector3f> Positions = Attributes.GetVertexPositions().GetRawArray();
+            const TArrayView<FVector3f> Normals = Attributes.GetVertexInstanceNormals().GetRawArray();
+            const TArrayView<FVector2f> UVs = Attributes.GetVertexInstanceUVs().GetRawArray(0);
+            const TArrayView<FVector4f> Colors = Attributes.GetVertexInstanceColors().GetRawArray();
+            const TArrayView<FVector3f> Tangents = Attributes.GetVertexInstanceTangents().GetRawArray();
+            const TArrayView<float> BinormalSigns = Attributes.GetVertexInstanceBinormalSigns().GetRawArray();
+
+            ParallelForRange(NumVertices, [&](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        Positions[VertexIDs[i].GetValue()] = Mesh.Position(Plan.VertexSources[i]);
+                    }
+                });
+
+            ParallelForRange(NumInstances, [&](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        const int32 Slot = InstanceIDs[i].GetValue();
+                        const int32 VertIndex = Plan.InstanceSources[i];
+
+                        // 법선 설정
+                        if (Mesh.HasNormal(VertIndex))
+                            Normals[Slot] = Mesh.Normal(VertIndex);
+
+                        // UV 설정 (채널 0)
+                        if (Mesh.HasUV(VertIndex))
+                            UVs[Slot] = Mesh.UV(VertIndex);
+
+                        // 버텍스 컬러 설정
+                        if (Mesh.HasColor(VertIndex))
+                            Colors[Slot] = FVector4f(Mesh.Color(VertIndex));
+
+                        // 탄젠트 설정
+                        if (Mesh.HasTangent(VertIndex))
+                        {
+                            Tangents[Slot] = Mesh.Tangent(VertIndex);
+                            BinormalSigns[Slot] = Mesh.BinormalSign(VertIndex);
+                        }
+                    }
+                });
+
+            // 5. 삼각형 생성 (엣지 해시 때문에 순차 처리, 임시 배열 할당 없음)
+            int32 Tri = 0;
+            for (int32 SectionIndex = 0; SectionIndex < PolygonGroupIDs.Num(); ++SectionIndex)
+            {
+                const int32 SectionEnd = Tri + Plan.SectionNumTriangles[SectionIndex];
+                for (; Tri < SectionEnd; ++Tri)
+                {
+                    const FVertexInstanceID VertexInstances[3] =
+                    {
+                        InstanceIDs[Plan.TriangleInstances[Tri * 3]],
+                        InstanceIDs[Plan.TriangleInstances[Tri * 3 + 1]],
+                        InstanceIDs[Plan.TriangleInstances[Tri * 3 + 2]]
+                    };
+                    MeshDesc.CreateTriangle(PolygonGroupIDs[SectionIndex], VertexInstances);
+                }
+            }
+        }
+
+        // 30비트 Morton 코드용: 하위 10비트를 3칸 간격으로 벌린다
+        uint32 SpreadBits3(uint32 Value)
+        {
+            Value &= 0x000003FF;
+            Value = (Value | (Value << 16)) & 0x030000FF;
+            Value = (Value | (Value << 8)) & 0x0300F00F;
+            Value = (Value | (Value << 4)) & 0x030C30C3;
+            Value = (Value | (Value << 2)) & 0x09249249;
+            return Value;
+        }
+
+        /**
+         * 구간 분할 순서를 계산한다. OutOrder 는 Morton 순서의 삼각형 번호이며, 나눌 필요가 없으면 비워 둔다 (원래 순서로 구간 하나).
+         * Indices 는 수정하지 않는다.
+         */
+        template<typename AccessorType>
+        void OrderSectionTriangles(const AccessorType& Mesh, TConstArrayView<int32> Indices, const int32 MaxSectionVertices, TArray<int32>& OutOrder, TArray<int32>& OutSectionNumTriangles)
+        {
+            const int32 NumVertices = Mesh.NumVertices();
+            const int32 NumTriangles = Indices.Num() / 3;
+            const int32 MaxVertices = FMath::Max(MaxSectionVertices, 3);
+            OutOrder.Reset();
+            OutSectionNumTriangles.Reset();
+            OutSectionNumTriangles.Add(NumTriangles);
+
+            auto IsValidTriangle = [&Indices, NumVertices](const int32 Triangle)
+            {
+                const int32* Corners = &Indices[Triangle * 3];
+                return Corners[0] >= 0 && Corners[0] < NumVertices
+                    && Corners[1] >= 0 && Corners[1] < NumVertices
+                    && Corners[2] >= 0 && Corners[2] < NumVertices;
+            };
+
+            // 1. 참조되는 정점이 상한 이하이면 나눌 필요가 없다
+            {
+                TBitArray<> Referenced(false, NumVertices);
+                int32 NumReferenced = 0;
+                for (const int32 Index : Indices)
+                {
+                    if (Index >= 0 && Index < NumVertices && !Referenced[Index])
+                    {
+                        Referenced[Index] = true;
+                        ++NumReferenced;
+                    }
+                }
+                if (NumReferenced <= MaxVertices)
+                {
+                    return;
+                }
+            }
+
+            // 2. 삼각형 중심을 병렬로 구하고, 전체 중심 바운드 안에서 10비트씩 양자화한 Morton 코드로 정렬
+            // 정렬 키 상위 32비트는 코드, 하위 32비트는 삼각형 번호라 같은 코드끼리는 원래 순서를 유지한다
+            TArray<FVector3f> Centroids;
+            Centroids.SetNumUninitialized(NumTriangles);
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Triangle = Begin; Triangle < End; ++Triangle)
+                    {
+                        if (IsValidTriangle(Triangle))
+                        {
+                            const int32* Corners = &Indices[Triangle * 3];
+                            Centroids[Triangle] = (Mesh.Position(Corners[0]) + Mesh.Position(Corners[1]) + Mesh.Position(Corners[2])) / 3.0f;
+                        }
+                    }
+                });
+
+            FBox3f Bounds(ForceInit);
+            for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+            {
+                if (IsValidTriangle(Triangle))
+                {
+                    Bounds += Centroids[Triangle];
+                }
+            }
+            const FVector3f Extent = Bounds.GetSize();
+            const FVector3f Scale(
+                Extent.X > 0.0f ? 1023.0f / Extent.X : 0.0f,
+                Extent.Y > 0.0f ? 1023.0f / Extent.Y : 0.0f,
+                Extent.Z > 0.0f ? 1023.0f / Extent.Z : 0.0f);
+
+            TArray<uint64> SortKeys;
+            SortKeys.SetNumUninitialized(NumTriangles);
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Triangle = Begin; Triangle < End; ++Triangle)
+                    {
+                        // 잘못된 삼각형은 어떤 30비트 코드보다 큰 코드로 맨 뒤에 둔다
+                        uint32 Code = MAX_uint32;
+                        if (IsValidTriangle(Triangle))
+                        {
+                            const FVector3f Cell = (Centroids[Triangle] - Bounds.Min) * Scale;
+                            Code = SpreadBits3(static_cast<uint32>(FMath::Clamp(Cell.X, 0.0f, 1023.0f)))
+                                | (SpreadBits3(static_cast<uint32>(FMath::Clamp(Cell.Y, 0.0f, 1023.0f))) << 1)
+                                | (SpreadBits3(static_cast<uint32>(FMath::Clamp(Cell.Z, 0.0f, 1023.0f))) << 2);
+                        }
+                        SortKeys[Triangle] = (static_cast<uint64>(Code) << 32) | static_cast<uint32>(Triangle);
+                    }
+                });
+            SortKeys.Sort();
+            Centroids.Empty();
+
+            // 3. Morton 순서로 삼각형을 채우다가 새 정점을 더하면 상한을 넘는 곳에서 구간을 끊는다
+            OutOrder.SetNumUninitialized(NumTriangles);
+            TArray<int32> VertexSection;
+            VertexSection.Init(INDEX_NONE, NumVertices);
+            OutSectionNumTriangles.Reset();
+            int32 Section = 0;
+            int32 SectionVertices = 0;
+            int32 SectionTriangles = 0;
+            for (int32 k = 0; k < NumTriangles; ++k)
+            {
+                const int32 Triangle = static_cast<int32>(SortKeys[k] & MAX_uint32);
+                const int32* Corners = &Indices[Triangle * 3];
+                if (IsValidTriangle(Triangle))
+                {
+                    auto CountNewVertices = [&VertexSection, &Section, Corners]()
+                    {
+                        return (VertexSection[Corners[0]] != Section ? 1 : 0)
+                            + (VertexSection[Corners[1]] != Section && Corners[1] != Corners[0] ? 1 : 0)
+                            + (VertexSection[Corners[2]] != Section && Corners[2] != Corners[0] && Corners[2] != Corners[1] ? 1 : 0);
+                    };
+
+                    int32 NumNew = CountNewVertices();
+                    if (SectionTriangles > 0 && SectionVertices + NumNew > MaxVertices)
+                    {
+                        OutSectionNumTriangles.Add(SectionTriangles);
+                        ++Section;
+                        SectionVertices = 0;
+                        SectionTriangles = 0;
+                        NumNew = CountNewVertices();
+                    }
+                    VertexSection[Corners[0]] = Section;
+                    VertexSection[Corners[1]] = Section;
+                    VertexSection[Corners[2]] = Section;
+                    SectionVertices += NumNew;
+                }
+                OutOrder[k] = Triangle;
+                ++SectionTriangles;
+            }
+            OutSectionNumTriangles.Add(SectionTriangles);
+        }
+
+        template<typename AccessorType>
+        void PartitionSectionsFrom(const AccessorType& Mesh, TArray<int32>& InOutIndices, const int32 MaxSectionVertices, TArray<int32>& OutSectionNumTriangles)
+        {
+            TArray<int32> Order;
+            OrderSectionTriangles(Mesh, InOutIndices, MaxSectionVertices, Order, OutSectionNumTriangles);
+            if (Order.Num() == 0)
+            {
+                return;
+            }
+
+            TArray<int32> Sorted;
+            Sorted.SetNumUninitialized(InOutIndices.Num());
+            for (int32 k = 0; k < Order.Num(); ++k)
+            {
+                FMemory::Memcpy(&Sorted[k * 3], &InOutIndices[Order[k] * 3], 3 * sizeof(int32));
+            }
+            InOutIndices = MoveTemp(Sorted);
+        }
+    }
+
+    void BuildMeshDescription(const FProcMeshDataView& MeshData, FMeshDescription& MeshDesc, TConstArrayView<int32> SectionNumTriangles)
+    {
+        BuildMeshDescriptionFrom(FMeshDataAccessor{ MeshData }, MeshDesc, SectionNumTriangles);
+    }
+
+    void BuildMeshDescription(const FProcMeshBufferView& MeshBuffer, FMeshDescription& MeshDesc, TConstArrayView<int32> SectionNumTriangles)
+    {
+        BuildMeshDescriptionFrom(FMeshBufferAccessor{ MeshBuffer }, MeshDesc, SectionNumTriangles);
+    }
+
+    void PartitionSections(const FProcMeshDataView& MeshData, TArray<int32>& InOutIndices, int32 MaxSectionVertices, TArray<int32>& OutSectionNumTriangles)
+    {
+        PartitionSectionsFrom(FMeshDataAccessor{ MeshData }, InOutIndices, MaxSectionVertices, OutSectionNumTriangles);
+    }
+
+    void PartitionSections(const FProcMeshBufferView& MeshBuffer, TArray<int32>& InOutIndices, int32 MaxSectionVertices, TArray<int32>& OutSectionNumTriangles)
+    {
+        PartitionSectionsFrom(FMeshBufferAccessor{ MeshBuffer }, InOutIndices, MaxSectionVertices, OutSectionNumTriangles);
+    }
+
+    void PartitionTriangles(const FProcMeshDataView& MeshData, int32 MaxSectionVertices, TArray<TArray<int32>>& OutSectionTriangles)
+    {
+        TArray<int32> Order;
+        TArray<int32> SectionNumTriangles;
+        OrderSectionTriangles(FMeshDataAccessor{ MeshData }, MeshData.Triangles, MaxSectionVertices, Order, SectionNumTriangles);
+
+        OutSectionTriangles.Reset(SectionNumTriangles.Num());
+        int32 Next = 0;
+        for (const int32 NumTriangles : SectionNumTriangles)
+        {
+            TArray<int32>& Triangles = OutSectionTriangles.AddDefaulted_GetRef();
+            Triangles.SetNumUninitialized(NumTriangles);
+            for (int32 k = 0; k < NumTriangles; ++k, ++Next)
+            {
+                Triangles[k] = Order.Num() > 0 ? Order[Next] : Next;
+            }
+        }
+    }
+
+    namespace
+    {
+        // 평면까지 거리 제곱의 가중 합을 나타내는 대칭 4x4 행렬 (상삼각 10개)
+        struct FQuadric
+        {
+            double XX = 0.0, XY = 0.0, XZ = 0.0, XW = 0.0;
+            double YY = 0.0, YZ = 0.0, YW = 0.0;
+            double ZZ = 0.0, ZW = 0.0;
+            double WW = 0.0;
+
+            // 단위 법선 Normal, 원점 거리 D 인 평면
+            static FQuadric FromPlane(const FVector3d& Normal, const double D, const double Weight)
+            {
+                FQuadric Q;
+                Q.XX = Weight * Normal.X * Normal.X; Q.XY = Weight * Normal.X * Normal.Y; Q.XZ = Weight * Normal.X * Normal.Z; Q.XW = Weight * Normal.X * D;
+                Q.YY = Weight * Normal.Y * Normal.Y; Q.YZ = Weight * Normal.Y * Normal.Z; Q.YW = Weight * Normal.Y * D;
+                Q.ZZ = Weight * Normal.Z * Normal.Z; Q.ZW = Weight * Normal.Z * D;
+                Q.WW = Weight * D * D;
+                return Q;
+            }
+
+            FQuadric& operator+=(const FQuadric& Other)
+            {
+                XX += Other.XX; XY += Other.XY; XZ += Other.XZ; XW += Other.XW;
+                YY += Other.YY; YZ += Other.YZ; YW += Other.YW;
+                ZZ += Other.ZZ; ZW += Other.ZW;
+                WW += Other.WW;
+                return *this;
+            }
+
+            double Evaluate(const FVector3d& P) const
+            {
+                return XX * P.X * P.X + YY * P.Y * P.Y + ZZ * P.Z * P.Z + WW
+                    + 2.0 * (XY * P.X * P.Y + XZ * P.X * P.Z + YZ * P.Y * P.Z + XW * P.X + YW * P.Y + ZW * P.Z);
+            }
+        };
+
+        /**
+         * QEM 기반 점진적 에지 붕괴 (Garland-Heckbert).
+         * 정점을 이웃 정점 위치로 옮기는 half-edge collapse 만 사용하므로 새 정점 속성을 만들지 않고,
+         * 결과 인덱스 버퍼는 원본 정점 배열을 그대로 가리킨다.
+         * 같은 위치의 정점은 하나로 보고(위치 정점), 속성이 다른 원본 정점(웨지)은 대응하는 웨지가 있을 때만 합친다.
+         */
+        class FQEMSimplifier
+        {
+        public:
+            template<typename AccessorType>
+            explicit FQEMSimplifier(const AccessorType& Mesh)
+            {
+                const int32 NumVertices = Mesh.NumVertices();
+                const TConstArrayView<int32> Triangles = Mesh.Triangles();
+
+                // 1. 위치 용접과 속성이 같은 정점(웨지) 통합
+                WedgePositions.SetNumUninitialized(NumVertices);
+                TArray<int32> CanonicalWedges;
+                CanonicalWedges.SetNumUninitialized(NumVertices);
+                {
+                    TMap<FVector3f, int32> PositionToSlot;
+                    TMap<FProcVertexInstanceKey, int32> WedgeTable;
+                    PositionToSlot.Reserve(NumVertices);
+                    WedgeTable.Reserve(NumVertices);
+                    for (int32 i = 0; i < NumVertices; ++i)
+                    {
+                        const FVector3f Position = Mesh.Position(i);
+                        const int32* Existing = PositionToSlot.Find(Position);
+                        WedgePositions[i] = Existing ? *Existing : PositionToSlot.Add(Position, Positions.Add(FVector3d(Position)));
+                        CanonicalWedges[i] = WedgeTable.FindOrAdd(FProcVertexInstanceKey(Mesh, i, WedgePositions[i]), i);
+                    }
+                }
+
+                // 2. 유효한 삼각형 수집
+                Corners.Reserve(Triangles.Num());
+                for (int32 i = 0; i + 2 < Triangles.Num(); i += 3)
+                {
+                    const int32 Index0 = Triangles[i];
+                    const int32 Index1 = Triangles[i + 1];
+                    const int32 Index2 = Triangles[i + 2];
+                    if (!WedgePositions.IsValidIndex(Index0) || !WedgePositions.IsValidIndex(Index1) || !WedgePositions.IsValidIndex(Index2))
+                    {
+                        continue;
+                    }
+                    if (WedgePositions[Index0] == WedgePositions[Index1] || WedgePositions[Index1] == WedgePositions[Index2] || WedgePositions[Index0] == WedgePositions[Index2])
+                    {
+                        continue;
+                    }
+                    Corners.Add(CanonicalWedges[Index0]);
+                    Corners.Add(CanonicalWedges[Index1]);
+                    Corners.Add(CanonicalWedges[Index2]);
+                }
+                NumAliveTriangles = Corners.Num() / 3;
+                TriangleAlive.Init(true, NumAliveTriangles);
+
+                const int32 NumPositions = Positions.Num();
+                VertexTriangles.SetNum(NumPositions);
+                Quadrics.SetNum(NumPositions);
+                Versions.Init(0, NumPositions);
+                Removed.Init(false, NumPositions);
+
+                // 3. 면 평면 오차 (면적 가중) 와 에지 사용 정보 수집
+                struct FEdgeInfo
+                {
+                    int32 Count = 0;
+                    int32 Triangle = INDEX_NONE;
+                    int32 WedgeA = INDEX_NONE;
+                    int32 WedgeB = INDEX_NONE;
+                    bool bSeam = false;
+                };
+                TMap<uint64, FEdgeInfo> Edges;
+                Edges.Reserve(Corners.Num());
+
+                for (int32 Tri = 0; Tri < NumAliveTriangles; ++Tri)
+                {
+                    const FVector3d FaceNormal = GetTriangleNormal(Tri);
+                    const double DoubleArea = FaceNormal.Size();
+                    const FVector3d UnitNormal = DoubleArea > UE_DOUBLE_SMALL_NUMBER ? FaceNormal / DoubleArea : FVector3d::ZeroVector;
+                    const FQuadric FaceQuadric = FQuadric::FromPlane(UnitNormal, -FVector3d::DotProduct(UnitNormal, Positions[GetCornerPosition(Tri, 0)]), 0.5 * DoubleArea);
+
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const int32 Vertex = GetCornerPosition(Tri, Corner);
+                        VertexTriangles[Vertex].Add(Tri);
+                        Quadrics[Vertex] += FaceQuadric;
+
+                        // 위치 정점 번호가 작은 쪽을 A 로 정렬한 에지
+                        int32 WedgeA = Corners[Tri * 3 + Corner];
+                        int32 WedgeB = Corners[Tri * 3 + (Corner + 1) % 3];
+                        if (WedgePositions[WedgeA] > WedgePositions[WedgeB])
+                        {
+                            Swap(WedgeA, WedgeB);
+                        }
+                        FEdgeInfo& Edge = Edges.FindOrAdd(MakeEdgeKey(WedgePositions[WedgeA], WedgePositions[WedgeB]));
+                        if (Edge.Count++ == 0)
+                        {
+                            Edge.Triangle = Tri;
+                            Edge.WedgeA = WedgeA;
+                            Edge.WedgeB = WedgeB;
+                        }
+                        else if (Edge.WedgeA != WedgeA || Edge.WedgeB != WedgeB)
+                        {
+                            Edge.bSeam = true;
+                        }
+                    }
+                }
+
+                // 4. 열린 경계와 속성 이음매는 에지에 수직인 평면 오차를 더해 모양을 유지하고, 모든 에지를 후보로 넣는다
+                for (const TPair<uint64, FEdgeInfo>& Pair : Edges)
+                {
+                    const int32 VertexA = static_cast<int32>(Pair.Key >> 32);
+                    const int32 VertexB = static_cast<int32>(Pair.Key & 0xffffffff);
+                    const FEdgeInfo& Edge = Pair.Value;
+                    if (Edge.Count == 1 || Edge.bSeam)
+                    {
+                        const FVector3d EdgeVector = Positions[VertexB] - Positions[VertexA];
+                        const FVector3d PlaneNormal = FVector3d::CrossProduct(EdgeVector, GetTriangleNormal(Edge.Triangle)).GetSafeNormal();
+                        const double Weight = (Edge.Count == 1 ? BorderWeight : SeamWeight) * EdgeVector.SizeSquared();
+                        const FQuadric EdgeQuadric = FQuadric::FromPlane(PlaneNormal, -FVector3d::DotProduct(PlaneNormal, Positions[VertexA]), Weight);
+                        Quadrics[VertexA] += EdgeQuadric;
+                        Quadrics[VertexB] += EdgeQuadric;
+                    }
+                }
+                for (const TPair<uint64, FEdgeInfo>& Pair : Edges)
+                {
+                    const int32 VertexA = static_cast<int32>(Pair.Key >> 32);
+                    const int32 VertexB = static_cast<int32>(Pair.Key & 0xffffffff);
+                    PushCandidate(VertexA, VertexB);
+                    PushCandidate(VertexB, VertexA);
+                }
+            }
+
+            int32 GetNumTriangles() const { return NumAliveTriangles; }
+
+            // 살아 있는 삼각형이 TargetTriangles 이하가 되거나 더 붕괴할 수 있는 에지가 없을 때까지 진행
+            void SimplifyTo(const int32 TargetTriangles)
+            {
+                FCollapseCandidate Candidate;
+                while (NumAliveTriangles > TargetTriangles && Heap.Num() > 0)
+                {
+                    Heap.HeapPop(Candidate, FCollapseCandidate::FLess(), false);
+                    if (Removed[Candidate.From] || Removed[Candidate.To]
+                        || Versions[Candidate.From] != Candidate.FromVersion || Versions[Candidate.To] != Candidate.ToVersion)
+                    {
+                        continue;
+                    }
+                    TryCollapse(Candidate.From, Candidate.To);
+                }
+            }
+
+            void GetIndices(TArray<int32>& OutIndices) const
+            {
+                OutIndices.Reset(NumAliveTriangles * 3);
+                for (int32 Tri = 0; Tri < TriangleAlive.Num(); ++Tri)
+                {
+                    if (TriangleAlive[Tri])
+                    {
+                        OutIndices.Append(&Corners[Tri * 3], 3);
+                    }
+                }
+            }
+
+        private:
+            // 에지 길이 제곱에 곱하는 경계/이음매 오차 가중치
+            static constexpr double BorderWeight = 10.0;
+            static constexpr double SeamWeight = 1.0;
+            // 붕괴 후 삼각형 법선이 이보다 많이 돌아가면 (cos) 뒤집힘으로 보고 거부
+            static constexpr double MinNormalDot = 0.25;
+
+            struct FCollapseCandidate
+            {
+                double Cost = 0.0;
+                int32 From = INDEX_NONE;
+                int32 To = INDEX_NONE;
+                uint32 FromVersion = 0;
+                uint32 ToVersion = 0;
+
+                struct FLess
+                {
+                    bool operator()(const FCollapseCandidate& A, const FCollapseCandidate& B) const { return A.Cost < B.Cost; }
+                };
+            };
+
+            using FVertexList = TArray<int32, TInlineAllocator<16>>;
+
+            static uint64 MakeEdgeKey(const int32 VertexA, const int32 VertexB)
+            {
+                return (static_cast<uint64>(VertexA) << 32) | static_cast<uint32>(VertexB);
+            }
+
+            int32 GetCornerPosition(const int32 Tri, const int32 Corner) const
+            {
+                return WedgePositions[Corners[Tri * 3 + Corner]];
+            }
+
+            FVector3d GetTriangleNormal(const int32 Tri) const
+            {
+                const FVector3d& P0 = Positions[GetCornerPosition(Tri, 0)];
+                return FVector3d::CrossProduct(Positions[GetCornerPosition(Tri, 1)] - P0, Positions[GetCornerPosition(Tri, 2)] - P0);
+            }
+
+            // Vertex 를 To 위치로 옮기는 비용
+            void PushCandidate(const int32 From, const int32 To)
+            {
+                FQuadric Combined = Quadrics[From];
+                Combined += Quadrics[To];
+                Heap.HeapPush(FCollapseCandidate{ Combined.Evaluate(Positions[To]), From, To, Versions[From], Versions[To] }, FCollapseCandidate::FLess());
+            }
+
+            // 죽은 삼각형을 목록에서 제거
+            TArray<int32>& GetAliveTriangles(const int32 Vertex)
+            {
+                VertexTriangles[Vertex].RemoveAllSwap([this](const int32 Tri) { return !TriangleAlive[Tri]; }, false);
+                return VertexTriangles[Vertex];
+            }
+
+            // 이웃 위치 정점과, 각 이웃과 공유하는 삼각형 수 (1 이면 경계 에지)
+            void GatherNeighbors(const int32 Vertex, FVertexList& OutNeighbors, FVertexList& OutCounts)
+            {
+                OutNeighbors.Reset();
+                OutCounts.Reset();
+                for (const int32 Tri : GetAliveTriangles(Vertex))
+                {
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const int32 Neighbor = GetCornerPosition(Tri, Corner);
+                        if (Neighbor == Vertex)
+                        {
+                            continue;
+                        }
+                        const int32 Index = OutNeighbors.Find(Neighbor);
+                        if (Index == INDEX_NONE)
+                        {
+                            OutNeighbors.Add(Neighbor);
+                            OutCounts.Add(1);
+                        }
+                        else
+                        {
+                            ++OutCounts[Index];
+                        }
+                    }
+                }
+            }
+
+            bool TryCollapse(const int32 From, const int32 To)
+            {
+                // 1. 위상 검사. 경계 정점은 경계를 따라서만 움직이고, 공통 이웃 수가 공유 삼각형 수와 같아야 비다양체가 생기지 않는다 (링크 조건).
+                FVertexList FromNeighbors, FromCounts, ToNeighbors, ToCounts;
+                GatherNeighbors(From, FromNeighbors, FromCounts);
+                const int32 EdgeIndex = FromNeighbors.Find(To);
+                if (EdgeIndex == INDEX_NONE)
+                {
+                    return false;
+                }
+                const bool bBorderEdge = FromCounts[EdgeIndex] == 1;
+                if (!bBorderEdge && FromCounts.Contains(1))
+                {
+                    return false;
+                }
+
+                GatherNeighbors(To, ToNeighbors, ToCounts);
+                int32 NumCommon = 0;
+                for (const int32 Neighbor : FromNeighbors)
+                {
+                    NumCommon += (Neighbor != To && ToNeighbors.Contains(Neighbor)) ? 1 : 0;
+                }
+                if (NumCommon != (bBorderEdge ? 1 : 2))
+                {
+                    return false;
+                }
+
+                // 2. 속성 검사. From 의 웨지마다 에지 AB 를 공유하는 삼각형에서 대응하는 To 의 웨지를 찾는다.
+                // 이음매를 가로지르는 붕괴처럼 대응 웨지가 없거나 둘 이상이면 거부한다.
+                TArray<TPair<int32, int32>, TInlineAllocator<8>> WedgeMap;
+                const TArray<int32>& FromTriangles = VertexTriangles[From];
+                for (const int32 Tri : FromTriangles)
+                {
+                    int32 FromWedge = INDEX_NONE;
+                    int32 ToWedge = INDEX_NONE;
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const int32 Wedge = Corners[Tri * 3 + Corner];
+                        FromWedge = WedgePositions[Wedge] == From ? Wedge : FromWedge;
+                        ToWedge = WedgePositions[Wedge] == To ? Wedge : ToWedge;
+                    }
+                    if (ToWedge == INDEX_NONE)
+                    {
+                        continue;
+                    }
+                    const TPair<int32, int32>* Mapped = WedgeMap.FindByPredicate([FromWedge](const TPair<int32, int32>& Pair) { return Pair.Key == FromWedge; });
+                    if (!Mapped)
+                    {
+                        WedgeMap.Emplace(FromWedge, ToWedge);
+                    }
+                    else if (Mapped->Value != ToWedge)
+                    {
+                        return false;
+                    }
+                }
+
+                // 3. 기하 검사. 남는 삼각형이 뒤집히거나 한 점/선으로 붕괴하면 거부
+                const FVector3d& Target = Positions[To];
+                for (const int32 Tri : FromTriangles)
+                {
+                    int32 FromCorner = INDEX_NONE;
+                    bool bShared = false;
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const int32 Vertex = GetCornerPosition(Tri, Corner);
+                        FromCorner = Vertex == From ? Corner : FromCorner;
+                        bShared |= Vertex == To;
+                    }
+                    if (bShared)
+                    {
+                        continue;
+                    }
+
+                    const int32 FromWedge = Corners[Tri * 3 + FromCorner];
+                    if (!WedgeMap.ContainsByPredicate([FromWedge](const TPair<int32, int32>& Pair) { return Pair.Key == FromWedge; }))
+                    {
+                        return false;
+                    }
+
+                    const FVector3d OldNormal = GetTriangleNormal(Tri);
+                    const FVector3d& P1 = Positions[GetCornerPosition(Tri, (FromCorner + 1) % 3)];
+                    const FVector3d& P2 = Positions[GetCornerPosition(Tri, (FromCorner + 2) % 3)];
+                    const FVector3d NewNormal = FVector3d::CrossProduct(P1 - Target, P2 - Target);
+                    const double OldLength = OldNormal.Size();
+                    const double NewLength = NewNormal.Size();
+                    if (NewLength <= UE_DOUBLE_SMALL_NUMBER * FMath::Max(OldLength, 1.0))
+                    {
+                        return false;
+                    }
+                    if (OldLength > UE_DOUBLE_SMALL_NUMBER && FVector3d::DotProduct(OldNormal, NewNormal) < MinNormalDot * OldLength * NewLength)
+                    {
+                        return false;
+                    }
+                }
+
+                // 4. 적용. 에지를 공유하는 삼각형은 사라지고, 나머지는 From 의 웨지를 대응하는 To 의 웨지로 바꾼다.
+                TArray<int32>& ToTriangles = VertexTriangles[To];
+                for (const int32 Tri : FromTriangles)
+                {
+                    bool bShared = false;
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        bShared |= GetCornerPosition(Tri, Corner) == To;
+                    }
+                    if (bShared)
+                    {
+                        TriangleAlive[Tri] = false;
+                        --NumAliveTriangles;
+                        continue;
+                    }
+
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        int32& Wedge = Corners[Tri * 3 + Corner];
+                        if (WedgePositions[Wedge] == From)
+                        {
+                            Wedge = WedgeMap.FindByPredicate([Wedge](const TPair<int32, int32>& Pair) { return Pair.Key == Wedge; })->Value;
+                        }
+                    }
+                    ToTriangles.Add(Tri);
+                }
+                VertexTriangles[From].Empty();
+                Removed[From] = true;
+                Quadrics[To] += Quadrics[From];
+                ++Versions[To];
+
+                // 5. To 에 연결된 에지의 비용을 다시 계산
+                GatherNeighbors(To, ToNeighbors, ToCounts);
+                for (const int32 Neighbor : ToNeighbors)
+                {
+                    PushCandidate(To, Neighbor);
+                    PushCandidate(Neighbor, To);
+                }
+                return true;
+            }
+
+            TArray<FVector3d> Positions;        // 위치 정점
+            TArray<int32> WedgePositions;       // 원본 정점 -> 위치 정점
+            TArray<int32> Corners;              // 삼각형 코너의 원본 정점 (3개씩)
+            TBitArray<> TriangleAlive;
+            int32 NumAliveTriangles = 0;
+
+            TArray<TArray<int32>> VertexTriangles;
+            TArray<FQuadric> Quadrics;
+            TArray<uint32> Versions;
+            TBitArray<> Removed;
+            TArray<FCollapseCandidate> Heap;
+        };
+
+        template<typename AccessorType>
+        void SimplifyMeshFrom(const AccessorType& Mesh, TConstArrayView<float> TriangleRatios, TArray<TArray<int32>>& OutLODIndices)
+        {
+            FQEMSimplifier Simplifier(Mesh);
+            const int32 NumSourceTriangles = Simplifier.GetNumTriangles();
+
+            OutLODIndices.SetNum(TriangleRatios.Num());
+            for (int32 LODIndex = 0; LODIndex < TriangleRatios.Num(); ++LODIndex)
+            {
+                Simplifier.SimplifyTo(FMath::CeilToInt32(NumSourceTriangles * TriangleRatios[LODIndex]));
+                Simplifier.GetIndices(OutLODIndices[LODIndex]);
+            }
+        }
+
+        template<typename ViewType>
+        void BuildLODMeshDescriptionsFrom(const ViewType& MeshView, const FProcMeshConvertOptions& Options, TArray<FMeshDescription>& OutMeshDescs, FProcMeshVertexCacheStats* OutCacheStats)
+        {
+            TArray<float> TriangleRatios;
+            TArray<float> ScreenSizes;
+            GetLODSettings(Options, TriangleRatios, ScreenSizes);
+
+            // 1. 워커에서 LOD 인덱스 버퍼를 점진적으로 생성 (LOD0 은 원본 그대로)
+            TArray<TArray<int32>> LODIndices;
+            if (TriangleRatios.Num() > 1)
+            {
+                SimplifyMesh(MeshView, MakeArrayView(TriangleRatios).RightChop(1), LODIndices);
+            }
+
+            // 2. LOD 별 MeshDescription 은 서로 독립이므로 병렬로 만든다
+            OutMeshDescs.Reset(TriangleRatios.Num());
+            OutMeshDescs.SetNum(TriangleRatios.Num());
+            // (섹션 분할과 재정렬도 LOD 마다 독립이므로 같은 작업 안에서 한다)
+            ParallelFor(OutMeshDescs.Num(), [&MeshView, &Options, &LODIndices, &OutMeshDescs, OutCacheStats](int32 LODIndex)
+                {
+                    ViewType LODView = MeshView;
+                    TArray<int32> LODTriangles;
+                    TArray<int32> SectionNumTriangles;
+                    if (Options.bSplitSections || Options.bOptimizeVertexCache)
+                    {
+                        LODTriangles = LODIndex > 0 ? MoveTemp(LODIndices[LODIndex - 1]) : TArray<int32>(MeshView.Triangles.GetData(), MeshView.Triangles.Num());
+                        if (Options.bSplitSections)
+                        {
+                            PartitionSections(MeshView, LODTriangles, Options.MaxSectionVertices, SectionNumTriangles);
+                        }
+                        if (Options.bOptimizeVertexCache)
+                        {
+                            const FProcMeshVertexCacheStats Stats = OptimizeIndexOrder(MeshView, LODTriangles, SectionNumTriangles);
+                            if (LODIndex == 0 && OutCacheStats)
+                            {
+                                *OutCacheStats = Stats;
+                            }
+                        }
+                        LODView.Triangles = LODTriangles;
+                    }
+                    else if (LODIndex > 0)
+                    {
+                        LODView.Triangles = LODIndices[LODIndex - 1];
+                    }
+                    BuildMeshDescription(LODView, OutMeshDescs[LODIndex], SectionNumTriangles);
+                });
+        }
+    }
+
+    void SimplifyMesh(const FProcMeshDataView& MeshData, TConstArrayView<float> TriangleRatios, TArray<TArray<int32>>& OutLODIndices)
+    {
+        SimplifyMeshFrom(FMeshDataAccessor{ MeshData }, TriangleRatios, OutLODIndices);
+    }
+
+    void SimplifyMesh(const FProcMeshBufferView& MeshBuffer, TConstArrayView<float> TriangleRatios, TArray<TArray<int32>>& OutLODIndices)
+    {
+        SimplifyMeshFrom(FMeshBufferAccessor{ MeshBuffer }, TriangleRatios, OutLODIndices);
+    }
+
+    void GetLODSettings(const FProcMeshConvertOptions& Options, TArray<float>& OutTriangleRatios, TArray<float>& OutScreenSizes)
+    {
+        const int32 NumLODs = FMath::Clamp(Options.NumLODs, 1, MAX_STATIC_MESH_LODS);
+        OutTriangleRatios.Reset(NumLODs);
+        OutScreenSizes.Reset(NumLODs);
+        OutTriangleRatios.Add(1.0f);
+        OutScreenSizes.Add(1.0f);
+
+        // 화면 크기와 삼각형 비율은 화면 면적당 삼각형 수가 일정하도록 제곱 관계로 서로 채운다
+        for (int32 LODIndex = 1; LODIndex < NumLODs; ++LODIndex)
+        {
+            const int32 OptionIndex = LODIndex - 1;
+            float Ratio = OutTriangleRatios.Last() * 0.5f;
+            if (Options.LODTriangleRatios.IsValidIndex(OptionIndex))
+            {
+                Ratio = Options.LODTriangleRatios[OptionIndex];
+            }
+            else if (Options.LODScreenSizes.IsValidIndex(OptionIndex))
+            {
+                Ratio = FMath::Square(Options.LODScreenSizes[OptionIndex]);
+            }
+            Ratio = FMath::Clamp(Ratio, 0.0f, OutTriangleRatios.Last());
+
+            float ScreenSize = Options.LODScreenSizes.IsValidIndex(OptionIndex) ? Options.LODScreenSizes[OptionIndex] : FMath::Sqrt(Ratio);
+            ScreenSize = FMath::Clamp(ScreenSize, 0.0f, OutScreenSizes.Last());
+
+            OutTriangleRatios.Add(Ratio);
+            OutScreenSizes.Add(ScreenSize);
+        }
+    }
+
+    void BuildLODMeshDescriptions(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options, TArray<FMeshDescription>& OutMeshDescs, FProcMeshVertexCacheStats* OutCacheStats)
+    {
+        BuildLODMeshDescriptionsFrom(MeshData, Options, OutMeshDescs, OutCacheStats);
+    }
+
+    void BuildLODMeshDescriptions(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options, TArray<FMeshDescription>& OutMeshDescs, FProcMeshVertexCacheStats* OutCacheStats)
+    {
+        BuildLODMeshDescriptionsFrom(MeshBuffer, Options, OutMeshDescs, OutCacheStats);
+    }
+
+    namespace
+    {
+        // 정리 결과 새 정점 배열의 구성과 새 인덱스 버퍼
+        struct FRepairPlan
+        {
+            TArray<int32> AttributeSources;   // 새 정점 -> 속성을 가져올 원본 정점
+            TArray<int32> PositionSources;    // 새 정점 -> 위치를 가져올 원본 정점 (용접 대표)
+            TArray<int32> Triangles;          // 새 정점 번호로 고친 인덱스 버퍼
+        };
+
+        // 가장 긴 변 대비 높이가 이보다 작으면 면적 0 으로 본다 (float 정밀도 수준)
+        constexpr double MinTriangleHeightRatio = 1.0e-6;
+
+        double ElapsedMs(const double StartTime)
+        {
+            return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        }
+
+        /**
+         * 용접 -> 삼각형 정리 -> 정점 압축 순서로 정리 계획을 세운다. 원본은 읽기만 한다.
+         * 용접은 WeldThreshold 안의 위치를 대표 정점 위치로 맞추고, 위치와 모든 속성이 같아진 정점만 하나로 합친다.
+         * (속성이 다른 정점은 위치만 맞추므로 UV/법선 이음매는 유지된다)
+         */
+        template<typename AccessorType>
+        void MakeRepairPlan(const AccessorType& Mesh, const float WeldThreshold, FRepairPlan& Plan, FProcMeshRepairStats& Stats)
+        {
+            const int32 NumVertices = Mesh.NumVertices();
+            const TConstArrayView<int32> Indices = Mesh.Triangles();
+            const int32 NumTriangles = Indices.Num() / 3;
+
+            // 1. NaN/Inf 정점 표시 (정점 병렬)
+            double PhaseStart = FPlatformTime::Seconds();
+            TArray<FVector3f> Positions;
+            Positions.SetNumUninitialized(NumVertices);
+            TArray<uint8> Finite;
+            Finite.SetNumUninitialized(NumVertices);
+            ParallelForRange(NumVertices, [&Mesh, &Positions, &Finite](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        Positions[i] = Mesh.Position(i);
+                        Finite[i] = !Positions[i].ContainsNaN(); // Inf 도 포함
+                    }
+                });
+
+            // 2. 위치 용접. 격자 셀 크기를 WeldThreshold 로 두고 이웃 27개 셀의 대표 정점만 비교하므로 선형 시간에 끝난다.
+            TArray<int32> Clusters;
+            Clusters.Init(INDEX_NONE, NumVertices);
+            if (WeldThreshold > 0.0f)
+            {
+                const float ThresholdSquared = FMath::Square(WeldThreshold);
+                const double InvCellSize = 1.0 / WeldThreshold;
+                TMap<FInt64Vector, int32> CellHeads;
+                TArray<int32> NextInCell;
+                NextInCell.Init(INDEX_NONE, NumVertices);
+                CellHeads.Reserve(NumVertices);
+
+                for (int32 i = 0; i < NumVertices; ++i)
+                {
+                    if (!Finite[i])
+                    {
+                        continue;
+                    }
+
+                    const FInt64Vector Cell(
+                        FMath::FloorToInt64(Positions[i].X * InvCellSize),
+                        FMath::FloorToInt64(Positions[i].Y * InvCellSize),
+                        FMath::FloorToInt64(Positions[i].Z * InvCellSize));
+                    for (int64 Z = Cell.Z - 1; Z <= Cell.Z + 1 && Clusters[i] == INDEX_NONE; ++Z)
+                    {
+                        for (int64 Y = Cell.Y - 1; Y <= Cell.Y + 1 && Clusters[i] == INDEX_NONE; ++Y)
+                        {
+                            for (int64 X = Cell.X - 1; X <= Cell.X + 1 && Clusters[i] == INDEX_NONE; ++X)
+                            {
+                                const int32* Head = CellHeads.Find(FInt64Vector(X, Y, Z));
+                                for (int32 Rep = Head ? *Head : INDEX_NONE; Rep != INDEX_NONE; Rep = NextInCell[Rep])
+                                {
+                                    if (FVector3f::DistSquared(Positions[Rep], Positions[i]) <= ThresholdSquared)
+                                    {
+                                        Clusters[i] = Rep;
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    if (Clusters[i] == INDEX_NONE)
+                    {
+                        Clusters[i] = i;
+                        int32& Head = CellHeads.FindOrAdd(Cell, INDEX_NONE);
+                        NextInCell[i] = Head;
+                        Head = i;
+                    }
+                }
+            }
+            else
+            {
+                TMap<FVector3f, int32> PositionToCluster;
+                PositionToCluster.Reserve(NumVertices);
+                for (int32 i = 0; i < NumVertices; ++i)
+                {
+                    if (Finite[i])
+                    {
+                        Clusters[i] = PositionToCluster.FindOrAdd(Positions[i], i);
+                    }
+                }
+            }
+
+            // 위치가 같아진 정점 중 속성까지 같은 정점은 하나로 합친다
+            TArray<int32> Merged;
+            Merged.Init(INDEX_NONE, NumVertices);
+            {
+                TMap<FProcVertexInstanceKey, int32> WedgeTable;
+                WedgeTable.Reserve(NumVertices);
+                for (int32 i = 0; i < NumVertices; ++i)
+                {
+                    if (Clusters[i] == INDEX_NONE)
+                    {
+                        ++Stats.NumNonFiniteVertices;
+                        continue;
+                    }
+                    Merged[i] = WedgeTable.FindOrAdd(FProcVertexInstanceKey(Mesh, i, Clusters[i]), i);
+                    Stats.NumWeldedVertices += Merged[i] != i ? 1 : 0;
+                }
+            }
+            Stats.WeldMs = ElapsedMs(PhaseStart);
+
+            // 3. 삼각형 정리 (삼각형 병렬). 블록별로 남길 삼각형을 세고, 접두사 합으로 자리를 정한 뒤 다시 병렬로 기록한다.
+            PhaseStart = FPlatformTime::Seconds();
+            const int32 NumBlocks = FMath::DivideAndRoundUp(NumTriangles, ParallelBlockSize);
+            TArray<uint8> Keep;
+            Keep.SetNumUninitialized(NumTriangles);
+            TArray<int32> BlockKept, BlockInvalid, BlockDegenerate;
+            BlockKept.SetNumZeroed(NumBlocks);
+            BlockInvalid.SetNumZeroed(NumBlocks);
+            BlockDegenerate.SetNumZeroed(NumBlocks);
+
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    const int32 Block = Begin / ParallelBlockSize;
+                    for (int32 Tri = Begin; Tri < End; ++Tri)
+                    {
+                        Keep[Tri] = 0;
+
+                        // 범위를 벗어난 인덱스나 NaN/Inf 정점을 쓰는 삼각형
+                        int32 Corners[3];
+                        bool bValid = true;
+                        for (int32 Corner = 0; Corner < 3; ++Corner)
+                        {
+                            const int32 Index = Indices[Tri * 3 + Corner];
+                            bValid &= Index >= 0 && Index < NumVertices && Merged[Index] != INDEX_NONE;
+                            Corners[Corner] = bValid ? Merged[Index] : INDEX_NONE;
+                        }
+                        if (!bValid)
+                        {
+                            ++BlockInvalid[Block];
+                            continue;
+                        }
+
+                        // 용접 후 한 점/선으로 붕괴했거나 면적이 0 인 삼각형 (가장 긴 변 대비 높이로 판정)
+                        const FVector3d P0(Positions[Clusters[Corners[0]]]);
+                        const FVector3d P1(Positions[Clusters[Corners[1]]]);
+                        const FVector3d P2(Positions[Clusters[Corners[2]]]);
+                        const double LongestSquared = FMath::Max3((P1 - P0).SizeSquared(), (P2 - P1).SizeSquared(), (P0 - P2).SizeSquared());
+                        const double CrossSquared = FVector3d::CrossProduct(P1 - P0, P2 - P0).SizeSquared();
+                        if (Clusters[Corners[0]] == Clusters[Corners[1]] || Clusters[Corners[1]] == Clusters[Corners[2]] || Clusters[Corners[0]] == Clusters[Corners[2]]
+                            || CrossSquared <= FMath::Square(MinTriangleHeightRatio * LongestSquared))
+                        {
+                            ++BlockDegenerate[Block];
+                            continue;
+                        }
+
+                        Keep[Tri] = 1;
+                        ++BlockKept[Block];
+                    }
+                });
+
+            TArray<int32> BlockOffsets;
+            BlockOffsets.SetNumUninitialized(NumBlocks);
+            int32 NumKept = 0;
+            for (int32 Block = 0; Block < NumBlocks; ++Block)
+            {
+                BlockOffsets[Block] = NumKept;
+                NumKept += BlockKept[Block];
+                Stats.NumInvalidTriangles += BlockInvalid[Block];
+                Stats.NumDegenerateTriangles += BlockDegenerate[Block];
+            }
+
+            Plan.Triangles.SetNumUninitialized(NumKept * 3);
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    int32 Out = BlockOffsets[Begin / ParallelBlockSize] * 3;
+                    for (int32 Tri = Begin; Tri < End; ++Tri)
+                    {
+                        if (Keep[Tri])
+                        {
+                            Plan.Triangles[Out++] = Merged[Indices[Tri * 3]];
+                            Plan.Triangles[Out++] = Merged[Indices[Tri * 3 + 1]];
+                            Plan.Triangles[Out++] = Merged[Indices[Tri * 3 + 2]];
+                        }
+                    }
+                });
+            Stats.FilterMs = ElapsedMs(PhaseStart);
+
+            // 4. 남은 삼각형이 참조하는 정점만 원래 순서대로 남기고 인덱스를 고친다
+            PhaseStart = FPlatformTime::Seconds();
+            TArray<int32> NewIndex;
+            NewIndex.Init(INDEX_NONE, NumVertices);
+            for (const int32 Index : Plan.Triangles)
+            {
+                NewIndex[Index] = 0;
+            }
+
+            int32 NumNewVertices = 0;
+            for (int32 i = 0; i < NumVertices; ++i)
+            {
+                if (NewIndex[i] != INDEX_NONE)
+                {
+                    NewIndex[i] = NumNewVertices++;
+                }
+                else if (Merged[i] == i)
+                {
+                    // 합쳐진 정점과 NaN/Inf 정점은 이미 따로 셌다
+                    ++Stats.NumUnreferencedVertices;
+                }
+            }
+
+            Plan.AttributeSources.SetNumUninitialized(NumNewVertices);
+            Plan.PositionSources.SetNumUninitialized(NumNewVertices);
+            ParallelForRange(NumVertices, [&](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        if (NewIndex[i] != INDEX_NONE)
+                        {
+                            Plan.AttributeSources[NewIndex[i]] = i;
+                            Plan.PositionSources[NewIndex[i]] = Clusters[i];
+                        }
+                    }
+                });
+            ParallelForRange(Plan.Triangles.Num(), [&](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        Plan.Triangles[i] = NewIndex[Plan.Triangles[i]];
+                    }
+                });
+            Stats.CompactMs = ElapsedMs(PhaseStart);
+        }
+
+        // Sources 순서로 속성을 다시 모은다. 일부만 채워진 속성은 DefaultValue 로 채운다.
+        template<typename T>
+        void GatherAttribute(TArray<T>& Attribute, TConstArrayView<int32> Sources, const T& DefaultValue)
+        {
+            if (Attribute.Num() == 0)
+            {
+                return;
+            }
+
+            TArray<T> Gathered;
+            Gathered.SetNumUninitialized(Sources.Num());
+            ParallelForRange(Sources.Num(), [&Attribute, &Gathered, Sources, &DefaultValue](int32 Begin, int32 End)
+                {
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        Gathered[i] = Attribute.IsValidIndex(Sources[i]) ? Attribute[Sources[i]] : DefaultValue;
+                    }
+                });
+            Attribute = MoveTemp(Gathered);
+        }
+    }
+
+    FProcMeshRepairStats RepairMesh(FProcMeshData& MeshData, float WeldThreshold)
+    {
+        FProcMeshRepairStats Stats;
+        FRepairPlan Plan;
+        const FProcMeshDataView Source(MeshData);
+        MakeRepairPlan(FMeshDataAccessor{ Source }, WeldThreshold, Plan, Stats);
+
+        // 위치는 용접 대표 정점에서, 나머지 속성은 원래 정점에서 가져온다
+        const double PhaseStart = FPlatformTime::Seconds();
+        GatherAttribute(MeshData.Vertices, Plan.PositionSources, FVector::ZeroVector);
+        GatherAttribute(MeshData.Normals, Plan.AttributeSources, FVector::ZeroVector);
+        GatherAttribute(MeshData.UV0, Plan.AttributeSources, FVector2D::ZeroVector);
+        GatherAttribute(MeshData.VertexColors, Plan.AttributeSources, FLinearColor::White);
+        GatherAttribute(MeshData.Tangents, Plan.AttributeSources, FProcMeshTangent(FVector::ZeroVector, false));
+        MeshData.Triangles = MoveTemp(Plan.Triangles);
+        Stats.CompactMs += ElapsedMs(PhaseStart);
+        return Stats;
+    }
+
+    FProcMeshRepairStats RepairMesh(FProcMeshBuffer& Buffer, float WeldThreshold)
+    {
+        FProcMeshRepairStats Stats;
+        FRepairPlan Plan;
+        const FProcMeshBufferView Source(Buffer);
+        MakeRepairPlan(FMeshBufferAccessor{ Source }, WeldThreshold, Plan, Stats);
+
+        const double PhaseStart = FPlatformTime::Seconds();
+        GatherAttribute(Buffer.PositionX, Plan.PositionSources, 0.0f);
+        GatherAttribute(Buffer.PositionY, Plan.PositionSources, 0.0f);
+        GatherAttribute(Buffer.PositionZ, Plan.PositionSources, 0.0f);
+        for (TArray<float>* Component : { &Buffer.NormalX, &Buffer.NormalY, &Buffer.NormalZ, &Buffer.U, &Buffer.V, &Buffer.TangentX, &Buffer.TangentY, &Buffer.TangentZ })
+        {
+            GatherAttribute(*Component, Plan.AttributeSources, 0.0f);
+        }
+        GatherAttribute(Buffer.BinormalSign, Plan.AttributeSources, 1.0f);
+        GatherAttribute(Buffer.Colors, Plan.AttributeSources, FLinearColor::White);
+        Buffer.Triangles = MoveTemp(Plan.Triangles);
+        Stats.CompactMs += ElapsedMs(PhaseStart);
+        return Stats;
+    }
+
+    namespace
+    {
+        // Tipsify 가 한 번에 이어서 내보낸 삼각형 묶음 (막다른 곳에서 건너뛸 때마다 새 묶음이 시작된다)
+        struct FTriangleCluster
+        {
+            int32 Begin = 0;
+            int32 End = 0;
+            float SortKey = 0.0f;
+        };
+
+        /**
+         * Tipsify (Sander et al. 2007). 캐시에 남아 있을 만한 정점을 부채꼴 중심으로 골라 그 정점의 남은 삼각형을 모두 내보낸다.
+         * 후보가 없으면 최근에 쓴 정점 스택, 그다음 정점 번호 순으로 다음 중심을 찾으므로 전체가 선형 시간이다.
+         * OutOrder 에는 원래 삼각형 번호를 출력 순서대로, OutClusters 에는 막다른 곳으로 끊긴 구간을 채운다.
+         * 잘못된 인덱스를 쓰는 삼각형은 OutInvalidTriangles 로 뺀다.
+         */
+        void TipsifyTriangleOrder(TConstArrayView<int32> Indices, const int32 NumVertices, const int32 CacheSize,
+            TArray<int32>& OutOrder, TArray<FTriangleCluster>& OutClusters, TArray<int32>& OutInvalidTriangles)
+        {
+            const int32 NumTriangles = Indices.Num() / 3;
+            FVertexCornerAdjacency Adjacency;
+            Adjacency.Build(NumVertices, Indices);
+
+            // 1. 정점마다 아직 내보내지 않은 삼각형 수
+            TArray<int32> LiveTriangles;
+            LiveTriangles.SetNumZeroed(NumVertices);
+            TBitArray<> Emitted(false, NumTriangles);
+            OutInvalidTriangles.Reset();
+            for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+            {
+                const int32* Corners = &Indices[Triangle * 3];
+                if (!LiveTriangles.IsValidIndex(Corners[0]) || !LiveTriangles.IsValidIndex(Corners[1]) || !LiveTriangles.IsValidIndex(Corners[2]))
+                {
+                    Emitted[Triangle] = true;
+                    OutInvalidTriangles.Add(Triangle);
+                    continue;
+                }
+                ++LiveTriangles[Corners[0]];
+                ++LiveTriangles[Corners[1]];
+                ++LiveTriangles[Corners[2]];
+            }
+
+            // 2. 부채꼴 단위로 내보내기
+            TArray<int32> CacheTime;
+            CacheTime.SetNumZeroed(NumVertices);
+            TArray<int32> DeadEndStack;
+            TArray<int32> Candidates;
+            int32 TimeStamp = CacheSize + 1;
+            int32 Cursor = 0;
+
+            auto SkipDeadEnd = [&LiveTriangles, &DeadEndStack, &Cursor, NumVertices]() -> int32
+            {
+                while (DeadEndStack.Num() > 0)
+                {
+                    const int32 Vertex = DeadEndStack.Pop(false);
+                    if (LiveTriangles[Vertex] > 0)
+                    {
+                        return Vertex;
+                    }
+                }
+                for (; Cursor < NumVertices; ++Cursor)
+                {
+                    if (LiveTriangles[Cursor] > 0)
+                    {
+                        return Cursor;
+                    }
+                }
+                return INDEX_NONE;
+            };
+
+            OutOrder.Reset(NumTriangles);
+            OutClusters.Reset();
+            int32 Fan = SkipDeadEnd();
+            while (Fan != INDEX_NONE)
+            {
+                Candidates.Reset();
+                for (const int32 Corner : Adjacency.GetCorners(Fan))
+                {
+                    const int32 Triangle = Corner / 3;
+                    if (Emitted[Triangle])
+                    {
+                        continue;
+                    }
+                    Emitted[Triangle] = true;
+                    OutOrder.Add(Triangle);
+                    for (int32 k = 0; k < 3; ++k)
+                    {
+                        const int32 Vertex = Indices[Triangle * 3 + k];
+                        DeadEndStack.Add(Vertex);
+                        Candidates.Add(Vertex);
+                        --LiveTriangles[Vertex];
+                        if (TimeStamp - CacheTime[Vertex] > CacheSize)
+                        {
+                            CacheTime[Vertex] = TimeStamp++;
+                        }
+                    }
+                }
+
+                // 남은 삼각형을 다 내보내도 캐시에서 밀려나지 않을 후보 중 가장 오래 전에 들어간 정점을 고른다
+                int32 BestVertex = INDEX_NONE;
+                int32 BestPriority = -1;
+                for (const int32 Vertex : Candidates)
+                {
+                    if (LiveTriangles[Vertex] <= 0)
+                    {
+                        continue;
+                    }
+                    const int32 Age = TimeStamp - CacheTime[Vertex];
+                    const int32 Priority = (Age + 2 * LiveTriangles[Vertex] <= CacheSize) ? Age : 0;
+                    if (Priority > BestPriority)
+                    {
+                        BestPriority = Priority;
+                        BestVertex = Vertex;
+                    }
+                }
+
+                if (BestVertex == INDEX_NONE)
+                {
+                    const int32 Begin = OutClusters.Num() > 0 ? OutClusters.Last().End : 0;
+                    if (OutOrder.Num() > Begin)
+                    {
+                        OutClusters.Add({ Begin, OutOrder.Num() });
+                    }
+                    BestVertex = SkipDeadEnd();
+                }
+                Fan = BestVertex;
+            }
+        }
+
+        /**
+         * 묶음을 바깥을 향하는 정도(면적 가중 법선 · (묶음 중심 - 메시 중심))가 큰 순서로 정렬한다.
+         * 볼록한 부분의 바깥면이 먼저 그려져 뒤쪽 묶음이 깊이 테스트에서 걸러진다.
+         * 묶음 경계는 어차피 캐시가 끊기는 곳이라 ACMR 은 거의 그대로다.
+         */
+        template<typename AccessorType>
+        void SortClustersForOverdraw(const AccessorType& Mesh, TConstArrayView<int32> Indices, TConstArrayView<int32> Order, TArray<FTriangleCluster>& Clusters)
+        {
+            if (Clusters.Num() <= 1)
+            {
+                return;
+            }
+
+            TArray<FVector3f> ClusterNormals;
+            TArray<FVector3f> ClusterCentroids;
+            TArray<float> ClusterAreas;
+            ClusterNormals.SetNumUninitialized(Clusters.Num());
+            ClusterCentroids.SetNumUninitialized(Clusters.Num());
+            ClusterAreas.SetNumUninitialized(Clusters.Num());
+            ParallelFor(Clusters.Num(), [&](int32 ClusterIndex)
+                {
+                    const FTriangleCluster& Cluster = Clusters[ClusterIndex];
+                    FVector3f NormalSum = FVector3f::ZeroVector;
+                    FVector3f CentroidSum = FVector3f::ZeroVector;
+                    float AreaSum = 0.0f;
+                    for (int32 i = Cluster.Begin; i < Cluster.End; ++i)
+                    {
+                        const int32* Corners = &Indices[Order[i] * 3];
+                        const FVector3f P0 = Mesh.Position(Corners[0]);
+                        const FVector3f P1 = Mesh.Position(Corners[1]);
+                        const FVector3f P2 = Mesh.Position(Corners[2]);
+                        // 법선 방향은 ComputeFaceNormals 와 같은 (V2 - V0) x (V1 - V0)
+                        const FVector3f Cross = FVector3f::CrossProduct(P2 - P0, P1 - P0);
+                        const float Area = Cross.Size() * 0.5f;
+                        NormalSum += Cross;
+                        CentroidSum += (P0 + P1 + P2) * (Area / 3.0f);
+                        AreaSum += Area;
+                    }
+                    ClusterNormals[ClusterIndex] = NormalSum.GetSafeNormal();
+                    ClusterCentroids[ClusterIndex] = AreaSum > 0.0f ? CentroidSum / AreaSum : Mesh.Position(Indices[Order[Cluster.Begin] * 3]);
+                    ClusterAreas[ClusterIndex] = AreaSum;
+                });
+
+            FVector3f MeshCentroid = FVector3f::ZeroVector;
+            float MeshArea = 0.0f;
+            for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+            {
+                MeshCentroid += ClusterCentroids[ClusterIndex] * ClusterAreas[ClusterIndex];
+                MeshArea += ClusterAreas[ClusterIndex];
+            }
+            MeshCentroid = MeshArea > 0.0f ? MeshCentroid / MeshArea : FVector3f::ZeroVector;
+
+            for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+            {
+                Clusters[ClusterIndex].SortKey = FVector3f::DotProduct(ClusterCentroids[ClusterIndex] - MeshCentroid, ClusterNormals[ClusterIndex]);
+            }
+            Clusters.StableSort([](const FTriangleCluster& A, const FTriangleCluster& B) { return A.SortKey > B.SortKey; });
+        }
+
+        template<typename AccessorType>
+        FProcMeshVertexCacheStats OptimizeIndexOrderFrom(const AccessorType& Mesh, TArray<int32>& InOutIndices, TConstArrayView<int32> SectionNumTriangles)
+        {
+            FProcMeshVertexCacheStats Stats;
+            const int32 NumVertices = Mesh.NumVertices();
+            Stats.ACMRBefore = ComputeACMR(InOutIndices, NumVertices);
+            Stats.ACMRAfter = Stats.ACMRBefore;
+            if (InOutIndices.Num() % 3 != 0)
+            {
+                return Stats;
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            const int32 NumTriangles = InOutIndices.Num() / 3;
+            TArray<int32, TInlineAllocator<1>> Sections(SectionNumTriangles.GetData(), SectionNumTriangles.Num());
+            if (Sections.Num() == 0)
+            {
+                Sections.Add(NumTriangles);
+            }
+
+            TArray<int32> LocalIndices;
+            LocalIndices.Init(INDEX_NONE, NumVertices);
+            TArray<int32> SectionVertices;
+            TArray<int32> SectionIndices;
+            TArray<int32> Order;
+            TArray<FTriangleCluster> Clusters;
+            TArray<int32> InvalidTriangles;
+            TArray<int32> Optimized;
+
+            int32 FirstTriangle = 0;
+            for (const int32 SectionTriangles : Sections)
+            {
+                const TArrayView<int32> Range(InOutIndices.GetData() + FirstTriangle * 3, SectionTriangles * 3);
+                FirstTriangle += SectionTriangles;
+                if (SectionTriangles < 2)
+                {
+                    continue;
+                }
+
+                // 1. 구간이 쓰는 정점만 0 부터 다시 번호를 매긴다 (구간마다 전체 정점 크기의 배열을 만들지 않도록)
+                SectionVertices.Reset();
+                SectionIndices.SetNumUninitialized(Range.Num(), false);
+                for (int32 i = 0; i < Range.Num(); ++i)
+                {
+                    const int32 Index = Range[i];
+                    if (!LocalIndices.IsValidIndex(Index))
+                    {
+                        SectionIndices[i] = INDEX_NONE;
+                        continue;
+                    }
+                    if (LocalIndices[Index] == INDEX_NONE)
+                    {
+                        LocalIndices[Index] = SectionVertices.Add(Index);
+                    }
+                    SectionIndices[i] = LocalIndices[Index];
+                }
+                for (const int32 Vertex : SectionVertices)
+                {
+                    LocalIndices[Vertex] = INDEX_NONE;
+                }
+
+                // 2. 정점 캐시 순서
+                TipsifyTriangleOrder(SectionIndices, SectionVertices.Num(), VertexCacheSize, Order, Clusters, InvalidTriangles);
+
+                // 3. 오버드로 순서
+                SortClustersForOverdraw(Mesh, Range, Order, Clusters);
+
+                // 4. 묶음 순서대로 구간을 다시 쓴다 (잘못된 삼각형은 빌드에서 걸러지도록 구간 끝에 그대로 둔다)
+                Optimized.Reset(Range.Num());
+                auto AppendTriangle = [&Optimized, &Range](const int32 Triangle)
+                {
+                    Optimized.Append(&Range[Triangle * 3], 3);
+                };
+                for (const FTriangleCluster& Cluster : Clusters)
+                {
+                    for (int32 i = Cluster.Begin; i < Cluster.End; ++i)
+                    {
+                        AppendTriangle(Order[i]);
+                    }
+                }
+                for (const int32 Triangle : InvalidTriangles)
+                {
+                    AppendTriangle(Triangle);
+                }
+                FMemory::Memcpy(Range.GetData(), Optimized.GetData(), Range.Num() * sizeof(int32));
+            }
+
+            Stats.OptimizeMs = ElapsedMs(StartTime);
+            Stats.ACMRAfter = ComputeACMR(InOutIndices, NumVertices);
+            return Stats;
+        }
+    }
+
+    float ComputeACMR(TConstArrayView<int32> Indices, int32 NumVertices, int32 CacheSize)
+    {
+        const int32 NumTriangles = Indices.Num() / 3;
+        if (NumTriangles == 0 || NumVertices <= 0)
+        {
+            return 0.0f;
+        }
+
+        // FIFO 는 들어간 시각만 기록하면 된다. 그 뒤로 CacheSize 번 넘게 미스가 났으면 밀려난 것이다.
+        TArray<int32> InsertTime;
+        InsertTime.Init(INDEX_NONE, NumVertices);
+        int32 NumMisses = 0;
+        for (const int32 Index : Indices)
+        {
+            if (!InsertTime.IsValidIndex(Index))
+            {
+                continue;
+            }
+            if (InsertTime[Index] == INDEX_NONE || NumMisses - InsertTime[Index] > CacheSize)
+            {
+                InsertTime[Index] = NumMisses++;
+            }
+        }
+        return static_cast<float>(NumMisses) / NumTriangles;
+    }
+
+    FProcMeshVertexCacheStats OptimizeIndexOrder(const FProcMeshDataView& MeshData, TArray<int32>& InOutIndices, TConstArrayView<int32> SectionNumTriangles)
+    {
+        return OptimizeIndexOrderFrom(FMeshDataAccessor{ MeshData }, InOutIndices, SectionNumTriangles);
+    }
+
+    FProcMeshVertexCacheStats OptimizeIndexOrder(const FProcMeshBufferView& MeshBuffer, TArray<int32>& InOutIndices, TConstArrayView<int32> SectionNumTriangles)
+    {
+        return OptimizeIndexOrderFrom(FMeshBufferAccessor{ MeshBuffer }, InOutIndices, SectionNumTriangles);
+    }
+
+    FProcMeshVertexCacheStats OptimizeVertexOrder(FProcMeshData& MeshData)
+    {
+        const FProcMeshDataView Source(MeshData);
+        FProcMeshVertexCacheStats Stats = OptimizeIndexOrder(Source, MeshData.Triangles);
+
+        // 처음 쓰이는 순서로 새 번호를 매기고, 참조되지 않는 정점은 원래 순서대로 뒤에 붙인다
+        const double StartTime = FPlatformTime::Seconds();
+        const int32 NumVertices = MeshData.Vertices.Num();
+        TArray<int32> NewIndices;
+        NewIndices.Init(INDEX_NONE, NumVertices);
+        TArray<int32> Sources;
+        Sources.Reserve(NumVertices);
+        for (int32& Index : MeshData.Triangles)
+        {
+            if (!NewIndices.IsValidIndex(Index))
+            {
+                continue;
+            }
+            if (NewIndices[Index] == INDEX_NONE)
+            {
+                NewIndices[Index] = Sources.Add(Index);
+            }
+            Index = NewIndices[Index];
+        }
+        for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+        {
+            if (NewIndices[Vertex] == INDEX_NONE)
+            {
+                Sources.Add(Vertex);
+            }
+        }
+
+        GatherAttribute(MeshData.Vertices, Sources, FVector::ZeroVector);
+        GatherAttribute(MeshData.Normals, Sources, FVector::ZeroVector);
+        GatherAttribute(MeshData.UV0, Sources, FVector2D::ZeroVector);
+        GatherAttribute(MeshData.VertexColors, Sources, FLinearColor::White);
+        GatherAttribute(MeshData.Tangents, Sources, FProcMeshTangent(FVector::ZeroVector, false));
+        Stats.OptimizeMs += ElapsedMs(StartTime);
+        return Stats;
+    }
+
+    namespace
+    {
+        // 단위 구 위에 고르게 퍼진 방향 (피보나치 격자)
+        void MakeSupportDirections(const int32 NumDirections, TArray<FVector3f>& OutDirections)
+        {
+            const float GoldenAngle = PI * (3.0f - FMath::Sqrt(5.0f));
+            OutDirections.SetNumUninitialized(NumDirections);
+            for (int32 i = 0; i < NumDirections; ++i)
+            {
+                const float Y = 1.0f - 2.0f * (i + 0.5f) / NumDirections;
+                const float Radius = FMath::Sqrt(FMath::Max(1.0f - Y * Y, 0.0f));
+                float Sin, Cos;
+                FMath::SinCos(&Sin, &Cos, GoldenAngle * i);
+                OutDirections[i] = FVector3f(Cos * Radius, Y, Sin * Radius);
+            }
+        }
+
+        /**
+         * 방향마다 내적이 가장 큰 정점을 골라 중복 없이 OutPoints 에 담는다.
+         * 정점 범위별로 방향마다의 최댓값을 병렬로 구한 뒤 합치므로 정점 수에 선형이다.
+         */
+        void GatherSupportPoints(TConstArrayView<FVector3f> Positions, TConstArrayView<int32> Vertices, TConstArrayView<FVector3f> Directions, TArray<FVector3f>& OutPoints)
+        {
+            const int32 NumDirections = Directions.Num();
+            const int32 NumBlocks = FMath::DivideAndRoundUp(Vertices.Num(), ParallelBlockSize);
+            TArray<float> BlockBestDots;
+            TArray<int32> BlockBestVertices;
+            BlockBestDots.Init(-MAX_flt, NumBlocks * NumDirections);
+            BlockBestVertices.Init(INDEX_NONE, NumBlocks * NumDirections);
+
+            ParallelForRange(Vertices.Num(), [&](int32 Begin, int32 End)
+                {
+                    const int32 Offset = (Begin / ParallelBlockSize) * NumDirections;
+                    float* BestDots = BlockBestDots.GetData() + Offset;
+                    int32* BestVertices = BlockBestVertices.GetData() + Offset;
+                    for (int32 i = Begin; i < End; ++i)
+                    {
+                        const FVector3f& Position = Positions[Vertices[i]];
+                        for (int32 Dir = 0; Dir < NumDirections; ++Dir)
+                        {
+                            const float Dot = Position | Directions[Dir];
+                            if (Dot > BestDots[Dir])
+                            {
+                                BestDots[Dir] = Dot;
+                                BestVertices[Dir] = Vertices[i];
+                            }
+                        }
+                    }
+                });
+
+            TArray<int32, TInlineAllocator<64>> Selected;
+            for (int32 Dir = 0; Dir < NumDirections; ++Dir)
+            {
+                int32 Best = INDEX_NONE;
+                for (int32 Block = 0; Block < NumBlocks; ++Block)
+                {
+                    const int32 Slot = Block * NumDirections + Dir;
+                    if (BlockBestVertices[Slot] != INDEX_NONE && (Best == INDEX_NONE || BlockBestDots[Slot] > BlockBestDots[Best]))
+                    {
+                        Best = Slot;
+                    }
+                }
+                if (Best != INDEX_NONE)
+                {
+                    Selected.AddUnique(BlockBestVertices[Best]);
+                }
+            }
+
+            OutPoints.Reset(Selected.Num());
+            for (const int32 Vertex : Selected)
+            {
+                OutPoints.Add(Positions[Vertex]);
+            }
+        }
+
+        // 오목 깊이를 잴 때 쓰는 고정 방향 수, 묶음의 면 법선에서 더할 최대 방향 수, 묶음당 최대 표본 삼각형 수
+        constexpr int32 NumConcavityDirections = 64;
+        constexpr int32 MaxFaceDirections = 64;
+        constexpr int32 MaxConcavitySamples = 4096;
+        // 나누는 평면 후보 수 (축마다 삼각형 중심 범위를 고르게 나눈 위치)
+        constexpr int32 NumSplitCandidates = 7;
+        // 한 묶음에 남길 최소 삼각형 수 (이보다 작으면 껍질이 평면으로 무너지기 쉽다)
+        constexpr int32 MinClusterTriangles = 4;
+
+        struct FConcavityContext
+        {
+            TConstArrayView<FVector3f> Positions;
+            TConstArrayView<int32> Indices;
+            TConstArrayView<FVector3f> Centroids;
+            TConstArrayView<FVector3f> Normals;
+            TArray<FVector3f> Directions;
+        };
+
+        // 큰 묶음은 고르게 건너뛰며 MaxConcavitySamples 개 안쪽으로 뽑는다
+        void SampleTriangles(TConstArrayView<int32> Cluster, TArray<int32>& OutSamples)
+        {
+            const int32 Stride = FMath::Max(FMath::DivideAndRoundUp(Cluster.Num(), MaxConcavitySamples), 1);
+            OutSamples.Reset();
+            for (int32 i = 0; i < Cluster.Num(); i += Stride)
+            {
+                OutSamples.Add(Cluster[i]);
+            }
+        }
+
+        /**
+         * 삼각형 묶음의 오목 깊이. 고정 방향과 묶음의 면 법선 방향마다 양쪽 지지 평면으로 묶음의 볼록 껍질을 근사하고,
+         * 삼각형 중심에서 법선에 가장 가까운 방향으로 껍질까지 잰 거리(양쪽 중 짧은 쪽이라 감김 방향과 무관)의 최대값을 쓴다.
+         * 볼록한 묶음의 면은 자기 지지 평면 위에 있으므로 0 이고, 얇게 잘린 오목한 조각도 법선 방향으로는 깊이가 그대로 남는다.
+         */
+        float MeasureConcavity(const FConcavityContext& Context, TConstArrayView<int32> Triangles)
+        {
+            // 1. 고정 방향에 묶음의 서로 다른 면 법선을 더한다 (평평한 면은 자기 법선으로 정확히 0)
+            TArray<FVector3f, TInlineAllocator<NumConcavityDirections + MaxFaceDirections>> Directions(Context.Directions);
+            for (const int32 Triangle : Triangles)
+            {
+                if (Directions.Num() >= NumConcavityDirections + MaxFaceDirections)
+                {
+                    break;
+                }
+                const FVector3f& Normal = Context.Normals[Triangle];
+                if (Normal.IsZero())
+                {
+                    continue;
+                }
+                bool bDuplicate = false;
+                for (int32 Dir = NumConcavityDirections; Dir < Directions.Num() && !bDuplicate; ++Dir)
+                {
+                    bDuplicate = FMath::Abs(Normal | Directions[Dir]) > 0.999f;
+                }
+                if (!bDuplicate)
+                {
+                    Directions.Add(Normal);
+                }
+            }
+
+            // 2. 방향마다 양쪽 지지 평면
+            TArray<FVector2f, TInlineAllocator<NumConcavityDirections + MaxFaceDirections>> Support;
+            Support.Init(FVector2f(MAX_flt, -MAX_flt), Directions.Num());
+            for (const int32 Triangle : Triangles)
+            {
+                for (int32 Corner = 0; Corner < 3; ++Corner)
+                {
+                    const FVector3f& Position = Context.Positions[Context.Indices[Triangle * 3 + Corner]];
+                    for (int32 Dir = 0; Dir < Directions.Num(); ++Dir)
+                    {
+                        const float Distance = Position | Directions[Dir];
+                        Support[Dir].X = FMath::Min(Support[Dir].X, Distance);
+                        Support[Dir].Y = FMath::Max(Support[Dir].Y, Distance);
+                    }
+                }
+            }
+
+            // 3. 삼각형 중심에서 법선에 가장 가까운 방향으로 껍질까지의 거리
+            float Concavity = 0.0f;
+            for (const int32 Triangle : Triangles)
+            {
+                const FVector3f& Normal = Context.Normals[Triangle];
+                if (Normal.IsZero())
+                {
+                    continue;
+                }
+                int32 Best = 0;
+                float BestAlignment = -1.0f;
+                for (int32 Dir = 0; Dir < Directions.Num(); ++Dir)
+                {
+                    const float Alignment = FMath::Abs(Normal | Directions[Dir]);
+                    if (Alignment > BestAlignment)
+                    {
+                        BestAlignment = Alignment;
+                        Best = Dir;
+                    }
+                }
+                const float Distance = Context.Centroids[Triangle] | Directions[Best];
+                Concavity = FMath::Max(Concavity, FMath::Min(Support[Best].Y - Distance, Distance - Support[Best].X));
+            }
+            return Concavity;
+        }
+
+        /**
+         * 오목 깊이가 MaxConcavity 를 넘는 묶음 중 가장 오목한 것을 나누기를 MaxClusters 개가 될 때까지 반복한다. (볼록한 입력은 나누지 않음)
+         * 나누는 평면은 축마다의 후보 중 두 쪽 오목 깊이를 삼각형 수로 가중한 합이 가장 작은 것이며(볼록한 큰 조각을 먼저 떼어 냄), 후보 평가는 병렬로 한다.
+         */
+        void SplitConcaveClusters(const FConcavityContext& Context, const float MaxConcavity, const int32 MaxClusters, TArray<TArray<int32>>& InOutClusters)
+        {
+            TArray<int32> Samples;
+            TArray<float> Concavities;
+            for (const TArray<int32>& Cluster : InOutClusters)
+            {
+                SampleTriangles(Cluster, Samples);
+                Concavities.Add(MeasureConcavity(Context, Samples));
+            }
+
+            while (InOutClusters.Num() < MaxClusters)
+            {
+                // 1. 허용치를 넘는 가장 오목한 묶음
+                int32 Target = INDEX_NONE;
+                for (int32 i = 0; i < InOutClusters.Num(); ++i)
+                {
+                    if (InOutClusters[i].Num() >= MinClusterTriangles * 2 && Concavities[i] > MaxConcavity
+                        && (Target == INDEX_NONE || Concavities[i] > Concavities[Target]))
+                    {
+                        Target = i;
+                    }
+                }
+                if (Target == INDEX_NONE)
+                {
+                    break;
+                }
+
+                // 2. 후보 평면마다 표본을 두 쪽으로 나눠 삼각형 수로 가중한 오목 깊이의 합을 잰다
+                SampleTriangles(InOutClusters[Target], Samples);
+                FBox3f Bounds(ForceInit);
+                for (const int32 Triangle : Samples)
+                {
+                    Bounds += Context.Centroids[Triangle];
+                }
+                auto GetPlane = [&Bounds](const int32 Candidate)
+                {
+                    const int32 Axis = Candidate / NumSplitCandidates;
+                    const float Alpha = static_cast<float>(Candidate % NumSplitCandidates + 1) / (NumSplitCandidates + 1);
+                    return FMath::Lerp(Bounds.Min[Axis], Bounds.Max[Axis], Alpha);
+                };
+
+                TArray<float> Costs;
+                Costs.Init(MAX_flt, 3 * NumSplitCandidates);
+                ParallelFor(Costs.Num(), [&](int32 Candidate)
+                    {
+                        const int32 Axis = Candidate / NumSplitCandidates;
+                        const float Plane = GetPlane(Candidate);
+                        TArray<int32> Lower;
+                        TArray<int32> Upper;
+                        for (const int32 Triangle : Samples)
+                        {
+                            (Context.Centroids[Triangle][Axis] < Plane ? Lower : Upper).Add(Triangle);
+                        }
+                        if (Lower.Num() > 0 && Upper.Num() > 0)
+                        {
+                            Costs[Candidate] = MeasureConcavity(Context, Lower) * Lower.Num() + MeasureConcavity(Context, Upper) * Upper.Num();
+                        }
+                    });
+                int32 Best = INDEX_NONE;
+                for (int32 Candidate = 0; Candidate < Costs.Num(); ++Candidate)
+                {
+                    if (Costs[Candidate] < MAX_flt && (Best == INDEX_NONE || Costs[Candidate] < Costs[Best]))
+                    {
+                        Best = Candidate;
+                    }
+                }
+
+                // 3. 묶음 전체를 고른 평면으로 나눈다. 한쪽이 너무 작으면 같은 축(후보가 없으면 가장 긴 축)의 중앙값으로 나눈다
+                TArray<int32> Lower;
+                TArray<int32> Upper;
+                int32 Axis = INDEX_NONE;
+                if (Best != INDEX_NONE)
+                {
+                    Axis = Best / NumSplitCandidates;
+                    const float Plane = GetPlane(Best);
+                    for (const int32 Triangle : InOutClusters[Target])
+                    {
+                        (Context.Centroids[Triangle][Axis] < Plane ? Lower : Upper).Add(Triangle);
+                    }
+                }
+                if (Lower.Num() < MinClusterTriangles || Upper.Num() < MinClusterTriangles)
+                {
+                    if (Axis == INDEX_NONE)
+                    {
+                        const FVector3f Extent = Bounds.GetExtent();
+                        Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+                    }
+                    TArray<int32>& Cluster = InOutClusters[Target];
+                    Cluster.Sort([&Context, Axis](const int32 A, const int32 B)
+                        {
+                            return Context.Centroids[A][Axis] < Context.Centroids[B][Axis];
+                        });
+                    const int32 Half = Cluster.Num() / 2;
+                    Lower = TArray<int32>(Cluster.GetData(), Half);
+                    Upper = TArray<int32>(Cluster.GetData() + Half, Cluster.Num() - Half);
+                }
+
+                SampleTriangles(Lower, Samples);
+                Concavities[Target] = MeasureConcavity(Context, Samples);
+                SampleTriangles(Upper, Samples);
+                Concavities.Add(MeasureConcavity(Context, Samples));
+                InOutClusters[Target] = MoveTemp(Lower);
+                InOutClusters.Add(MoveTemp(Upper));
+            }
+        }
+    }
+
+    void BuildCollisionHulls(const FMeshDescription& MeshDesc, const FProcMeshConvertOptions& Options, TArray<TArray<FVector3f>>& OutHulls)
+    {
+        OutHulls.Reset();
+        const bool bDecompose = Options.CollisionMode == EProcCollisionMode::ConvexDecomposition;
+        if (!bDecompose && Options.CollisionMode != EProcCollisionMode::ConvexHull)
+        {
+            return;
+        }
+
+        // 1. 삼각형 인덱스 버퍼 (정점 ID 는 위치 배열의 인덱스)
+        const FStaticMeshConstAttributes Attributes(MeshDesc);
+        const TConstArrayView<FVector3f> Positions = Attributes.GetVertexPositions().GetRawArray();
+        TArray<int32> Indices;
+        Indices.Reserve(MeshDesc.Triangles().Num() * 3);
+        for (const FTriangleID TriangleID : MeshDesc.Triangles().GetElementIDs())
+        {
+            for (const FVertexID VertexID : MeshDesc.GetTriangleVertices(TriangleID))
+            {
+                Indices.Add(VertexID.GetValue());
+            }
+        }
+        const int32 NumTriangles = Indices.Num() / 3;
+        if (NumTriangles == 0)
+        {
+            return;
+        }
+
+        // 2. 삼각형 묶음 (볼록 껍질 하나면 전체가 한 묶음)
+        TArray<TArray<int32>> Clusters;
+        TArray<int32>& AllTriangles = Clusters.AddDefaulted_GetRef();
+        AllTriangles.SetNumUninitialized(NumTriangles);
+        for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+        {
+            AllTriangles[Triangle] = Triangle;
+        }
+
+        const int32 MaxHulls = bDecompose ? FMath::Max(Options.MaxConvexHulls, 1) : 1;
+        if (MaxHulls > 1)
+        {
+            TArray<FVector3f> Centroids;
+            TArray<FVector3f> Normals;
+            Centroids.SetNumUninitialized(NumTriangles);
+            Normals.SetNumUninitialized(NumTriangles);
+            ParallelForRange(NumTriangles, [&](int32 Begin, int32 End)
+                {
+                    for (int32 Triangle = Begin; Triangle < End; ++Triangle)
+                    {
+                        const int32* Corner = Indices.GetData() + Triangle * 3;
+                        const FVector3f& P0 = Positions[Corner[0]];
+                        const FVector3f& P1 = Positions[Corner[1]];
+                        const FVector3f& P2 = Positions[Corner[2]];
+                        Centroids[Triangle] = (P0 + P1 + P2) / 3.0f;
+                        Normals[Triangle] = ((P1 - P0) ^ (P2 - P0)).GetSafeNormal();
+                    }
+                });
+
+            // 허용 오목 깊이는 메시 크기에 대한 비율
+            FBox3f Bounds(ForceInit);
+            for (const FVector3f& Position : Positions)
+            {
+                Bounds += Position;
+            }
+            FConcavityContext Context;
+            Context.Positions = Positions;
+            Context.Indices = Indices;
+            Context.Centroids = Centroids;
+            Context.Normals = Normals;
+            MakeSupportDirections(NumConcavityDirections, Context.Directions);
+            SplitConcaveClusters(Context, FMath::Max(Options.MaxConcavity, 0.0f) * Bounds.GetSize().Size(), MaxHulls, Clusters);
+        }
+
+        // 3. 묶음별로 쓰는 정점을 모아 지지점 계산 (묶음끼리도, 묶음 안의 정점 범위끼리도 병렬)
+        TArray<FVector3f> Directions;
+        MakeSupportDirections(FMath::Max(Options.MaxHullVertices, 4), Directions);
+
+        TArray<TArray<FVector3f>> Hulls;
+        Hulls.SetNum(Clusters.Num());
+        ParallelFor(Clusters.Num(), [&](int32 ClusterIndex)
+            {
+                TBitArray<> bUsed(false, Positions.Num());
+                TArray<int32> Vertices;
+                for (const int32 Triangle : Clusters[ClusterIndex])
+                {
+                    for (int32 Corner = 0; Corner < 3; ++Corner)
+                    {
+                        const int32 Vertex = Indices[Triangle * 3 + Corner];
+                        if (!bUsed[Vertex])
+                        {
+                            bUsed[Vertex] = true;
+                            Vertices.Add(Vertex);
+                        }
+                    }
+                }
+                GatherSupportPoints(Positions, Vertices, Directions, Hulls[ClusterIndex]);
+            });
+
+        for (TArray<FVector3f>& Hull : Hulls)
+        {
+            if (Hull.Num() >= 4)
+            {
+                OutHulls.Add(MoveTemp(Hull));
+            }
+        }
+    }
+}
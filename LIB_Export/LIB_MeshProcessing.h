@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "LIB_Export.h"
+#include "LIB_MeshBuffer.h"
+
+struct FMeshDescription;
+
+/**
+ * ULIB_Export 변환 파이프라인에서 사용하는 메시 처리 커널 모음.
+ * 모두 게임 스레드가 아닌 곳에서 호출해도 안전하며, UObject 에 접근하지 않는다.
+ */
+namespace LIB_MeshProcessing
+{
+	// ParallelFor 한 작업이 처리하는 원소 수
+	constexpr int32 ParallelBlockSize = 16384;
+
+	// [Begin, End) 범위로 나누어 병렬 실행. 블록이 하나뿐이면 현재 스레드에서 실행한다.
+	inline void ParallelForRange(const int32 Num, TFunctionRef<void(int32, int32)> Body, const int32 BlockSize = ParallelBlockSize)
+	{
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockSize);
+		ParallelFor(NumBlocks, [&Body, Num, BlockSize](int32 BlockIndex)
+			{
+				const int32 Begin = BlockIndex * BlockSize;
+				Body(Begin, FMath::Min(Begin + BlockSize, Num));
+			}, NumBlocks <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	// 정점 -> 코너(삼각형 인덱스 버퍼 위치) 역참조 테이블 (CSR 형식)
+	struct FVertexCornerAdjacency
+	{
+		TArray<int32> Offsets;
+		TArray<int32> Corners;
+
+		// 범위를 벗어난 인덱스는 무시한다
+		void Build(const int32 NumVertices, TConstArrayView<int32> Indices);
+
+		TConstArrayView<int32> GetCorners(const int32 Vertex) const
+		{
+			return MakeArrayView(Corners.GetData() + Offsets[Vertex], Offsets[Vertex + 1] - Offsets[Vertex]);
+		}
+	};
+
+	// 삼각형별 단위 법선과 코너별 가중치
+	struct FFaceNormals
+	{
+		TArray<FVector3f> Normals;
+		TArray<float> CornerWeights;
+	};
+
+	/**
+	 * 삼각형 법선과 코너 가중치를 병렬로 계산합니다.
+	 * 법선 방향은 기존 변환 코드와 같은 (V2 - V0) x (V1 - V0) 입니다.
+	 * Positions 는 TConstArrayView<FVector>, TConstArrayView<FVector3f>, FProcMeshBufferPositions 중 하나입니다.
+	 */
+	template<typename PositionArray>
+	void ComputeFaceNormals(const PositionArray& Positions, TConstArrayView<int32> Indices, EProcNormalWeighting Weighting, FFaceNormals& OutFaces);
+
+	/**
+	 * 인접 삼각형 법선의 가중 평균으로 정점 법선을 계산합니다.
+	 * 삼각형 병렬 패스 후 정점 병렬 패스에서 합산하므로 삼각형 순서와 무관하게 같은 결과가 나옵니다.
+	 */
+	void ComputeVertexNormals(const FFaceNormals& Faces, const FVertexCornerAdjacency& Adjacency, TArrayView<FVector3f> OutNormals);
+
+	/**
+	 * 정점을 둘러싼 삼각형을 크리즈 각도 이내로 맞닿은 변끼리 이어 스무딩 팬으로 묶고, 팬마다 평균한 법선을 코너별로 계산합니다.
+	 * 정점마다 코너의 양쪽 변을 정렬해 이웃을 찾으므로 비용은 정점 차수 k 에 대해 O(k log k) 입니다.
+	 * @param OutCornerNormals 인덱스 버퍼와 같은 크기
+	 * @param OutCornerGroups 비어 있지 않으면 코너가 속한 팬 번호 (정점마다 코너 순서대로 0 부터)
+	 */
+	void ComputeCornerNormals(const FFaceNormals& Faces, const FVertexCornerAdjacency& Adjacency, TConstArrayView<int32> Indices, float CreaseAngleDegrees,
+		TArrayView<FVector3f> OutCornerNormals, TArrayView<int32> OutCornerGroups = TArrayView<int32>());
+
+	// 변환 가능한 입력인지 검사 (정점이 있고 인덱스 수가 3의 배수)
+	inline bool IsValidMeshData(const FProcMeshDataView& MeshData)
+	{
+		return MeshData.Vertices.Num() > 0 && MeshData.Triangles.Num() % 3 == 0;
+	}
+
+	inline bool IsValidMeshData(const FProcMeshBufferView& MeshBuffer)
+	{
+		return MeshBuffer.IsValid();
+	}
+
+	/**
+	 * Options 의 투영 방식(UVProjection, UVProjectionAxis, UVProjectionCenter, UVScale, UVOffset)으로 UV0 를 생성합니다.
+	 * 정점 범위별로 병렬 실행하며, 각 범위는 성분별 배치로 모아 4개씩 SIMD 로 계산합니다.
+	 * 박스 투영은 정점 법선을 쓰며, 법선이 없으면 면적 가중 평균 법선을 계산합니다.
+	 */
+	void GenerateUVs(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options, TArray<FVector2D>& OutUVs);
+	// OutBuffer 의 U/V 만 채웁니다.
+	void GenerateUVs(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options, FProcMeshBuffer& OutBuffer);
+
+	// UV0 가 비어 있으면 GenerateUVs 로 채운다
+	void GenerateMissingUVs(FProcMeshData& MeshData, const FProcMeshConvertOptions& Options);
+
+	/**
+	 * 빌드 전에 잘못된 기하를 정리합니다. 정점/삼각형 범위별로 병렬 실행되며 전체가 선형 시간입니다.
+	 * 1) NaN/Inf 정점 제외 및 WeldThreshold 이내 위치 용접 (속성까지 같아진 정점만 합침)
+	 * 2) 범위를 벗어난 인덱스, NaN/Inf 정점, 붕괴되거나 면적이 0 인 삼각형 제거
+	 * 3) 참조되지 않는 정점 압축 (남은 정점의 순서는 유지)
+	 */
+	FProcMeshRepairStats RepairMesh(FProcMeshData& MeshData, float WeldThreshold);
+	FProcMeshRepairStats RepairMesh(FProcMeshBuffer& Buffer, float WeldThreshold);
+
+	/**
+	 * 게임 스레드 밖에서 할 수 있는 전처리(검사, 정리, 법선 재계산, UV 생성, 탄젠트 생성)를 모두 수행합니다.
+	 * @param OutRepairStats Options.bRepairMesh 일 때 정리 결과를 받을 곳 (nullptr 가능)
+	 * @return 입력이 유효하지 않거나 정리 후 삼각형이 남지 않으면 false
+	 */
+	bool PrepareMeshData(FProcMeshData& MeshData, const FProcMeshConvertOptions& Options, FProcMeshRepairStats* OutRepairStats = nullptr);
+
+	/**
+	 * PrepareMeshData 와 같은 전처리를 원본을 수정하지 않고 수행합니다.
+	 * 새로 만든 버퍼(UV, 법선)만 Scratch 에 두고 OutView 는 원본 또는 Scratch 의 버퍼를 가리킵니다.
+	 * 정점 배열이 바뀌는 정리와 크리즈 분할만 원본 전체를 Scratch 로 복사합니다.
+	 * @return 입력이 유효하지 않거나 정리 후 삼각형이 남지 않으면 false
+	 */
+	bool PrepareMeshView(const FProcMeshDataView& Source, const FProcMeshConvertOptions& Options, FProcMeshData& Scratch, FProcMeshDataView& OutView, FProcMeshRepairStats* OutRepairStats = nullptr);
+	bool PrepareMeshView(const FProcMeshBufferView& Source, const FProcMeshConvertOptions& Options, FProcMeshBuffer& Scratch, FProcMeshBufferView& OutView, FProcMeshRepairStats* OutRepairStats = nullptr);
+
+	// BuildMeshDescription 이 모든 폴리곤 그룹에 붙이는 머티리얼 슬롯 이름 (섹션이 여러 개여도 머티리얼 0 번을 함께 쓰도록)
+	inline FName GetMaterialSlotName()
+	{
+		return FName(TEXT("ProcMesh"));
+	}
+
+	/**
+	 * 전처리된 MeshData 로 MeshDescription 을 만듭니다. UObject 에 접근하지 않으므로 워커에서 호출할 수 있습니다.
+	 * 같은 위치의 정점은 용접하고, 속성이 같은 정점 인스턴스는 공유합니다.
+	 * @param SectionNumTriangles 인덱스 버퍼 앞에서부터 연속된 구간별 삼각형 수. 구간마다 폴리곤 그룹을 만들고
+	 *                            정점 인스턴스는 구간 안에서만 공유하며, 구간별 인스턴스 구성은 병렬로 계산합니다. (비어 있으면 하나)
+	 */
+	void BuildMeshDescription(const FProcMeshDataView& MeshData, FMeshDescription& OutMeshDesc, TConstArrayView<int32> SectionNumTriangles = {});
+	void BuildMeshDescription(const FProcMeshBufferView& MeshBuffer, FMeshDescription& OutMeshDesc, TConstArrayView<int32> SectionNumTriangles = {});
+
+	/**
+	 * 삼각형 중심의 Morton 순서로 인덱스 버퍼를 정렬한 뒤, 한 구간이 참조하는 정점이 MaxSectionVertices 를 넘지 않도록 나눕니다.
+	 * 참조되는 정점이 처음부터 상한 이하이면 순서를 바꾸지 않고 구간 하나를 돌려줍니다.
+	 * 잘못된 인덱스를 쓰는 삼각형은 마지막 구간의 끝에 둡니다.
+	 * @param OutSectionNumTriangles 구간별 삼각형 수 (InOutIndices 앞에서부터 연속)
+	 */
+	void PartitionSections(const FProcMeshDataView& MeshData, TArray<int32>& InOutIndices, int32 MaxSectionVertices, TArray<int32>& OutSectionNumTriangles);
+	void PartitionSections(const FProcMeshBufferView& MeshBuffer, TArray<int32>& InOutIndices, int32 MaxSectionVertices, TArray<int32>& OutSectionNumTriangles);
+
+	/**
+	 * PartitionSections 와 같은 기준으로 나누되 인덱스 버퍼는 그대로 두고 구간별 원래 삼각형 번호를 돌려줍니다.
+	 * (점진 변환이 편집된 삼각형이 속한 구간을 찾는 데 사용. 잘못된 인덱스를 쓰는 삼각형은 마지막 구간에 들어감)
+	 */
+	void PartitionTriangles(const FProcMeshDataView& MeshData, int32 MaxSectionVertices, TArray<TArray<int32>>& OutSectionTriangles);
+
+	/**
+	 * QEM(이차 오차 행렬) 에지 붕괴로 LOD 인덱스 버퍼를 점진적으로 만듭니다.
+	 * 정점을 이웃 정점 위치로 옮기는 방식이라 결과는 원본 정점 배열을 가리키는 인덱스 버퍼이며,
+	 * 열린 경계와 UV/법선 이음매는 그 경계를 따라서만 붕괴합니다.
+	 * @param TriangleRatios 원본 대비 목표 삼각형 비율 (내림차순). 비율마다 OutLODIndices 에 하나씩 채웁니다.
+	 */
+	void SimplifyMesh(const FProcMeshDataView& MeshData, TConstArrayView<float> TriangleRatios, TArray<TArray<int32>>& OutLODIndices);
+	void SimplifyMesh(const FProcMeshBufferView& MeshBuffer, TConstArrayView<float> TriangleRatios, TArray<TArray<int32>>& OutLODIndices);
+
+	// Options 의 LOD 설정을 LOD0 부터의 삼각형 비율과 전환 화면 크기로 풉니다. (LOD0 은 둘 다 1)
+	void GetLODSettings(const FProcMeshConvertOptions& Options, TArray<float>& OutTriangleRatios, TArray<float>& OutScreenSizes);
+
+	/**
+	 * LOD0 과 Options.NumLODs 에 따른 단순화 LOD 의 MeshDescription 을 만듭니다. (LOD0 만 쓰면 BuildMeshDescription 과 같음)
+	 * Options.bSplitSections 이면 LOD 마다 PartitionSections 로 섹션을 나누고,
+	 * Options.bOptimizeVertexCache 이면 (섹션마다) OptimizeIndexOrder 를 거친 순서로 만듭니다.
+	 * @param OutCacheStats LOD0 의 재정렬 결과를 받을 곳 (nullptr 가능)
+	 */
+	void BuildLODMeshDescriptions(const FProcMeshDataView& MeshData, const FProcMeshConvertOptions& Options, TArray<FMeshDescription>& OutMeshDescs, FProcMeshVertexCacheStats* OutCacheStats = nullptr);
+	void BuildLODMeshDescriptions(const FProcMeshBufferView& MeshBuffer, const FProcMeshConvertOptions& Options, TArray<FMeshDescription>& OutMeshDescs, FProcMeshVertexCacheStats* OutCacheStats = nullptr);
+
+	/**
+	 * Options.CollisionMode 가 볼록 껍질일 때 LOD0 MeshDescription 으로 껍질마다의 점 집합을 만듭니다. (다른 모드면 비워 둠)
+	 * 고르게 퍼진 MaxHullVertices 개 방향마다 가장 바깥 정점(지지점)을 골라 단순화한 껍질을 만들며, 실제 껍질 구성은 쿠킹에서 합니다.
+	 * ConvexDecomposition 은 묶음의 오목 깊이(지지 평면으로 근사한 껍질까지 삼각형 중심에서 법선 방향으로 잰 최대 거리)가 MaxConcavity 를 넘는
+	 * 가장 오목한 묶음을, 축별 후보 평면 중 두 쪽 오목 깊이를 삼각형 수로 가중한 합이 가장 작은 평면으로 나누기를 MaxConvexHulls 개까지 반복한 뒤
+	 * 묶음별 껍질을 병렬로 계산합니다. 볼록한 입력은 나누지 않습니다. 점이 4개 미만인 껍질은 버립니다.
+	 */
+	void BuildCollisionHulls(const FMeshDescription& MeshDesc, const FProcMeshConvertOptions& Options, TArray<TArray<FVector3f>>& OutHulls);
+
+	// Tipsify 와 ACMR 측정이 가정하는 post-transform 정점 캐시 크기
+	constexpr int32 VertexCacheSize = 16;
+
+	// CacheSize 크기의 FIFO 캐시로 삼각형당 평균 정점 캐시 미스 수(ACMR)를 계산합니다. 범위를 벗어난 인덱스는 무시합니다.
+	float ComputeACMR(TConstArrayView<int32> Indices, int32 NumVertices, int32 CacheSize = VertexCacheSize);
+
+	/**
+	 * 인덱스 버퍼의 삼각형 순서를 Tipsify 로 정점 캐시에 맞게 바꾼 뒤, 막다른 곳에서 끊긴 묶음을
+	 * 바깥을 향하는 순서(묶음 법선 · (묶음 중심 - 메시 중심) 내림차순)로 정렬해 오버드로를 줄입니다.
+	 * 선형 시간이며 삼각형 집합과 각 삼각형의 감김 순서는 그대로입니다. 잘못된 인덱스를 쓰는 삼각형은 (구간의) 맨 뒤로 갑니다.
+	 * 정점 인스턴스는 BuildMeshDescription 에서 처음 쓰이는 순서로 만들어지므로 정점 fetch 순서도 함께 정렬됩니다.
+	 * @param InOutIndices MeshData 의 정점을 가리키는 인덱스 버퍼 (LOD 인덱스 버퍼도 가능)
+	 * @param SectionNumTriangles 주어지면 구간마다 따로 재정렬하여 구간 경계를 유지합니다.
+	 */
+	FProcMeshVertexCacheStats OptimizeIndexOrder(const FProcMeshDataView& MeshData, TArray<int32>& InOutIndices, TConstArrayView<int32> SectionNumTriangles = {});
+	FProcMeshVertexCacheStats OptimizeIndexOrder(const FProcMeshBufferView& MeshBuffer, TArray<int32>& InOutIndices, TConstArrayView<int32> SectionNumTriangles = {});
+
+	// OptimizeIndexOrder 후 정점 배열도 처음 쓰이는 순서로 옮깁니다. (참조되지 않는 정점은 원래 순서대로 맨 뒤)
+	FProcMeshVertexCacheStats OptimizeVertexOrder(FProcMeshData& MeshData);
+
+	/**
+	 * MeshData.Normals 를 다시 생성합니다.
+	 * CreaseAngleDegrees 가 0 이상이면 크리즈 경계의 정점을 복제하여 하드 엣지를 만듭니다. (0 이면 모든 엣지, 정점 수가 늘어날 수 있음)
+	 * 음수이면 크리즈 없이 정점당 법선 하나입니다.
+	 */
+	void RecalculateNormals(FProcMeshData& MeshData, EProcNormalWeighting Weighting, float CreaseAngleDegrees);
+	void RecalculateNormals(FProcMeshBuffer& Buffer, EProcNormalWeighting Weighting, float CreaseAngleDegrees);
+
+	/**
+	 * UV0 와 법선으로 MikkTSpace 규칙(코너 각도 가중, 법선 기준 직교화)의 정점 탄젠트와 바이노멀 부호를 생성합니다.
+	 * 법선이 없으면 면 법선 평균을 사용합니다. 입력 탄젠트는 읽지 않습니다.
+	 */
+	void GenerateTangents(const FProcMeshDataView& MeshData, TArray<FProcMeshTangent>& OutTangents);
+	// OutBuffer 의 TangentX/Y/Z 와 BinormalSign 만 채웁니다.
+	void GenerateTangents(const FProcMeshBufferView& MeshBuffer, FProcMeshBuffer& OutBuffer);
+}
@@ -0,0 +1,407 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_ScreenshotCapture.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "RenderingThread.h"
+#include "Rendering/SlateRenderer.h"
+#include "UnrealClient.h"
+
+namespace
+{
+    // 창이 최소화되어 백 버퍼가 표시되지 않는 경우 등을 위한 제한 시간
+    constexpr double CaptureTimeoutSeconds = 5.0;
+
+    // 백 버퍼 한 행을 BGRA8 로 변환. 지원하지 않는 형식이면 false
+    bool ConvertRow(const uint8* Src, FColor* Dest, const int32 Width, const EPixelFormat Format)
+    {
+        switch (Format)
+        {
+        case PF_B8G8R8A8:
+            FMemory::Memcpy(Dest, Src, Width * sizeof(FColor));
+            return true;
+        case PF_R8G8B8A8:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                Dest[X] = FColor(Src[X * 4 + 0], Src[X * 4 + 1], Src[X * 4 + 2], Src[X * 4 + 3]);
+            }
+            return true;
+        case PF_A2B10G10R10:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                uint32 Packed;
+                FMemory::Memcpy(&Packed, Src + X * 4, sizeof(uint32));
+                Dest[X] = FColor((Packed >> 2) & 0xFF, (Packed >> 12) & 0xFF, (Packed >> 22) & 0xFF, 255);
+            }
+            return true;
+        case PF_FloatRGBA:
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const FFloat16Color* Pixel = reinterpret_cast<const FFloat16Color*>(Src) + X;
+                Dest[X] = FLinearColor(*Pixel).ToFColor(true);
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // BGRA8 픽셀을 PNG 로 저장 (ImageWrapper 모듈이 로드되어 있어야 함)
+    bool SavePng(const TArray<FColor>& Pixels, const int32 Width, const int32 Height, const FString& Path)
+    {
+        IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+        if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+        {
+            return false;
+        }
+        const TArray64<uint8>& Compressed = ImageWrapper->GetCompressed();
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+        return Compressed.Num() > 0 && FFileHelper::SaveArrayToFile(Compressed, *Path);
+    }
+}
+
+std::atomic<bool> FScreenshotCapture::bBackBufferCaptureInFlight{ false };
+std::atomic<bool> FScreenshotCapture::bScreenshotRequestInFlight{ false };
+
+FScreenshotCapture::FScreenshotCapture(const bool bInCaptureUI, const FString& InFilePath, FOnComplete&& InOnComplete)
+    : bCaptureUI(bInCaptureUI)
+    , FilePath(InFilePath)
+    , OnComplete(MoveTemp(InOnComplete))
+{
+}
+
+FScreenshotCapture::~FScreenshotCapture()
+{
+    // 렌더 스레드 전용 리소스는 렌더 스레드에서 해제
+    if (Readback.IsValid())
+    {
+        ENQUEUE_RENDER_COMMAND(ReleaseScreenshotReadback)(
+            [ReadbackToRelease = MoveTemp(Readback)](FRHICommandListImmediate&) mutable
+            {
+                ReadbackToRelease.Reset();
+            });
+    }
+}
+
+bool FScreenshotCapture::Start(const bool bCaptureUI, const FString& FilePath, FOnComplete&& OnComplete)
+{
+    check(IsInGameThread());
+
+    TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Capture = MakeShareable(new FScreenshotCapture(bCaptureUI, FilePath, MoveTemp(OnComplete)));
+    return Capture->Begin();
+}
+
+bool FScreenshotCapture::Begin()
+{
+    if (!GEngine || !GEngine->GameViewport || !FSlateApplication::IsInitialized())
+    {
+        UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: no game viewport to capture."));
+        return false;
+    }
+
+    // 인코딩 워커에서 처음 불러오지 않도록 미리 로드
+    if (!FilePath.IsEmpty())
+    {
+        FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    }
+
+    // 엔진 스크린샷 요청은 하나뿐이므로 다른 곳(F9, HighResShot 등)의 요청이 남아 있으면 덮어쓰지 않는다
+    if (!bCaptureUI && (FScreenshotRequest::IsScreenshotRequested() || GIsHighResScreenshot))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TakeScreenShotAsync: another screenshot request is pending."));
+        return false;
+    }
+
+    std::atomic<bool>& InFlight = bCaptureUI ? bBackBufferCaptureInFlight : bScreenshotRequestInFlight;
+    if (InFlight.exchange(true))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TakeScreenShotAsync: a capture is already pending."));
+        return false;
+    }
+
+    StartTime = FPlatformTime::Seconds();
+    if (bCaptureUI)
+    {
+        // 1. 게임 창의 다음 백 버퍼를 렌더 스레드에서 복사 예약
+        FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+        Window = GEngine->GameViewport->GetWindow();
+        if (!Renderer || !Window.IsValid())
+        {
+            InFlight.store(false);
+            UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: game window is not available."));
+            return false;
+        }
+        // 델리게이트는 렌더 스레드에서 브로드캐스트되므로 바인딩과 해제도 렌더 스레드에서 한다
+        TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Self = AsShared();
+        ENQUEUE_RENDER_COMMAND(BindScreenshotBackBuffer)(
+            [Self, Renderer](FRHICommandListImmediate&)
+            {
+                Self->BackBufferHandle = Renderer->OnBackBufferReadyToPresent().AddThreadSafeSP(Self, &FScreenshotCapture::OnBackBufferReady);
+            });
+        BackBufferRenderer = Renderer;
+    }
+    else
+    {
+        // 1. 엔진 스크린샷 요청 (UI 제외). 델리게이트가 바인딩되어 있으면 엔진은 파일을 쓰지 않는다
+        ScreenshotHandle = UGameViewportClient::OnScreenshotCaptured().AddThreadSafeSP(AsShared(), &FScreenshotCapture::OnScreenshotCaptured);
+        FScreenshotRequest::RequestScreenshot(FilePath.IsEmpty() ? FPaths::ScreenShotDir() / TEXT("LIB_Capture.png") : FilePath, false, false);
+        RequestedFilename = FScreenshotRequest::GetFilename();
+    }
+
+    // 2. 매 프레임 진행 상황 확인 (티커가 자신을 참조하므로 끝날 때까지 살아 있음)
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateThreadSafeSP(AsShared(), &FScreenshotCapture::Tick));
+    return true;
+}
+
+void FScreenshotCapture::OnBackBufferReady(SWindow& SlateWindow, const FTextureRHIRef& BackBuffer)
+{
+    if (bCopyEnqueued.load() || &SlateWindow != Window.Pin().Get() || !BackBuffer.IsValid())
+    {
+        return;
+    }
+
+    FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+    Size = BackBuffer->GetSizeXY();
+    PixelFormat = BackBuffer->GetFormat();
+    Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("LIB_ScreenshotReadback"));
+
+    // 표시 직전 상태로 되돌려야 Present 가 영향을 받지 않는다
+    RHICmdList.Transition(FRHITransitionInfo(BackBuffer, ERHIAccess::Unknown, ERHIAccess::CopySrc));
+    Readback->EnqueueCopy(RHICmdList, BackBuffer);
+    RHICmdList.Transition(FRHITransitionInfo(BackBuffer, ERHIAccess::CopySrc, ERHIAccess::Present));
+    bCopyEnqueued.store(true);
+}
+
+void FScreenshotCapture::OnScreenshotCaptured(const int32 InWidth, const int32 InHeight, const TArray<FColor>& Colors)
+{
+    // 바인딩된 동안에는 엔진이 다른 스크린샷도 쓰지 않고 여기로 넘긴다. 요청 파일 이름으로 이 캡처의 결과인지 확인한다
+    const FString& RequestFilename = FScreenshotRequest::GetFilename();
+    if (RequestFilename != RequestedFilename)
+    {
+        SaveForeignScreenshot(InWidth, InHeight, Colors, RequestFilename);
+
+        // 엔진 요청은 하나뿐이므로 이 캡처의 요청은 덮어써졌다
+        if (!bReadbackDone.exchange(true))
+        {
+            UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: the request was replaced by another screenshot request."));
+            Unregister();
+            bScreenshotRequestInFlight.store(false);
+            Finish(ErrorCode_Failed, TArray<FColor>());
+        }
+        return;
+    }
+
+    if (bReadbackDone.exchange(true))
+    {
+        return;
+    }
+    Unregister();
+
+    // 게임 스레드에서는 복사만 하고 나머지는 워커에서
+    TArray64<uint8> RawData;
+    RawData.Append(reinterpret_cast<const uint8*>(Colors.GetData()), Colors.Num() * sizeof(FColor));
+    Size = FIntPoint(InWidth, InHeight);
+    PixelFormat = PF_B8G8R8A8;
+    Encode(MoveTemp(RawData), InWidth);
+}
+
+bool FScreenshotCapture::Tick(float DeltaTime)
+{
+    if (bReadbackDone.load())
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    if (FPlatformTime::Seconds() - StartTime > CaptureTimeoutSeconds)
+    {
+        TickerHandle.Reset();
+        if (bReadbackDone.exchange(true))
+        {
+            return false;
+        }
+        UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: timed out waiting for a frame."));
+        Unregister();
+        if (!bCaptureUI)
+        {
+            // 늦게 처리된 요청이 엔진 기본 경로로 파일을 쓰지 않도록 취소
+            FScreenshotRequest::Reset();
+        }
+        // 읽기 전에 끝났으므로 여기서 다음 캡처를 허용
+        (bCaptureUI ? bBackBufferCaptureInFlight : bScreenshotRequestInFlight).store(false);
+        Finish(ErrorCode_Failed, TArray<FColor>());
+        return false;
+    }
+
+    if (bCaptureUI && bCopyEnqueued.load())
+    {
+        // 복사가 예약되었으니 더 이상 백 버퍼를 받을 필요가 없다
+        Unregister();
+
+        // 렌더 스레드에 확인 요청은 한 번에 하나만
+        if (!bPollInFlight.exchange(true))
+        {
+            TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Self = AsShared();
+            ENQUEUE_RENDER_COMMAND(PollScreenshotReadback)(
+                [Self](FRHICommandListImmediate&)
+                {
+                    Self->PollReadback_RenderThread();
+                });
+        }
+    }
+    return true;
+}
+
+void FScreenshotCapture::PollReadback_RenderThread()
+{
+    if (!Readback.IsValid() || !Readback->IsReady() || bReadbackDone.exchange(true))
+    {
+        bPollInFlight.store(false);
+        return;
+    }
+
+    // 2. 복사가 끝난 스테이징 버퍼를 한 번에 복사하고 바로 반환
+    int32 RowPitchInPixels = 0;
+    const uint8* Data = static_cast<const uint8*>(Readback->Lock(RowPitchInPixels));
+    TArray64<uint8> RawData;
+    if (Data)
+    {
+        const int64 BytesPerPixel = GPixelFormats[PixelFormat].BlockBytes;
+        RawData.Append(Data, static_cast<int64>(RowPitchInPixels) * BytesPerPixel * Size.Y);
+    }
+    Readback->Unlock();
+    Readback.Reset();
+
+    bPollInFlight.store(false);
+    Encode(MoveTemp(RawData), RowPitchInPixels);
+}
+
+void FScreenshotCapture::SaveForeignScreenshot(const int32 InWidth, const int32 InHeight, const TArray<FColor>& Colors, const FString& ForeignFilePath)
+{
+    if (ForeignFilePath.IsEmpty() || InWidth <= 0 || InHeight <= 0 || Colors.Num() < InWidth * InHeight)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TakeScreenShotAsync: dropped a screenshot that was not requested by this capture."));
+        return;
+    }
+
+    // 엔진이 대신 썼을 파일을 요청한 경로에 저장
+    FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    Async(EAsyncExecution::ThreadPool, [Pixels = Colors, InWidth, InHeight, ForeignFilePath]() mutable
+        {
+            for (FColor& Pixel : Pixels)
+            {
+                Pixel.A = 255;
+            }
+            if (!SavePng(Pixels, InWidth, InHeight, ForeignFilePath))
+            {
+                UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: failed to save %s."), *ForeignFilePath);
+            }
+        });
+}
+
+void FScreenshotCapture::Encode(TArray64<uint8>&& RawData, const int32 RowPitchInPixels)
+{
+    // 다음 캡처는 읽기가 끝나면 바로 시작할 수 있다
+    (bCaptureUI ? bBackBufferCaptureInFlight : bScreenshotRequestInFlight).store(false);
+
+    TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Self = AsShared();
+    Async(EAsyncExecution::ThreadPool, [Self, RawData = MoveTemp(RawData), RowPitchInPixels]()
+        {
+            const int32 Width = Self->Size.X;
+            const int32 Height = Self->Size.Y;
+            const int64 BytesPerPixel = GPixelFormats[Self->PixelFormat].BlockBytes;
+            const int64 RowPitch = static_cast<int64>(RowPitchInPixels) * BytesPerPixel;
+            if (Width <= 0 || Height <= 0 || RowPitchInPixels < Width || RawData.Num() < RowPitch * Height)
+            {
+                UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: readback returned no data."));
+                Self->Finish(ErrorCode_Failed, TArray<FColor>());
+                return;
+            }
+
+            // 3. BGRA8 로 변환 (알파는 PNG 에서 투명해지지 않도록 255)
+            TArray<FColor> Pixels;
+            Pixels.SetNumUninitialized(Width * Height);
+            std::atomic<bool> bSupported{ true };
+            ParallelFor(Height, [&](int32 Y)
+                {
+                    FColor* Row = Pixels.GetData() + static_cast<int64>(Y) * Width;
+                    if (!ConvertRow(RawData.GetData() + Y * RowPitch, Row, Width, Self->PixelFormat))
+                    {
+                        bSupported.store(false);
+                        return;
+                    }
+                    for (int32 X = 0; X < Width; ++X)
+                    {
+                        Row[X].A = 255;
+                    }
+                });
+            if (!bSupported.load())
+            {
+                UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: unsupported back buffer format %s."), GPixelFormats[Self->PixelFormat].Name);
+                Self->Finish(ErrorCode_Failed, TArray<FColor>());
+                return;
+            }
+
+            // 4. PNG 인코딩 및 저장
+            if (!Self->FilePath.IsEmpty())
+            {
+                if (!SavePng(Pixels, Width, Height, Self->FilePath))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("TakeScreenShotAsync: failed to save %s."), *Self->FilePath);
+                    Self->Finish(ErrorCode_Failed, TArray<FColor>());
+                    return;
+                }
+            }
+
+            Self->Finish(0, MoveTemp(Pixels));
+        });
+}
+
+void FScreenshotCapture::Finish(const int32 ErrorCode, TArray<FColor>&& Pixels)
+{
+    TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Self = AsShared();
+    AsyncTask(ENamedThreads::GameThread, [Self, ErrorCode, Pixels = MoveTemp(Pixels)]() mutable
+        {
+            if (Self->OnComplete)
+            {
+                FOnComplete Callback = MoveTemp(Self->OnComplete);
+                Callback(ErrorCode, ErrorCode == 0 ? Self->FilePath : FString(), Self->Size.X, Self->Size.Y, MoveTemp(Pixels));
+            }
+        });
+}
+
+void FScreenshotCapture::Unregister()
+{
+    check(IsInGameThread());
+
+    if (BackBufferRenderer)
+    {
+        // 바인딩 명령보다 뒤에 들어가므로 렌더 스레드에서 BackBufferHandle 은 이미 채워져 있다
+        TSharedRef<FScreenshotCapture, ESPMode::ThreadSafe> Self = AsShared();
+        FSlateRenderer* Renderer = BackBufferRenderer;
+        ENQUEUE_RENDER_COMMAND(UnbindScreenshotBackBuffer)(
+            [Self, Renderer](FRHICommandListImmediate&)
+            {
+                Renderer->OnBackBufferReadyToPresent().Remove(Self->BackBufferHandle);
+                Self->BackBufferHandle.Reset();
+            });
+        BackBufferRenderer = nullptr;
+    }
+    if (ScreenshotHandle.IsValid())
+    {
+        UGameViewportClient::OnScreenshotCaptured().Remove(ScreenshotHandle);
+        ScreenshotHandle.Reset();
+    }
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "PixelFormat.h"
+#include "RHIFwd.h"
+#include <atomic>
+
+class SWindow;
+class FSlateRenderer;
+class FRHIGPUTextureReadback;
+
+/**
+ * 게임 스레드를 멈추지 않는 스크린샷 캡처.
+ * UI 포함: Slate 가 게임 창의 백 버퍼를 표시하기 직전에 GPU 복사를 예약하고, 이후 프레임에서 복사가 끝났는지 확인해
+ *          그때 읽어 옵니다 (FlushRenderingCommands 없음).
+ * UI 제외: 엔진 스크린샷 요청(FScreenshotRequest)을 OnScreenshotCaptured 로 받아 파일 쓰기만 가로챕니다.
+ *          엔진이 뷰포트를 읽는 비용은 그대로 남습니다. 다른 곳(F9, HighResShot 등)의 요청이 남아 있으면 시작하지 않고,
+ *          진행 중에 들어온 다른 요청의 결과는 그 요청의 경로에 대신 저장합니다. (이 캡처는 실패로 끝남)
+ * 두 경우 모두 픽셀 변환과 PNG 인코딩/저장은 스레드 풀에서 하고, 완료 콜백은 게임 스레드에서 호출합니다.
+ * 캡처는 경로와 관계없이 방식(UI 포함/제외)마다 한 번에 하나씩만 진행할 수 있습니다. (엔진 스크린샷 요청이 하나뿐이고,
+ * 백 버퍼 복사도 한 프레임에 하나만 예약하기 때문) 진행 중에 같은 방식으로 Start 하면 false 를 반환합니다.
+ */
+class FScreenshotCapture : public TSharedFromThis<FScreenshotCapture, ESPMode::ThreadSafe>
+{
+public:
+	// ErrorCode 0 이면 성공. FilePath 는 저장하지 않았으면 비어 있습니다. Pixels 는 BGRA (알파 255)
+	using FOnComplete = TUniqueFunction<void(int32 ErrorCode, const FString& FilePath, int32 Width, int32 Height, TArray<FColor>&& Pixels)>;
+
+	static constexpr int32 ErrorCode_Failed = -1;
+
+	/**
+	 * 게임 스레드 전용. 시작하지 못하면 false 를 반환하고 콜백은 호출하지 않습니다.
+	 * @param FilePath 비어 있으면 파일로 저장하지 않고 픽셀만 넘깁니다.
+	 */
+	static bool Start(bool bCaptureUI, const FString& FilePath, FOnComplete&& OnComplete);
+
+	~FScreenshotCapture();
+
+private:
+	FScreenshotCapture(bool bInCaptureUI, const FString& InFilePath, FOnComplete&& InOnComplete);
+
+	bool Begin();
+
+	// 렌더 스레드: 게임 창의 백 버퍼 복사를 예약
+	void OnBackBufferReady(SWindow& SlateWindow, const FTextureRHIRef& BackBuffer);
+	// 게임 스레드: 엔진 스크린샷 결과
+	void OnScreenshotCaptured(int32 InWidth, int32 InHeight, const TArray<FColor>& Colors);
+
+	// 게임 스레드: 복사가 끝났는지 렌더 스레드에 확인 요청. false 를 반환하면 티커가 해제됩니다.
+	bool Tick(float DeltaTime);
+	// 렌더 스레드: 복사가 끝났으면 읽어서 인코딩을 시작
+	void PollReadback_RenderThread();
+
+	// 게임 스레드: 이 캡처가 요청하지 않은 엔진 스크린샷을 엔진 대신 저장
+	void SaveForeignScreenshot(int32 InWidth, int32 InHeight, const TArray<FColor>& Colors, const FString& ForeignFilePath);
+	void Encode(TArray64<uint8>&& RawData, int32 RowPitchInPixels);
+	void Finish(int32 ErrorCode, TArray<FColor>&& Pixels);
+	void Unregister();
+
+	const bool bCaptureUI;
+	const FString FilePath;
+	FOnComplete OnComplete;
+
+	TWeakPtr<SWindow> Window;
+	FSlateRenderer* BackBufferRenderer = nullptr;	// 게임 스레드: 백 버퍼 델리게이트를 바인딩한 렌더러 (해제 예약 후 nullptr)
+	FDelegateHandle BackBufferHandle;				// 렌더 스레드 전용
+	FDelegateHandle ScreenshotHandle;
+	FString RequestedFilename;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartTime = 0.0;
+
+	// 렌더 스레드에서만 접근 (Readback 생성 이후 PixelFormat / Size 도 렌더 스레드에서만 씀)
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+	EPixelFormat PixelFormat = PF_Unknown;
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	std::atomic<bool> bCopyEnqueued{ false };
+	std::atomic<bool> bPollInFlight{ false };
+	std::atomic<bool> bReadbackDone{ false };
+
+	// 방식별 진행 중 표시 (경로별이 아님)
+	static std::atomic<bool> bBackBufferCaptureInFlight;
+	static std::atomic<bool> bScreenshotRequestInFlight;
+};
@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LIB_TextureCache.h"
+#include "LIB_ImageLoader.h"
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    constexpr int64 DefaultBudgetBytes = 256ll * 1024 * 1024;
+
+    // 예산과 별개로 항목 수 상한 (작은 썸네일이 아주 많을 때 TLruCache 용량)
+    constexpr int32 MaxEntries = 4096;
+}
+
+FTextureCache& FTextureCache::Get()
+{
+    static FTextureCache Instance;
+    return Instance;
+}
+
+FTextureCache::FTextureCache()
+    : Entries(MaxEntries)
+    , MaxBytes(DefaultBudgetBytes)
+{
+    // 강한 참조는 UObject 가 정리되기 전에 놓아야 한다
+    FCoreDelegates::OnPreExit.AddRaw(this, &FTextureCache::Clear);
+}
+
+FString FTextureCache::MakeKey(const FString& FilePath, const bool bGenerateMips)
+{
+    FString Key = FPaths::ConvertRelativePathToFull(FilePath);
+    FPaths::NormalizeFilename(Key);
+    Key += bGenerateMips ? TEXT("|Mips") : TEXT("|NoMips");
+    return Key;
+}
+
+FTextureCache::FFileVersion FTextureCache::GetFileVersion(const FString& FilePath)
+{
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+    FFileVersion Version;
+    if (StatData.bIsValid && !StatData.bIsDirectory)
+    {
+        Version.FileSize = StatData.FileSize;
+        Version.ModificationTime = StatData.ModificationTime;
+    }
+    return Version;
+}
+
+void FTextureCache::LoadAsync(const FString& FilePath, const bool bGenerateMips, FOnLoaded&& OnLoaded)
+{
+    check(IsInGameThread());
+
+    uint64 LoadId = 0;
+    if (!RequestLoad(FilePath, bGenerateMips, MoveTemp(OnLoaded), LoadId))
+    {
+        return;
+    }
+
+    // 워커에서 디코드한 뒤 게임 스레드에서 텍스처를 만들어 기다리던 요청 모두에 전달
+    LIB_ImageLoader::LoadImageWrapperModule();
+    Async(EAsyncExecution::ThreadPool, [this, FilePath, bGenerateMips, LoadId]()
+        {
+            TSharedRef<FDecodedImage, ESPMode::ThreadSafe> Image = MakeShared<FDecodedImage, ESPMode::ThreadSafe>();
+            LIB_ImageLoader::DecodeImageFile(FilePath, bGenerateMips, *Image);
+
+            AsyncTask(ENamedThreads::GameThread, [this, FilePath, bGenerateMips, LoadId, Image]()
+                {
+                    FinishLoad(FilePath, bGenerateMips, LoadId, *Image);
+                });
+        });
+}
+
+bool FTextureCache::RequestLoad(const FString& FilePath, const bool bGenerateMips, FOnLoaded&& OnLoaded, uint64& OutLoadId)
+{
+    check(IsInGameThread());
+
+    // 1. 적중이면 바로 반환
+    const FString Key = MakeKey(FilePath, bGenerateMips);
+    const FFileVersion Version = GetFileVersion(FilePath);
+    if (Version.FileSize < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to load file data from %s"), *FilePath);
+        OnLoaded(nullptr);
+        return false;
+    }
+    if (UTexture2D* Texture = FindEntry(Key, Version))
+    {
+        OnLoaded(Texture);
+        return false;
+    }
+
+    // 2. 같은 버전을 디코드 중이면 콜백만 추가
+    FPendingLoad& Pending = PendingLoads.FindOrAdd(Key);
+    const bool bAlreadyLoading = Pending.Callbacks.Num() > 0;
+    Pending.Callbacks.Add(MoveTemp(OnLoaded));
+    if (bAlreadyLoading && Pending.Version == Version)
+    {
+        return false;
+    }
+
+    // 3. 호출자가 디코드. 이전 버전을 기다리던 요청은 새 버전 결과를 받는다 (이전 결과는 버려짐)
+    Pending.Version = Version;
+    Pending.LoadId = ++LastLoadId;
+    OutLoadId = Pending.LoadId;
+    return true;
+}
+
+void FTextureCache::FinishLoad(const FString& FilePath, const bool bGenerateMips, const uint64 LoadId, const FDecodedImage& Image)
+{
+    check(IsInGameThread());
+
+    const FString Key = MakeKey(FilePath, bGenerateMips);
+    FPendingLoad* Pending = PendingLoads.Find(Key);
+    if (!Pending || Pending->LoadId != LoadId)
+    {
+        return;
+    }
+
+    // 4. 텍스처를 한 번 만들어 캐시에 넣고, 기다리던 요청 모두에 전달
+    const FFileVersion Version = Pending->Version;
+    TArray<FOnLoaded> Callbacks = MoveTemp(Pending->Callbacks);
+    PendingLoads.Remove(Key);
+
+    UTexture2D* Texture = Image.IsValid() ? AddEntry(Key, Version, Image) : nullptr;
+    for (FOnLoaded& Callback : Callbacks)
+    {
+        Callback(Texture);
+    }
+}
+
+UTexture2D* FTextureCache::Load(const FString& FilePath, const bool bGenerateMips)
+{
+    check(IsInGameThread());
+
+    const FString Key = MakeKey(FilePath, bGenerateMips);
+    const FFileVersion Version = GetFileVersion(FilePath);
+    if (Version.FileSize < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to load file data from %s"), *FilePath);
+        return nullptr;
+    }
+    if (UTexture2D* Texture = FindEntry(Key, Version))
+    {
+        return Texture;
+    }
+
+    // 같은 파일을 비동기로 디코드 중이더라도 기다릴 수 없으므로 직접 디코드 (완료된 쪽은 이 항목을 재사용)
+    LIB_ImageLoader::LoadImageWrapperModule();
+    FDecodedImage Image;
+    if (!LIB_ImageLoader::DecodeImageFile(FilePath, bGenerateMips, Image))
+    {
+        return nullptr;
+    }
+    return AddEntry(Key, Version, Image);
+}
+
+UTexture2D* FTextureCache::Find(const FString& FilePath, const bool bGenerateMips)
+{
+    check(IsInGameThread());
+    return FindEntry(MakeKey(FilePath, bGenerateMips), GetFileVersion(FilePath));
+}
+
+void FTextureCache::SetBudget(const int64 InMaxBytes)
+{
+    check(IsInGameThread());
+    MaxBytes = FMath::Max<int64>(InMaxBytes, 0);
+    EvictToBudget();
+}
+
+void FTextureCache::Clear()
+{
+    check(IsInGameThread());
+    Entries.Empty(MaxEntries);
+    NumBytes = 0;
+}
+
+UTexture2D* FTextureCache::FindEntry(const FString& Key, const FFileVersion& Version)
+{
+    const FEntry* Entry = Entries.FindAndTouch(Key);
+    if (!Entry)
+    {
+        return nullptr;
+    }
+
+    // 파일이 바뀌었으면 이전 텍스처는 버린다
+    UTexture2D* Texture = Entry->Texture.IsValid() ? Entry->Texture->Get() : nullptr;
+    if (!Texture || !(Entry->Version == Version))
+    {
+        RemoveEntry(Key);
+        return nullptr;
+    }
+    return Texture;
+}
+
+UTexture2D* FTextureCache::AddEntry(const FString& Key, const FFileVersion& Version, const FDecodedImage& Image)
+{
+    if (UTexture2D* Existing = FindEntry(Key, Version))
+    {
+        return Existing;
+    }
+
+    UTexture2D* Texture = LIB_ImageLoader::CreateTexture(Image);
+    const int64 ImageBytes = Image.GetNumBytes();
+    if (!Texture || ImageBytes > MaxBytes)
+    {
+        // 예산보다 큰 이미지는 캐시하지 않고 그대로 넘긴다
+        return Texture;
+    }
+
+    // TLruCache 가 용량을 넘겨 조용히 버리는 항목도 크기 합에 반영되도록 미리 비운다
+    if (Entries.Num() >= Entries.Max())
+    {
+        NumBytes -= Entries.RemoveLeastRecent().NumBytes;
+    }
+
+    FEntry Entry;
+    Entry.Texture = MakeShared<TStrongObjectPtr<UTexture2D>>(Texture);
+    Entry.Version = Version;
+    Entry.NumBytes = ImageBytes;
+    Entries.Add(Key, MoveTemp(Entry));
+    NumBytes += ImageBytes;
+
+    EvictToBudget();
+    return Texture;
+}
+
+void FTextureCache::RemoveEntry(const FString& Key)
+{
+    if (const FEntry* Entry = Entries.Find(Key))
+    {
+        NumBytes -= Entry->NumBytes;
+        Entries.Remove(Key);
+    }
+}
+
+void FTextureCache::EvictToBudget()
+{
+    while (NumBytes > MaxBytes && Entries.Num() > 0)
+    {
+        NumBytes -= Entries.RemoveLeastRecent().NumBytes;
+    }
+}
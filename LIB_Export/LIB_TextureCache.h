@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UTexture2D;
+struct FDecodedImage;
+
+/**
+ * 이미지 파일에서 만든 트랜지언트 텍스처 캐시 (게임 스레드 전용).
+ * 경로와 밉 생성 여부를 키로, 파일 크기와 수정 시각이 같을 때만 적중으로 처리합니다.
+ * 텍스처는 캐시가 강한 참조로 들고 있으며, 디코드된 크기의 합이 예산을 넘으면 가장 오래 쓰지 않은 것부터 놓습니다.
+ * 같은 파일을 동시에 여러 번 요청하면 디코드는 한 번만 하고 결과를 모든 요청에 나눠 줍니다.
+ */
+class FTextureCache
+{
+public:
+	using FOnLoaded = TUniqueFunction<void(UTexture2D*)>;
+
+	static FTextureCache& Get();
+
+	// 적중하면 디코드 없이 바로 OnLoaded 를 호출하고, 아니면 워커에서 디코드한 뒤 게임 스레드에서 호출합니다.
+	void LoadAsync(const FString& FilePath, bool bGenerateMips, FOnLoaded&& OnLoaded);
+
+	// 적중하면 캐시된 텍스처, 아니면 이 스레드에서 디코드해 캐시에 넣습니다. 실패하면 nullptr
+	UTexture2D* Load(const FString& FilePath, bool bGenerateMips);
+
+	// 파일이 바뀌지 않았다면 캐시된 텍스처. 없으면 nullptr (디코드하지 않음)
+	UTexture2D* Find(const FString& FilePath, bool bGenerateMips);
+
+	/**
+	 * 디코드를 직접 하는 쪽(배치 로더)용 요청. 적중이면 바로 OnLoaded 를 호출하고, 같은 파일을 디코드 중이면 그 결과를 기다립니다.
+	 * 둘 다 아니면 true 를 반환하며, 호출자는 디코드한 뒤 OutLoadId 로 FinishLoad 를 호출해야 합니다.
+	 */
+	bool RequestLoad(const FString& FilePath, bool bGenerateMips, FOnLoaded&& OnLoaded, uint64& OutLoadId);
+
+	// RequestLoad 가 맡긴 디코드 결과로 텍스처를 한 번 만들어 기다리던 요청 모두에 넘깁니다. (Image 가 유효하지 않으면 nullptr)
+	// 그사이 파일이 바뀌어 새 디코드가 시작되었다면 이 결과는 버리고, 기다리던 요청은 새 결과를 받습니다.
+	void FinishLoad(const FString& FilePath, bool bGenerateMips, uint64 LoadId, const FDecodedImage& Image);
+
+	// 디코드된 픽셀 크기 기준 예산. 0 이면 캐시하지 않고 중복 디코드 합치기만 합니다.
+	void SetBudget(int64 InMaxBytes);
+	int64 GetBudget() const { return MaxBytes; }
+	int64 GetNumBytes() const { return NumBytes; }
+	void Clear();
+
+private:
+	FTextureCache();
+
+	// 파일 크기와 수정 시각 (파일이 없으면 FileSize < 0)
+	struct FFileVersion
+	{
+		int64 FileSize = -1;
+		FDateTime ModificationTime;
+
+		bool operator==(const FFileVersion& Other) const { return FileSize == Other.FileSize && ModificationTime == Other.ModificationTime; }
+	};
+
+	struct FEntry
+	{
+		TSharedPtr<TStrongObjectPtr<UTexture2D>> Texture;	// TLruCache 값은 복사 가능해야 하므로 공유 포인터로 감싼다
+		FFileVersion Version;
+		int64 NumBytes = 0;
+	};
+
+	struct FPendingLoad
+	{
+		FFileVersion Version;
+		uint64 LoadId = 0;	// 디코드를 맡은 쪽을 구분 (버전이 바뀌어 다시 시작하면 새 번호)
+		TArray<FOnLoaded> Callbacks;
+	};
+
+	static FString MakeKey(const FString& FilePath, bool bGenerateMips);
+	static FFileVersion GetFileVersion(const FString& FilePath);
+
+	UTexture2D* FindEntry(const FString& Key, const FFileVersion& Version);
+	// 이미 같은 버전이 있으면 그것을, 없으면 Image 로 만든 텍스처를 넣고 반환
+	UTexture2D* AddEntry(const FString& Key, const FFileVersion& Version, const FDecodedImage& Image);
+	void RemoveEntry(const FString& Key);
+	void EvictToBudget();
+
+	TLruCache<FString, FEntry> Entries;
+	TMap<FString, FPendingLoad> PendingLoads;
+	int64 MaxBytes;
+	int64 NumBytes = 0;
+	uint64 LastLoadId = 0;
+};